@@ -87,6 +87,13 @@ static const std::vector<struct JsEnumInt> g_playbackSpeed = {
     { "SPEED_FORWARD_1_25_X", PlaybackRateMode::SPEED_FORWARD_1_25_X },
     { "SPEED_FORWARD_1_75_X", PlaybackRateMode::SPEED_FORWARD_1_75_X },
     { "SPEED_FORWARD_2_00_X", PlaybackRateMode::SPEED_FORWARD_2_00_X },
+    { "SPEED_FORWARD_4_00_X", PlaybackRateMode::SPEED_FORWARD_4_00_X },
+    { "SPEED_FORWARD_8_00_X", PlaybackRateMode::SPEED_FORWARD_8_00_X },
+    { "SPEED_FORWARD_16_00_X", PlaybackRateMode::SPEED_FORWARD_16_00_X },
+    { "SPEED_BACKWARD_1_00_X", PlaybackRateMode::SPEED_BACKWARD_1_00_X },
+    { "SPEED_BACKWARD_4_00_X", PlaybackRateMode::SPEED_BACKWARD_4_00_X },
+    { "SPEED_BACKWARD_8_00_X", PlaybackRateMode::SPEED_BACKWARD_8_00_X },
+    { "SPEED_BACKWARD_16_00_X", PlaybackRateMode::SPEED_BACKWARD_16_00_X },
 };
 
 static const std::vector<struct JsEnumInt> g_mediaType = {
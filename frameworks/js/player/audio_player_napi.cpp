@@ -121,6 +121,10 @@ napi_value AudioPlayerNapi::Constructor(napi_env env, napi_callback_info info)
     if (playerNapi->callbackNapi_ == nullptr && playerNapi->nativePlayer_ != nullptr) {
         playerNapi->callbackNapi_ = std::make_shared<PlayerCallbackNapi>(env);
         (void)playerNapi->nativePlayer_->SetPlayerCallback(playerNapi->callbackNapi_);
+        // the js callback does not report the position, stop the position updates
+        Format param;
+        (void)param.PutIntValue(PlayerKeys::PLAYER_POSITION_UPDATE_INTERVAL, 0);
+        (void)playerNapi->nativePlayer_->SetParameter(param);
     }
 
     status = napi_wrap(env, jsThis, reinterpret_cast<void *>(playerNapi),
@@ -178,7 +178,7 @@ void VideoCallbackNapi::OnSpeedDoneCb(int32_t speedMode)
     CHECK_AND_RETURN_LOG(context != nullptr, "context is nullptr");
     contextSpeedQue_.pop();
 
-    if (speedMode < SPEED_FORWARD_0_75_X || speedMode > SPEED_FORWARD_2_00_X) {
+    if (speedMode < SPEED_FORWARD_0_75_X || speedMode > SPEED_BACKWARD_16_00_X) {
         MEDIA_LOGE("OnSpeedDoneCb mode:%{public}d error", speedMode);
     }
 
@@ -130,6 +130,10 @@ napi_value VideoPlayerNapi::Constructor(napi_env env, napi_callback_info info)
     if (jsPlayer->jsCallback_ == nullptr && jsPlayer->nativePlayer_ != nullptr) {
         jsPlayer->jsCallback_ = std::make_shared<VideoCallbackNapi>(env);
         (void)jsPlayer->nativePlayer_->SetPlayerCallback(jsPlayer->jsCallback_);
+        // the js callback does not report the position, stop the position updates
+        Format param;
+        (void)param.PutIntValue(PlayerKeys::PLAYER_POSITION_UPDATE_INTERVAL, 0);
+        (void)jsPlayer->nativePlayer_->SetParameter(param);
     }
 
     status = napi_wrap(env, jsThis, reinterpret_cast<void *>(jsPlayer),
@@ -849,7 +853,7 @@ napi_value VideoPlayerNapi::SetSpeed(napi_env env, napi_callback_info info)
     status = napi_get_value_int32(env, args[0], &asyncContext->speedMode);
     if (status != napi_ok ||
         asyncContext->speedMode < SPEED_FORWARD_0_75_X ||
-        asyncContext->speedMode > SPEED_FORWARD_2_00_X) {
+        asyncContext->speedMode > SPEED_BACKWARD_16_00_X) {
         asyncContext->SignError(MSERR_EXT_INVALID_VAL, "speed mode invalid");
     }
     asyncContext->callbackRef = CommonNapi::CreateReference(env, args[1]);
@@ -122,6 +122,12 @@ int32_t AVCodecAudioEncoderImpl::QueueInputBuffer(uint32_t index, AVCodecBufferI
     return codecService_->QueueInputBuffer(index, info, flag);
 }
 
+int32_t AVCodecAudioEncoderImpl::QueueInputBuffers(const std::vector<AVCodecInputRequest> &requests)
+{
+    CHECK_AND_RETURN_RET_LOG(codecService_ != nullptr, MSERR_INVALID_OPERATION, "service died");
+    return codecService_->QueueInputBuffers(requests);
+}
+
 std::shared_ptr<AVSharedMemory> AVCodecAudioEncoderImpl::GetOutputBuffer(uint32_t index)
 {
     CHECK_AND_RETURN_RET_LOG(codecService_ != nullptr, nullptr, "service died");
@@ -146,6 +152,12 @@ int32_t AVCodecAudioEncoderImpl::ReleaseOutputBuffer(uint32_t index)
     return codecService_->ReleaseOutputBuffer(index);
 }
 
+int32_t AVCodecAudioEncoderImpl::ReleaseOutputBuffers(const std::vector<uint32_t> &indexes)
+{
+    CHECK_AND_RETURN_RET_LOG(codecService_ != nullptr, MSERR_INVALID_OPERATION, "service died");
+    return codecService_->ReleaseOutputBuffers(indexes);
+}
+
 int32_t AVCodecAudioEncoderImpl::SetParameter(const Format &format)
 {
     CHECK_AND_RETURN_RET_LOG(codecService_ != nullptr, MSERR_INVALID_OPERATION, "service died");
@@ -128,6 +128,12 @@ int32_t AVCodecVideoDecoderImpl::QueueInputBuffer(uint32_t index, AVCodecBufferI
     return codecService_->QueueInputBuffer(index, info, flag);
 }
 
+int32_t AVCodecVideoDecoderImpl::QueueInputBuffers(const std::vector<AVCodecInputRequest> &requests)
+{
+    CHECK_AND_RETURN_RET_LOG(codecService_ != nullptr, MSERR_INVALID_OPERATION, "service died");
+    return codecService_->QueueInputBuffers(requests);
+}
+
 std::shared_ptr<AVSharedMemory> AVCodecVideoDecoderImpl::GetOutputBuffer(uint32_t index)
 {
     CHECK_AND_RETURN_RET_LOG(codecService_ != nullptr, nullptr, "service died");
@@ -152,6 +158,12 @@ int32_t AVCodecVideoDecoderImpl::ReleaseOutputBuffer(uint32_t index, bool render
     return codecService_->ReleaseOutputBuffer(index, render);
 }
 
+int32_t AVCodecVideoDecoderImpl::ReleaseOutputBuffers(const std::vector<uint32_t> &indexes, bool render)
+{
+    CHECK_AND_RETURN_RET_LOG(codecService_ != nullptr, MSERR_INVALID_OPERATION, "service died");
+    return codecService_->ReleaseOutputBuffers(indexes, render);
+}
+
 int32_t AVCodecVideoDecoderImpl::SetParameter(const Format &format)
 {
     CHECK_AND_RETURN_RET_LOG(codecService_ != nullptr, MSERR_INVALID_OPERATION, "service died");
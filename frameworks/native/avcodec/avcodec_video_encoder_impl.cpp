@@ -128,6 +128,12 @@ int32_t AVCodecVideoEncoderImpl::QueueInputBuffer(uint32_t index, AVCodecBufferI
     return codecService_->QueueInputBuffer(index, info, flag);
 }
 
+int32_t AVCodecVideoEncoderImpl::QueueInputBuffers(const std::vector<AVCodecInputRequest> &requests)
+{
+    CHECK_AND_RETURN_RET_LOG(codecService_ != nullptr, MSERR_INVALID_OPERATION, "service died");
+    return codecService_->QueueInputBuffers(requests);
+}
+
 std::shared_ptr<AVSharedMemory> AVCodecVideoEncoderImpl::GetOutputBuffer(uint32_t index)
 {
     CHECK_AND_RETURN_RET_LOG(codecService_ != nullptr, nullptr, "service died");
@@ -152,6 +158,12 @@ int32_t AVCodecVideoEncoderImpl::ReleaseOutputBuffer(uint32_t index)
     return codecService_->ReleaseOutputBuffer(index);
 }
 
+int32_t AVCodecVideoEncoderImpl::ReleaseOutputBuffers(const std::vector<uint32_t> &indexes)
+{
+    CHECK_AND_RETURN_RET_LOG(codecService_ != nullptr, MSERR_INVALID_OPERATION, "service died");
+    return codecService_->ReleaseOutputBuffers(indexes);
+}
+
 int32_t AVCodecVideoEncoderImpl::SetParameter(const Format &format)
 {
     CHECK_AND_RETURN_RET_LOG(codecService_ != nullptr, MSERR_INVALID_OPERATION, "service died");
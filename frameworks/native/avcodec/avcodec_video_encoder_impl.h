@@ -36,10 +36,12 @@ public:
     sptr<Surface> CreateInputSurface() override;
     std::shared_ptr<AVSharedMemory> GetInputBuffer(uint32_t index) override;
     int32_t QueueInputBuffer(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag) override;
+    int32_t QueueInputBuffers(const std::vector<AVCodecInputRequest> &requests) override;
     std::shared_ptr<AVSharedMemory> GetOutputBuffer(uint32_t index) override;
     int32_t GetOutputFormat(Format &format) override;
     std::shared_ptr<VideoCaps> GetVideoEncoderCaps() override;
     int32_t ReleaseOutputBuffer(uint32_t index) override;
+    int32_t ReleaseOutputBuffers(const std::vector<uint32_t> &indexes) override;
     int32_t SetParameter(const Format &format) override;
     int32_t SetCallback(const std::shared_ptr<AVCodecCallback> &callback) override;
     int32_t Init(AVCodecType type, bool isMimeType, const std::string &name);
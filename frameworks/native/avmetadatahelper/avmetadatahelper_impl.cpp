@@ -225,6 +225,29 @@ std::shared_ptr<PixelMap> AVMetadataHelperImpl::FetchFrameAtTime(
     return CreatePixelMap(mem, param.colorFormat);
 }
 
+std::vector<std::shared_ptr<PixelMap>> AVMetadataHelperImpl::FetchFramesAtTimes(
+    const std::vector<int64_t> &timesUs, int32_t option, const PixelMapParams &param)
+{
+    CHECK_AND_RETURN_RET_LOG(avMetadataHelperService_ != nullptr, {},
+        "avmetadatahelper service does not exist.");
+    CHECK_AND_RETURN_RET_LOG(!timesUs.empty() && timesUs.size() <= static_cast<size_t>(MAX_FETCH_FRAMES_NUM),
+        {}, "invalid frame number: %{public}zu", timesUs.size());
+
+    OutputConfiguration config;
+    config.colorFormat = param.colorFormat;
+    config.dstHeight = param.dstHeight;
+    config.dstWidth = param.dstWidth;
+
+    auto mems = avMetadataHelperService_->FetchFramesAtTimes(timesUs, option, config);
+    CHECK_AND_RETURN_RET_LOG(mems.size() == timesUs.size(), {}, "Fetch frames failed");
+
+    std::vector<std::shared_ptr<PixelMap>> pixelMaps;
+    for (auto &mem : mems) {
+        pixelMaps.push_back(mem == nullptr ? nullptr : CreatePixelMap(mem, param.colorFormat));
+    }
+    return pixelMaps;
+}
+
 void AVMetadataHelperImpl::Release()
 {
     CHECK_AND_RETURN_LOG(avMetadataHelperService_ != nullptr, "avmetadatahelper service does not exist.");
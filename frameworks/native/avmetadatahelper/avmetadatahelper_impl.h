@@ -32,6 +32,8 @@ public:
     std::unordered_map<int32_t, std::string> ResolveMetadata() override;
     std::shared_ptr<AVSharedMemory> FetchArtPicture() override;
     std::shared_ptr<PixelMap> FetchFrameAtTime(int64_t timeUs, int32_t option, const PixelMapParams &param) override;
+    std::vector<std::shared_ptr<PixelMap>> FetchFramesAtTimes(
+        const std::vector<int64_t> &timesUs, int32_t option, const PixelMapParams &param) override;
     void Release() override;
     int32_t Init();
 private:
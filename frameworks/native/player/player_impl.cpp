@@ -97,6 +97,20 @@ int32_t PlayerImpl::SetSource(int32_t fd, int64_t offset, int64_t size)
     return playerService_->SetSource(fd, offset, size);
 }
 
+int32_t PlayerImpl::SetNextSource(const std::string &url)
+{
+    CHECK_AND_RETURN_RET_LOG(playerService_ != nullptr, MSERR_INVALID_OPERATION, "player service does not exist..");
+    MEDIA_LOGW("KPI-TRACE: PlayerImpl SetNextSource in(url)");
+    return playerService_->SetNextSource(url);
+}
+
+int32_t PlayerImpl::SetNextSource(int32_t fd, int64_t offset, int64_t size)
+{
+    CHECK_AND_RETURN_RET_LOG(playerService_ != nullptr, MSERR_INVALID_OPERATION, "player service does not exist..");
+    MEDIA_LOGW("KPI-TRACE: PlayerImpl SetNextSource in(fd)");
+    return playerService_->SetNextSource(fd, offset, size);
+}
+
 int32_t PlayerImpl::Play()
 {
     CHECK_AND_RETURN_RET_LOG(playerService_ != nullptr, MSERR_INVALID_OPERATION, "player service does not exist..");
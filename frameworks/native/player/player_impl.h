@@ -30,6 +30,8 @@ public:
     int32_t SetSource(const std::string &url) override;
     int32_t SetSource(const std::shared_ptr<IMediaDataSource> &dataSrc) override;
     int32_t SetSource(int32_t fd, int64_t offset, int64_t size) override;
+    int32_t SetNextSource(const std::string &url) override;
+    int32_t SetNextSource(int32_t fd, int64_t offset, int64_t size) override;
     int32_t Play() override;
     int32_t Prepare() override;
     int32_t PrepareAsync() override;
@@ -121,6 +121,19 @@ public:
      */
     virtual int32_t QueueInputBuffer(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag) = 0;
 
+    /**
+     * @brief Submits a batch of input buffers to encoder in one call to the service.
+     *
+     * This function must be called during running. The buffers are queued in the given order, and the
+     * queueing stops at the first failure.
+     *
+     * @param requests The index, info and flag of each input buffer. For details, see {@link AVCodecInputRequest}
+     * @return Returns {@link MSERR_OK} if success; returns an error code otherwise.
+     * @since 3.1
+     * @version 3.1
+     */
+    virtual int32_t QueueInputBuffers(const std::vector<AVCodecInputRequest> &requests) = 0;
+
     /**
      * @brief Returns a {@link AVSharedMemory} object for a output buffer index that contains the data.
      *
@@ -166,6 +179,19 @@ public:
      */
     virtual int32_t ReleaseOutputBuffer(uint32_t index) = 0;
 
+    /**
+     * @brief Returns a batch of output buffers to the encoder in one call to the service.
+     *
+     * This function must be called during running. The buffers are released in the given order, and the
+     * release stops at the first failure.
+     *
+     * @param indexes The indexes of the output buffers.
+     * @return Returns {@link MSERR_OK} if success; returns an error code otherwise.
+     * @since 3.1
+     * @version 3.1
+     */
+    virtual int32_t ReleaseOutputBuffers(const std::vector<uint32_t> &indexes) = 0;
+
     /**
      * @brief Sets the parameters to the encoder.
      *
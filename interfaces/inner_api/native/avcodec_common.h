@@ -16,6 +16,7 @@
 #define AVCODEC_COMMOM_H
 
 #include <string>
+#include <vector>
 #include "av_common.h"
 #include "format.h"
 
@@ -56,6 +57,15 @@ struct AVCodecBufferInfo {
     int32_t offset = 0;
 };
 
+struct AVCodecInputRequest {
+    /* The index of the input buffer */
+    uint32_t index = 0;
+    /* The info of the input buffer */
+    AVCodecBufferInfo info;
+    /* The flag of the input buffer */
+    AVCodecBufferFlag flag = AVCODEC_BUFFER_FLAG_NONE;
+};
+
 class AVCodecCallback {
 public:
     virtual ~AVCodecCallback() = default;
@@ -19,6 +19,7 @@
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 #include "pixel_map.h"
 #include "nocopyable.h"
 #include "avsharedmemory.h"
@@ -238,6 +239,22 @@ public:
      */
     virtual std::shared_ptr<PixelMap> FetchFrameAtTime(int64_t timeUs, int32_t option, const PixelMapParams &param) = 0;
 
+    /**
+     * Fetch the representative video frames near the given timestamps in one call, such as
+     * the thumbnails of a scrub strip, and return pixelmaps with given parameters. It is much
+     * cheaper than calling {@link FetchFrameAtTime} for each timestamp. This method must be
+     * called after the SetSource.
+     * @param timesUs The time positions in microseconds where the frames will be fetched, at
+     * most 32 positions. See {@link FetchFrameAtTime} for how each position is resolved.
+     * @param option the hint about how to fetch the frames, see {@link AVMetadataQueryOption}
+     * @param param the desired configuration of returned pixelmaps, see {@link PixelMapParams}.
+     * @return Returns the pixelmaps in the same order as timesUs, an element is null if the frame
+     * at that position cannot be fetched. Returns an empty vector if no frame can be fetched.
+     * The pixelmaps of positions that resolve to the same video frame may share their pixels.
+     */
+    virtual std::vector<std::shared_ptr<PixelMap>> FetchFramesAtTimes(
+        const std::vector<int64_t> &timesUs, int32_t option, const PixelMapParams &param) = 0;
+
     /**
      * Release the internel resource. After this method called, the avmetadatahelper instance
      * can not be used again.
@@ -16,8 +16,10 @@
 #ifndef FORMAT_H
 #define FORMAT_H
 
-#include <string>
+#include <functional>
 #include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace OHOS {
@@ -230,7 +232,8 @@ public:
     using FormatDataMap = std::map<std::string, FormatData, std::less<>>;
 
     /**
-     * @brief Obtains the metadata map.
+     * @brief Obtains the metadata map. The map is built on the first call and cached until this
+     * Format is modified, the returned reference is invalid after any modification.
      *
      * @return Returns the map object.
      * @since 1.0
@@ -238,6 +241,24 @@ public:
      */
     const FormatDataMap &GetFormatMap() const;
 
+    /**
+     * @brief Obtains the number of the metadata, without building the metadata map.
+     *
+     * @return Returns the number of the metadata.
+     * @since 1.0
+     * @version 1.0
+     */
+    size_t Size() const;
+
+    /**
+     * @brief Checks whether there is no metadata, without building the metadata map.
+     *
+     * @return Returns <b>true</b> if there is no metadata; returns <b>false</b> otherwise.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool Empty() const;
+
     /**
      * @brief Convert the metadata map to string.
      *
@@ -248,7 +269,24 @@ public:
     std::string Stringify() const;
 
 private:
-    FormatDataMap formatMap_;
+    friend class MediaParcel;
+    struct FormatStorage;
+    using EntryVisitor = std::function<bool(uint32_t keyId, const std::string_view &key, const FormatData &data)>;
+
+    /**
+     * @brief The well-known keys are interned to the nonzero ids, which can be used to marshal
+     * the key instead of the string. The ids are only valid inside the same build.
+     */
+    static uint32_t GetKeyId(const std::string_view &key);
+    static std::string_view GetKeyName(uint32_t keyId);
+
+    bool ForEachEntry(const EntryVisitor &visitor) const;
+    const FormatData *FindData(const std::string_view &key) const;
+    bool InsertData(const std::string_view &key, FormatData &data);
+    FormatStorage &MutableStorage();
+
+    // the storage is shared between the copies, and is copied on the first modification.
+    std::shared_ptr<FormatStorage> storage_;
 };
 } // namespace Media
 } // namespace OHOS
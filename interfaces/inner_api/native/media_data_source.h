@@ -50,6 +50,8 @@ public:
      * @param mem Stream mem need to fill. see avsharedmemory.h.
      * The memory length is greater than or equal to the length.
      * The length of the filled memory must match the actual length returned.
+     * By default it is called from one thread at a time. If sys.media.datasrc.prefetch.num is set greater
+     * than 1, it is called concurrently for different positions, and must be thread-safe.
      * @return The actual length of stream mem filled, if failed or no mem return MediaDataSourceError.
      */
     virtual int32_t ReadAt(int64_t pos, uint32_t length, const std::shared_ptr<AVSharedMemory> &mem) = 0;
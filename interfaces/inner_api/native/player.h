@@ -41,6 +41,8 @@ public:
     static constexpr std::string_view PLAYER_CACHED_DURATION = "cached_duration";
     static constexpr std::string_view CONTENT_TYPE = "content_type";
     static constexpr std::string_view STREAM_USAGE = "stream_usage";
+    static constexpr std::string_view PLAYER_POSITION_UPDATE_INTERVAL = "position_update_interval";
+    static constexpr std::string_view PLAYER_PLAYBACK_RATE = "playback_rate";
 };
 
 enum BufferingInfoType : int32_t {
@@ -98,7 +100,9 @@ enum PlayerOnInfoType : int32_t {
     /* return multiqueue buffering time. */
     INFO_TYPE_BUFFERING_UPDATE,
     /* return the message with extra information in format. */
-    INFO_TYPE_EXTRA_FORMAT
+    INFO_TYPE_EXTRA_FORMAT,
+    /* return the message when the source set by SetNextSource starts playing. */
+    INFO_TYPE_NEXT_SOURCE_START,
 };
 
 enum PlayerStates : int32_t {
@@ -144,6 +148,20 @@ enum PlaybackRateMode : int32_t {
     SPEED_FORWARD_1_75_X,
     /* Video playback at 2.0x normal speed */
     SPEED_FORWARD_2_00_X,
+    /* Video playback at 4.0x normal speed, only the key frames are rendered and the audio is muted */
+    SPEED_FORWARD_4_00_X,
+    /* Video playback at 8.0x normal speed, only the key frames are rendered and the audio is muted */
+    SPEED_FORWARD_8_00_X,
+    /* Video playback at 16.0x normal speed, only the key frames are rendered and the audio is muted */
+    SPEED_FORWARD_16_00_X,
+    /* Video reverse playback at normal speed, only the key frames are rendered and the audio is muted */
+    SPEED_BACKWARD_1_00_X,
+    /* Video reverse playback at 4.0x normal speed, only the key frames are rendered and the audio is muted */
+    SPEED_BACKWARD_4_00_X,
+    /* Video reverse playback at 8.0x normal speed, only the key frames are rendered and the audio is muted */
+    SPEED_BACKWARD_8_00_X,
+    /* Video reverse playback at 16.0x normal speed, only the key frames are rendered and the audio is muted */
+    SPEED_BACKWARD_16_00_X,
 };
 
 class PlayerCallback {
@@ -206,6 +224,36 @@ public:
      */
     virtual int32_t SetSource(int32_t fd, int64_t offset = 0, int64_t size = 0) = 0;
 
+    /**
+     * @brief Sets the media source to play right after the current one, without a gap.
+     *
+     * The next source is prerolled while the current one plays and takes its place when the current one
+     * reaches the end, the audio output is kept open. {@link INFO_TYPE_NEXT_SOURCE_START} is reported when
+     * the next source starts playing, and no end of stream is reported for the current one. It can be
+     * called after the player is prepared, and is not supported for the media data source.
+     *
+     * @param url Indicates the playback source address, empty to clear the next source.
+     * @return Returns {@link MSERR_OK} if the next source is set successfully; returns an error code defined
+     * in {@link media_errors.h} otherwise, such as the current source is already finishing.
+     * @since 1.0
+     * @version 1.0
+     */
+    virtual int32_t SetNextSource(const std::string &url) = 0;
+
+    /**
+     * @brief Sets the media file descriptor source to play right after the current one, without a gap.
+     *
+     * @param fd Indicates the file descriptor of media source.
+     * @param offset Indicates the offset of media source in file descriptor.
+     * @param size Indicates the size of media source.
+     * @return Returns {@link MSERR_OK} if the next source is set successfully; returns an error code defined
+     * in {@link media_errors.h} otherwise.
+     * @see SetNextSource(const std::string &url)
+     * @since 1.0
+     * @version 1.0
+     */
+    virtual int32_t SetNextSource(int32_t fd, int64_t offset = 0, int64_t size = 0) = 0;
+
     /**
      * @brief Start playback.
      *
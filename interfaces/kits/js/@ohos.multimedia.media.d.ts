@@ -795,6 +795,48 @@ declare namespace media {
      * @syscap SystemCapability.Multimedia.Media.VideoPlayer
      */
     SPEED_FORWARD_2_00_X = 4,
+    /**
+     * playback at 4.0x normal speed, only the key frames are rendered
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Media.VideoPlayer
+     */
+    SPEED_FORWARD_4_00_X = 5,
+    /**
+     * playback at 8.0x normal speed, only the key frames are rendered
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Media.VideoPlayer
+     */
+    SPEED_FORWARD_8_00_X = 6,
+    /**
+     * playback at 16.0x normal speed, only the key frames are rendered
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Media.VideoPlayer
+     */
+    SPEED_FORWARD_16_00_X = 7,
+    /**
+     * reverse playback at normal speed, only the key frames are rendered
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Media.VideoPlayer
+     */
+    SPEED_BACKWARD_1_00_X = 8,
+    /**
+     * reverse playback at 4.0x normal speed, only the key frames are rendered
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Media.VideoPlayer
+     */
+    SPEED_BACKWARD_4_00_X = 9,
+    /**
+     * reverse playback at 8.0x normal speed, only the key frames are rendered
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Media.VideoPlayer
+     */
+    SPEED_BACKWARD_8_00_X = 10,
+    /**
+     * reverse playback at 16.0x normal speed, only the key frames are rendered
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Media.VideoPlayer
+     */
+    SPEED_BACKWARD_16_00_X = 11,
   }
 
   /**
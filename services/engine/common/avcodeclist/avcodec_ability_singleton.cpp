@@ -14,7 +14,9 @@
  */
 
 #include "avcodec_ability_singleton.h"
+#include <chrono>
 #include "avcodec_xml_parser.h"
+#include "avcodec_capability_cache.h"
 #include "media_log.h"
 #include "media_errors.h"
 
@@ -27,9 +29,12 @@ namespace Media {
 AVCodecAbilitySingleton& AVCodecAbilitySingleton::GetInstance()
 {
     static AVCodecAbilitySingleton instance;
-    bool ret = instance.ParseCodecXml();
-    if (!ret) {
-        MEDIA_LOGD("ParseCodecXml failed");
+    // retry until it succeeds, the config may be not readable yet at boot.
+    if (!instance.isParsered_) {
+        bool ret = instance.ParseCodecXml();
+        if (!ret) {
+            MEDIA_LOGD("ParseCodecXml failed");
+        }
     }
     return instance;
 }
@@ -37,6 +42,8 @@ AVCodecAbilitySingleton& AVCodecAbilitySingleton::GetInstance()
 AVCodecAbilitySingleton::AVCodecAbilitySingleton()
 {
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances create", FAKE_POINTER(this));
+    std::lock_guard<std::mutex> lock(mutex_);
+    UpdateIndexLocked();
 }
 
 AVCodecAbilitySingleton::~AVCodecAbilitySingleton()
@@ -46,9 +53,22 @@ AVCodecAbilitySingleton::~AVCodecAbilitySingleton()
 
 bool AVCodecAbilitySingleton::ParseCodecXml()
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     if (isParsered_) {
         return true;
     }
+    auto start = std::chrono::steady_clock::now();
+    std::vector<CapabilityData> cacheData;
+    if (AVCodecCapabilityCache::Load(AVCodecXmlParser::GetConfigFile(), cacheData)) {
+        capabilityDataArray_.insert(capabilityDataArray_.end(), cacheData.begin(), cacheData.end());
+        isParsered_ = true;
+        UpdateIndexLocked();
+        MEDIA_LOGI("load codec capability from cache, count: %{public}zu, cost: %{public}lld us",
+            cacheData.size(), static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+        return true;
+    }
+
     AVCodecXmlParser xmlParser;
     bool ret = xmlParser.LoadConfiguration();
     if (!ret) {
@@ -65,25 +85,45 @@ bool AVCodecAbilitySingleton::ParseCodecXml()
     std::vector<CapabilityData> data = xmlParser.GetCapabilityDataArray();
     capabilityDataArray_.insert(capabilityDataArray_.end(), data.begin(), data.end());
     isParsered_ = true;
+    UpdateIndexLocked();
+    MEDIA_LOGI("parse codec capability from xml, count: %{public}zu, cost: %{public}lld us",
+        data.size(), static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count()));
+    (void)AVCodecCapabilityCache::Save(AVCodecXmlParser::GetConfigFile(), data);
     return true;
 }
 
 bool AVCodecAbilitySingleton::RegisterCapability(const std::vector<CapabilityData> &registerCapabilityDataArray)
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     capabilityDataArray_.insert(capabilityDataArray_.begin(), registerCapabilityDataArray.begin(),
         registerCapabilityDataArray.end());
+    UpdateIndexLocked();
     MEDIA_LOGD("RegisterCapability success");
     return true;
 }
 
 bool AVCodecAbilitySingleton::IsParsered() const
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     return isParsered_;
 }
 
 std::vector<CapabilityData> AVCodecAbilitySingleton::GetCapabilityDataArray() const
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     return capabilityDataArray_;
 }
+
+std::shared_ptr<const AVCodecCapabilityIndex> AVCodecAbilitySingleton::GetCapabilityIndex() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_;
+}
+
+void AVCodecAbilitySingleton::UpdateIndexLocked()
+{
+    index_ = std::make_shared<const AVCodecCapabilityIndex>(capabilityDataArray_);
+}
 } // namespace Media
 } // namespace OHOS
@@ -16,8 +16,13 @@
 #ifndef AVCODEABILITY_SINGLETON_H
 #define AVCODEABILITY_SINGLETON_H
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include "format.h"
 #include "avcodec_info.h"
+#include "avcodec_capability_index.h"
+
 namespace OHOS {
 namespace Media {
 class __attribute__((visibility("default"))) AVCodecAbilitySingleton : public NoCopyable {
@@ -28,12 +33,17 @@ public:
     bool RegisterCapability(const std::vector<CapabilityData> &registerCapabilityDataArray);
     bool IsParsered() const;
     std::vector<CapabilityData> GetCapabilityDataArray() const;
+    std::shared_ptr<const AVCodecCapabilityIndex> GetCapabilityIndex() const;
 
 private:
-    bool isParsered_ = false;
+    std::atomic<bool> isParsered_ = false;
     AVCodecAbilitySingleton();
+    void UpdateIndexLocked();
     std::vector<CapabilityData> capabilityDataArray_;
+    // rebuilt when the capabilities change, the old one is kept alive by its users.
+    std::shared_ptr<const AVCodecCapabilityIndex> index_;
+    mutable std::mutex mutex_;
 };
 } // namespace Media
 } // namespace OHOS
-#endif // AVCODEABILITY_SINGLETON_H
\ No newline at end of file
+#endif // AVCODEABILITY_SINGLETON_H
\ No newline at end of file
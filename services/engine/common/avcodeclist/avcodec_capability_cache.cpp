@@ -0,0 +1,353 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "avcodec_capability_cache.h"
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "securec.h"
+#include "media_log.h"
+
+namespace {
+    constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "AVCodecCapabilityCache"};
+    const std::string CACHE_FILE = "/data/media/codec_caps.bin";
+    constexpr uint32_t CACHE_MAGIC = 0x50414343; // "CCAP"
+    // increase it when the layout of the CapabilityData or the cache changes.
+    constexpr uint32_t CACHE_VERSION = 2;
+    constexpr uint32_t FNV_OFFSET_BASIS = 2166136261;
+    constexpr uint32_t FNV_PRIME = 16777619;
+    constexpr uint64_t FNV64_OFFSET_BASIS = 14695981039346656037ULL;
+    constexpr uint64_t FNV64_PRIME = 1099511628211ULL;
+    constexpr uint32_t MAX_ELEMENT_COUNT = 65536;
+    constexpr int64_t MAX_XML_SIZE = 4 * 1024 * 1024;
+    constexpr mode_t CACHE_FILE_MODE = 0640;
+
+    struct CacheHeader {
+        uint32_t magic;
+        uint32_t version;
+        // the system images may be built with the fixed mtime, so the xml is checked by its content.
+        uint64_t xmlHash;
+        int64_t xmlSize;
+        uint32_t count;
+        uint32_t payloadSize;
+        uint32_t checksum;
+        uint32_t reserved;
+    };
+
+    uint32_t GetChecksum(const uint8_t *data, size_t size)
+    {
+        uint32_t hash = FNV_OFFSET_BASIS;
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ data[i]) * FNV_PRIME;
+        }
+        return hash;
+    }
+
+    bool HashXml(const std::string &xmlPath, CacheHeader &header)
+    {
+        int32_t fd = open(xmlPath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st {};
+        if (fstat(fd, &st) != 0 || st.st_size <= 0 || st.st_size > MAX_XML_SIZE) {
+            (void)close(fd);
+            return false;
+        }
+        std::string content(static_cast<size_t>(st.st_size), '\0');
+        ssize_t len = read(fd, content.data(), content.size());
+        (void)close(fd);
+        if (len != static_cast<ssize_t>(content.size())) {
+            return false;
+        }
+
+        uint64_t hash = FNV64_OFFSET_BASIS;
+        for (char ch : content) {
+            hash = (hash ^ static_cast<uint8_t>(ch)) * FNV64_PRIME;
+        }
+        header.xmlHash = hash;
+        header.xmlSize = static_cast<int64_t>(content.size());
+        return true;
+    }
+}
+
+namespace OHOS {
+namespace Media {
+class CacheWriter {
+public:
+    void WriteInt(int32_t value)
+    {
+        (void)buffer_.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    void WriteString(const std::string &str)
+    {
+        WriteInt(static_cast<int32_t>(str.size()));
+        (void)buffer_.append(str);
+    }
+
+    void WriteRange(const Range &range)
+    {
+        WriteInt(range.minVal);
+        WriteInt(range.maxVal);
+    }
+
+    void WriteSize(const ImgSize &size)
+    {
+        WriteInt(size.width);
+        WriteInt(size.height);
+    }
+
+    void WriteVector(const std::vector<int32_t> &vec)
+    {
+        WriteInt(static_cast<int32_t>(vec.size()));
+        for (auto value : vec) {
+            WriteInt(value);
+        }
+    }
+
+    const std::string &GetBuffer() const
+    {
+        return buffer_;
+    }
+
+private:
+    std::string buffer_;
+};
+
+class CacheReader {
+public:
+    CacheReader(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+
+    bool ReadInt(int32_t &value)
+    {
+        if (size_ - offset_ < sizeof(value)) {
+            return false;
+        }
+        (void)memcpy_s(&value, sizeof(value), data_ + offset_, sizeof(value));
+        offset_ += sizeof(value);
+        return true;
+    }
+
+    bool ReadCount(uint32_t &count)
+    {
+        int32_t value = 0;
+        if (!ReadInt(value) || value < 0 || static_cast<uint32_t>(value) > MAX_ELEMENT_COUNT) {
+            return false;
+        }
+        count = static_cast<uint32_t>(value);
+        return true;
+    }
+
+    bool ReadString(std::string &str)
+    {
+        uint32_t length = 0;
+        if (!ReadCount(length) || size_ - offset_ < length) {
+            return false;
+        }
+        str.assign(reinterpret_cast<const char *>(data_ + offset_), length);
+        offset_ += length;
+        return true;
+    }
+
+    bool ReadRange(Range &range)
+    {
+        return ReadInt(range.minVal) && ReadInt(range.maxVal);
+    }
+
+    bool ReadSize(ImgSize &size)
+    {
+        return ReadInt(size.width) && ReadInt(size.height);
+    }
+
+    bool ReadVector(std::vector<int32_t> &vec)
+    {
+        uint32_t count = 0;
+        if (!ReadCount(count)) {
+            return false;
+        }
+        vec.resize(count);
+        for (auto &value : vec) {
+            if (!ReadInt(value)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool IsEnd() const
+    {
+        return offset_ == size_;
+    }
+
+private:
+    const uint8_t *data_;
+    size_t size_;
+    size_t offset_ = 0;
+};
+
+static void WriteCapability(CacheWriter &writer, const CapabilityData &data)
+{
+    writer.WriteString(data.codecName);
+    writer.WriteInt(data.codecType);
+    writer.WriteString(data.mimeType);
+    writer.WriteInt(data.isVendor ? 1 : 0);
+    for (const Range *range : { &data.bitrate, &data.channels, &data.complexity, &data.alignment, &data.width,
+        &data.height, &data.frameRate, &data.encodeQuality, &data.quality, &data.blockPerFrame,
+        &data.blockPerSecond }) {
+        writer.WriteRange(*range);
+    }
+    writer.WriteSize(data.blockSize);
+    for (const std::vector<int32_t> *vec : { &data.sampleRate, &data.format, &data.profiles, &data.bitrateMode,
+        &data.levels }) {
+        writer.WriteVector(*vec);
+    }
+    writer.WriteInt(static_cast<int32_t>(data.profileLevelsMap.size()));
+    for (const auto &[profile, levels] : data.profileLevelsMap) {
+        writer.WriteInt(profile);
+        writer.WriteVector(levels);
+    }
+    writer.WriteInt(static_cast<int32_t>(data.measuredFrameRate.size()));
+    for (const auto &[size, range] : data.measuredFrameRate) {
+        writer.WriteSize(size);
+        writer.WriteRange(range);
+    }
+}
+
+static bool ReadCapability(CacheReader &reader, CapabilityData &data)
+{
+    int32_t isVendor = 0;
+    if (!reader.ReadString(data.codecName) || !reader.ReadInt(data.codecType) ||
+        !reader.ReadString(data.mimeType) || !reader.ReadInt(isVendor)) {
+        return false;
+    }
+    data.isVendor = isVendor != 0;
+    for (Range *range : { &data.bitrate, &data.channels, &data.complexity, &data.alignment, &data.width,
+        &data.height, &data.frameRate, &data.encodeQuality, &data.quality, &data.blockPerFrame,
+        &data.blockPerSecond }) {
+        CHECK_AND_RETURN_RET(reader.ReadRange(*range), false);
+    }
+    CHECK_AND_RETURN_RET(reader.ReadSize(data.blockSize), false);
+    for (std::vector<int32_t> *vec : { &data.sampleRate, &data.format, &data.profiles, &data.bitrateMode,
+        &data.levels }) {
+        CHECK_AND_RETURN_RET(reader.ReadVector(*vec), false);
+    }
+
+    uint32_t count = 0;
+    CHECK_AND_RETURN_RET(reader.ReadCount(count), false);
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t profile = 0;
+        std::vector<int32_t> levels;
+        CHECK_AND_RETURN_RET(reader.ReadInt(profile) && reader.ReadVector(levels), false);
+        data.profileLevelsMap[profile] = std::move(levels);
+    }
+    CHECK_AND_RETURN_RET(reader.ReadCount(count), false);
+    for (uint32_t i = 0; i < count; i++) {
+        ImgSize size;
+        Range range;
+        CHECK_AND_RETURN_RET(reader.ReadSize(size) && reader.ReadRange(range), false);
+        data.measuredFrameRate[size] = range;
+    }
+    return true;
+}
+
+static bool ParseCache(const uint8_t *base, size_t size, const CacheHeader &xmlHeader,
+    std::vector<CapabilityData> &capabilityDataArray)
+{
+    CacheHeader header {};
+    CHECK_AND_RETURN_RET(size >= sizeof(header), false);
+    (void)memcpy_s(&header, sizeof(header), base, sizeof(header));
+    if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION ||
+        header.xmlHash != xmlHeader.xmlHash || header.xmlSize != xmlHeader.xmlSize ||
+        header.payloadSize != size - sizeof(header) || header.count > MAX_ELEMENT_COUNT) {
+        MEDIA_LOGI("codec capability cache is stale");
+        return false;
+    }
+
+    const uint8_t *payload = base + sizeof(header);
+    CHECK_AND_RETURN_RET_LOG(GetChecksum(payload, header.payloadSize) == header.checksum, false,
+        "codec capability cache checksum mismatch");
+
+    CacheReader reader(payload, header.payloadSize);
+    std::vector<CapabilityData> result(header.count);
+    for (auto &data : result) {
+        CHECK_AND_RETURN_RET_LOG(ReadCapability(reader, data), false, "codec capability cache is corrupted");
+    }
+    CHECK_AND_RETURN_RET_LOG(reader.IsEnd(), false, "codec capability cache is corrupted");
+    capabilityDataArray = std::move(result);
+    return true;
+}
+
+bool AVCodecCapabilityCache::Load(const std::string &xmlPath, std::vector<CapabilityData> &capabilityDataArray)
+{
+    CacheHeader xmlHeader {};
+    CHECK_AND_RETURN_RET(HashXml(xmlPath, xmlHeader), false);
+
+    int32_t fd = open(CACHE_FILE.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        MEDIA_LOGD("no codec capability cache");
+        return false;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(CacheHeader))) {
+        (void)close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void *base = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    CHECK_AND_RETURN_RET_LOG(base != MAP_FAILED, false, "mmap codec capability cache failed");
+
+    bool ret = ParseCache(static_cast<const uint8_t *>(base), size, xmlHeader, capabilityDataArray);
+    (void)munmap(base, size);
+    return ret;
+}
+
+bool AVCodecCapabilityCache::Save(const std::string &xmlPath, const std::vector<CapabilityData> &capabilityDataArray)
+{
+    CacheHeader header {};
+    CHECK_AND_RETURN_RET(HashXml(xmlPath, header), false);
+    CHECK_AND_RETURN_RET(capabilityDataArray.size() <= MAX_ELEMENT_COUNT, false);
+
+    CacheWriter writer;
+    for (const auto &data : capabilityDataArray) {
+        WriteCapability(writer, data);
+    }
+    const std::string &payload = writer.GetBuffer();
+    header.magic = CACHE_MAGIC;
+    header.version = CACHE_VERSION;
+    header.count = static_cast<uint32_t>(capabilityDataArray.size());
+    header.payloadSize = static_cast<uint32_t>(payload.size());
+    header.checksum = GetChecksum(reinterpret_cast<const uint8_t *>(payload.data()), payload.size());
+
+    // write to a temporary file and rename it, so the cache is never seen half written.
+    std::string tmpFile = CACHE_FILE + ".tmp";
+    int32_t fd = open(tmpFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, CACHE_FILE_MODE);
+    CHECK_AND_RETURN_RET_LOG(fd >= 0, false, "create codec capability cache failed");
+    bool ret = write(fd, &header, sizeof(header)) == static_cast<ssize_t>(sizeof(header)) &&
+        write(fd, payload.data(), payload.size()) == static_cast<ssize_t>(payload.size());
+    (void)close(fd);
+    if (!ret || rename(tmpFile.c_str(), CACHE_FILE.c_str()) != 0) {
+        MEDIA_LOGW("write codec capability cache failed");
+        (void)unlink(tmpFile.c_str());
+        return false;
+    }
+    MEDIA_LOGI("codec capability cache saved, size: %{public}zu", sizeof(header) + payload.size());
+    return true;
+}
+} // namespace Media
+} // namespace OHOS
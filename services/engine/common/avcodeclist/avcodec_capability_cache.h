@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AVCODEC_CAPABILITY_CACHE_H
+#define AVCODEC_CAPABILITY_CACHE_H
+
+#include <string>
+#include <vector>
+#include "avcodec_info.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * Binary cache of the capabilities parsed from the codec xml. The cache records the hash and
+ * size of the xml content and the checksum of the payload, it is treated as stale if any of them
+ * does not match, and the caller falls back to parse the xml.
+ */
+class AVCodecCapabilityCache {
+public:
+    static bool Load(const std::string &xmlPath, std::vector<CapabilityData> &capabilityDataArray);
+    static bool Save(const std::string &xmlPath, const std::vector<CapabilityData> &capabilityDataArray);
+};
+} // namespace Media
+} // namespace OHOS
+#endif // AVCODEC_CAPABILITY_CACHE_H
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "avcodec_capability_index.h"
+#include <algorithm>
+#include <tuple>
+#include "media_log.h"
+
+namespace {
+    constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "AVCodecCapabilityIndex"};
+    constexpr double EPSINON = 0.0001;
+    constexpr size_t MAX_CACHE_SIZE = 128;
+
+    std::optional<int32_t> GetOptionalInt(const OHOS::Media::Format &format, const std::string_view &key)
+    {
+        int32_t value = 0;
+        if (format.GetValueType(key) != OHOS::Media::FORMAT_TYPE_INT32 || !format.GetIntValue(key, value)) {
+            return std::nullopt;
+        }
+        return value;
+    }
+}
+
+namespace OHOS {
+namespace Media {
+bool AVCodecCapabilityIndex::CapabilityQuery::operator<(const CapabilityQuery &rhs) const
+{
+    return std::tie(codecType, mimeType, bitrate, width, height, pixelFormat, frameRateInt, frameRateDouble,
+        sampleRate, channels) < std::tie(rhs.codecType, rhs.mimeType, rhs.bitrate, rhs.width, rhs.height,
+        rhs.pixelFormat, rhs.frameRateInt, rhs.frameRateDouble, rhs.sampleRate, rhs.channels);
+}
+
+AVCodecCapabilityIndex::AVCodecCapabilityIndex(const std::vector<CapabilityData> &capabilityDataArray)
+    : capabilityDataArray_(capabilityDataArray)
+{
+    for (const auto &data : capabilityDataArray_) {
+        CapabilityEntry entry;
+        entry.data = &data;
+        entry.isVideo = data.codecType == AVCODEC_TYPE_VIDEO_ENCODER || data.codecType == AVCODEC_TYPE_VIDEO_DECODER;
+        // the double frame rate within the EPSINON of the bounds is accepted.
+        entry.minFrameRate = static_cast<double>(data.frameRate.minVal) - EPSINON;
+        entry.maxFrameRate = static_cast<double>(data.frameRate.maxVal) + EPSINON;
+        entry.pixelFormats = data.format;
+        std::sort(entry.pixelFormats.begin(), entry.pixelFormats.end());
+        entry.sampleRates = data.sampleRate;
+        std::sort(entry.sampleRates.begin(), entry.sampleRates.end());
+        buckets_[std::make_pair(data.codecType, data.mimeType)].push_back(std::move(entry));
+    }
+    MEDIA_LOGD("build index for %{public}zu capabilities in %{public}zu buckets",
+        capabilityDataArray_.size(), buckets_.size());
+}
+
+AVCodecCapabilityIndex::CapabilityQuery AVCodecCapabilityIndex::ParseQuery(const Format &format,
+    AVCodecType codecType)
+{
+    CapabilityQuery query;
+    query.codecType = codecType;
+    (void)format.GetStringValue("codec_mime", query.mimeType);
+    query.bitrate = GetOptionalInt(format, "bitrate");
+    query.width = GetOptionalInt(format, "width");
+    query.height = GetOptionalInt(format, "height");
+    if (!query.width.has_value() || !query.height.has_value()) {
+        query.width.reset();
+        query.height.reset();
+    }
+    query.pixelFormat = GetOptionalInt(format, "pixel_format");
+    switch (format.GetValueType(std::string_view("frame_rate"))) {
+        case FORMAT_TYPE_INT32:
+            query.frameRateInt = GetOptionalInt(format, "frame_rate");
+            break;
+        case FORMAT_TYPE_DOUBLE: {
+            double frameRate = 0.0;
+            if (format.GetDoubleValue("frame_rate", frameRate)) {
+                query.frameRateDouble = frameRate;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    query.sampleRate = GetOptionalInt(format, "samplerate");
+    query.channels = GetOptionalInt(format, "channel_count");
+    return query;
+}
+
+bool AVCodecCapabilityIndex::IsMatched(const CapabilityQuery &query, const CapabilityEntry &entry)
+{
+    const CapabilityData &data = *entry.data;
+    auto inRange = [](const Range &range, int32_t value) {
+        return range.minVal <= value && value <= range.maxVal;
+    };
+
+    if (query.bitrate.has_value() && !inRange(data.bitrate, *query.bitrate)) {
+        return false;
+    }
+    if (query.width.has_value() && (!inRange(data.width, *query.width) || !inRange(data.height, *query.height))) {
+        return false;
+    }
+    if (query.frameRateInt.has_value() && !inRange(data.frameRate, *query.frameRateInt)) {
+        return false;
+    }
+    if (query.frameRateDouble.has_value() &&
+        (*query.frameRateDouble <= entry.minFrameRate || *query.frameRateDouble >= entry.maxFrameRate)) {
+        return false;
+    }
+
+    if (entry.isVideo) {
+        return !query.pixelFormat.has_value() ||
+            std::binary_search(entry.pixelFormats.begin(), entry.pixelFormats.end(), *query.pixelFormat);
+    }
+
+    if (query.sampleRate.has_value() &&
+        !std::binary_search(entry.sampleRates.begin(), entry.sampleRates.end(), *query.sampleRate)) {
+        return false;
+    }
+    return !query.channels.has_value() || inRange(data.channels, *query.channels);
+}
+
+std::string AVCodecCapabilityIndex::Match(const CapabilityQuery &query) const
+{
+    auto bucket = buckets_.find(std::make_pair(query.codecType, query.mimeType));
+    if (bucket == buckets_.end()) {
+        return "";
+    }
+
+    for (const auto &entry : bucket->second) {
+        if (IsMatched(query, entry)) {
+            return entry.data->codecName;
+        }
+    }
+    return "";
+}
+
+std::string AVCodecCapabilityIndex::FindCodec(const Format &format, AVCodecType codecType) const
+{
+    if (!format.ContainKey("codec_mime")) {
+        MEDIA_LOGD("Get MimeType from format failed");
+        return "";
+    }
+
+    CapabilityQuery query = ParseQuery(format, codecType);
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto iter = cache_.find(query);
+        if (iter != cache_.end()) {
+            return iter->second;
+        }
+    }
+
+    std::string codecName = Match(query);
+
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (cache_.size() >= MAX_CACHE_SIZE) {
+        cache_.clear();
+    }
+    cache_.emplace(std::move(query), codecName);
+    return codecName;
+}
+} // namespace Media
+} // namespace OHOS
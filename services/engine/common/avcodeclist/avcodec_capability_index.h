@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AVCODEC_CAPABILITY_INDEX_H
+#define AVCODEC_CAPABILITY_INDEX_H
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include "format.h"
+#include "avcodec_info.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * Immutable index of the codec capabilities, bucketed by the codec type and mime type. The
+ * results of the recent queries are memoized, so the repeated lookup does not scan the bucket.
+ */
+class AVCodecCapabilityIndex : public NoCopyable {
+public:
+    explicit AVCodecCapabilityIndex(const std::vector<CapabilityData> &capabilityDataArray);
+    ~AVCodecCapabilityIndex() = default;
+
+    const std::vector<CapabilityData> &GetCapabilityDataArray() const
+    {
+        return capabilityDataArray_;
+    }
+
+    std::string FindCodec(const Format &format, AVCodecType codecType) const;
+
+private:
+    // the fields of the query format which take part in the match, nullopt means unspecified.
+    struct CapabilityQuery {
+        int32_t codecType = AVCODEC_TYPE_NONE;
+        std::string mimeType;
+        std::optional<int32_t> bitrate;
+        std::optional<int32_t> width;
+        std::optional<int32_t> height;
+        std::optional<int32_t> pixelFormat;
+        std::optional<int32_t> frameRateInt;
+        std::optional<double> frameRateDouble;
+        std::optional<int32_t> sampleRate;
+        std::optional<int32_t> channels;
+        bool operator<(const CapabilityQuery &rhs) const;
+    };
+
+    // the range checks are normalized from the CapabilityData when the index is built.
+    struct CapabilityEntry {
+        const CapabilityData *data;
+        bool isVideo;
+        double minFrameRate;
+        double maxFrameRate;
+        std::vector<int32_t> pixelFormats; // sorted
+        std::vector<int32_t> sampleRates; // sorted
+    };
+
+    static CapabilityQuery ParseQuery(const Format &format, AVCodecType codecType);
+    static bool IsMatched(const CapabilityQuery &query, const CapabilityEntry &entry);
+    std::string Match(const CapabilityQuery &query) const;
+
+    const std::vector<CapabilityData> capabilityDataArray_;
+    std::map<std::pair<int32_t, std::string>, std::vector<CapabilityEntry>> buckets_;
+    mutable std::mutex cacheMutex_;
+    mutable std::map<CapabilityQuery, std::string> cache_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // AVCODEC_CAPABILITY_INDEX_H
@@ -150,6 +150,11 @@ AVCodecXmlParser::~AVCodecXmlParser()
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances destroy", FAKE_POINTER(this));
 }
 
+const std::string &AVCodecXmlParser::GetConfigFile()
+{
+    return AVCODEC_CONFIG_FILE;
+}
+
 bool AVCodecXmlParser::LoadConfiguration()
 {
     mDoc_ = xmlReadFile(AVCODEC_CONFIG_FILE.c_str(), nullptr, 0);
@@ -45,6 +45,7 @@ public:
     bool Parse();
     void Destroy();
     std::vector<CapabilityData> GetCapabilityDataArray() const;
+    static const std::string &GetConfigFile();
 
 private:
     bool IsNumberArray(const std::vector<std::string> &strArray) const;
@@ -33,15 +33,7 @@ public:
     std::vector<CapabilityData> GetCodecCapabilityInfos() override;
 
 private:
-    std::string FindTargetCodec(const Format &format,
-    const std::vector<CapabilityData> &capabilityDataArray, const AVCodecType &codecType);
-    bool IsSupportMimeType(const Format &format, const CapabilityData &data);
-    bool IsSupportBitrate(const Format &format, const CapabilityData &data);
-    bool IsSupportSize(const Format &format, const CapabilityData &data);
-    bool IsSupportPixelFormat(const Format &format, const CapabilityData &data);
-    bool IsSupportFrameRate(const Format &format, const CapabilityData &data);
-    bool IsSupportSampleRate(const Format &format, const CapabilityData &data);
-    bool IsSupportChannel(const Format &format, const CapabilityData &data);
+    std::string FindTargetCodec(const Format &format, const AVCodecType &codecType);
     std::mutex mutex_;
 };
 } // namespace Media
@@ -128,7 +128,7 @@ bool AVMetaElemMetaCollector::IsMetaCollected()
         if (!trackInfo.valid) {
             continue;
         }
-        if (trackInfo.innerMeta.GetFormatMap().empty()) {
+        if (trackInfo.innerMeta.Empty()) {
             return false;
         }
     }
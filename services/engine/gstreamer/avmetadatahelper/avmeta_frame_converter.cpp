@@ -16,12 +16,15 @@
 #include "avmeta_frame_converter.h"
 #include <gst/app/gstappsrc.h>
 #include <gst/video/video-info.h>
+#include "securec.h"
 #include "media_errors.h"
 #include "media_log.h"
 #include "gst_utils.h"
 #include "gst_shmem_memory.h"
+#include "avsharedmemorybase.h"
 #include "scope_guard.h"
 #include "time_perf.h"
+#include "param_wrapper.h"
 
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "AVMetaFrameConv"};
@@ -54,8 +57,10 @@ AVMetaFrameConverter::~AVMetaFrameConverter()
     CLEAN_PERF_RECORD(this);
 }
 
-int32_t AVMetaFrameConverter::Init(const OutputConfiguration &config)
+int32_t AVMetaFrameConverter::Init()
 {
+    AUTO_PERF(this, "SetupPipeline");
+
     std::unique_lock<std::mutex> lock(mutex_);
 
     int32_t ret = SetupConvPipeline();
@@ -64,22 +69,36 @@ int32_t AVMetaFrameConverter::Init(const OutputConfiguration &config)
     ret = SetupConvSrc();
     CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
 
-    ret = SetupConvSink(config);
+    ret = SetupConvSink();
     CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
 
     ret = SetupMsgProcessor();
     CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
 
+    // the pipeline is still required for the formats that the scaler can not handle.
+    if (OHOS::system::GetIntParameter("sys.media.avmeta.fastconvert", 1) != 0) {
+        yuvScaler_ = std::make_unique<AVMetaYuvScaler>();
+    }
+
     return MSERR_OK;
 }
 
-std::shared_ptr<AVSharedMemory> AVMetaFrameConverter::Convert(GstCaps &inCaps, GstBuffer &inBuf)
+std::shared_ptr<AVSharedMemory> AVMetaFrameConverter::Convert(
+    const OutputConfiguration &outConfig, GstCaps &inCaps, GstBuffer &inBuf)
 {
     AUTO_PERF(this, "ConvertFrame");
 
     std::unique_lock<std::mutex> lock(mutex_);
 
-    int32_t ret = PrepareConvert(inCaps);
+    if (yuvScaler_ != nullptr) {
+        auto result = yuvScaler_->Convert(outConfig, inCaps, inBuf);
+        if (result != nullptr) {
+            return result;
+        }
+        MEDIA_LOGD("fallback to the conversion pipeline");
+    }
+
+    int32_t ret = PrepareConvert(outConfig, inCaps);
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, nullptr, "prepare convert failed");
 
     GstFlowReturn flowRet = GST_FLOW_ERROR;
@@ -91,21 +110,39 @@ std::shared_ptr<AVSharedMemory> AVMetaFrameConverter::Convert(GstCaps &inCaps, G
     return GetConvertResult();
 }
 
-int32_t AVMetaFrameConverter::PrepareConvert(GstCaps &inCaps)
+int32_t AVMetaFrameConverter::PrepareConvert(const OutputConfiguration &outConfig, GstCaps &inCaps)
 {
-    ON_SCOPE_EXIT(0) { (void)GetConvertResult(); };
+    ON_SCOPE_EXIT(0) {
+        // force to renegotiate at the next conversion
+        hasOutConfig_ = false;
+        (void)GetConvertResult();
+    };
+
+    bool outConfigChanged = !hasOutConfig_ || outConfig_.dstWidth != outConfig.dstWidth ||
+        outConfig_.dstHeight != outConfig.dstHeight || outConfig_.colorFormat != outConfig.colorFormat;
+    bool inCapsChanged = lastCaps_ == nullptr || !gst_caps_is_equal(lastCaps_, &inCaps);
+
+    // the pipeline is kept between conversions, renegotiate only when the input or output format changes.
+    if (outConfigChanged || inCapsChanged) {
+        AUTO_PERF(this, "Renegotiate");
 
-    if (lastCaps_ == nullptr || !gst_caps_is_equal(lastCaps_, &inCaps)) {
-        MEDIA_LOGI("caps changed");
-        MEDIA_LOGI("current caps: %{public}s", gst_caps_to_string(&inCaps));
         int32_t ret = ChangeState(GST_STATE_READY);
         CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
 
-        g_object_set(G_OBJECT(appSrc_), "caps", &inCaps,  nullptr);
-        if (lastCaps_ != nullptr) {
-            gst_caps_unref(lastCaps_);
+        if (outConfigChanged) {
+            ret = SetOutputCaps(outConfig);
+            CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
+        }
+
+        if (inCapsChanged) {
+            MEDIA_LOGI("caps changed");
+            MEDIA_LOGI("current caps: %{public}s", gst_caps_to_string(&inCaps));
+            g_object_set(G_OBJECT(appSrc_), "caps", &inCaps,  nullptr);
+            if (lastCaps_ != nullptr) {
+                gst_caps_unref(lastCaps_);
+            }
+            lastCaps_ = gst_caps_ref(&inCaps);
         }
-        lastCaps_ = gst_caps_ref(&inCaps);
 
         ret = ChangeState(GST_STATE_PLAYING);
         CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
@@ -144,20 +181,41 @@ std::shared_ptr<AVSharedMemory> AVMetaFrameConverter::GetConvertResult()
     CHECK_AND_RETURN_RET_LOG(mem != nullptr && mem->mem != nullptr, nullptr, "mem is nullptr");
     CHECK_AND_RETURN_RET_LOG(mem->mem->GetBase() != nullptr, nullptr, "addr is nullptr");
 
-    std::shared_ptr<AVSharedMemory> result = mem->mem;
-    if (!(result->GetSize() > 0 && static_cast<uint32_t>(result->GetSize()) >= sizeof(OutputFrame))) {
+    std::shared_ptr<AVSharedMemory> convMem = mem->mem;
+    if (!(convMem->GetSize() > 0 && static_cast<uint32_t>(convMem->GetSize()) >= sizeof(OutputFrame))) {
         MEDIA_LOGE("size is incorrect");
         return nullptr;
     }
 
-    auto frame = reinterpret_cast<OutputFrame *>(result->GetBase());
+    auto frame = reinterpret_cast<OutputFrame *>(convMem->GetBase());
     frame->bytesPerPixel_ = PIXELFORMAT_INFO.at(outConfig_.colorFormat).bytesPerPixel;
     frame->width_ = static_cast<int32_t>(videoMeta->width);
     frame->height_ = static_cast<int32_t>(videoMeta->height);
     frame->stride_ = videoMeta->stride[0];
     frame->size_ = frame->stride_ * frame->height_;
 
-    CHECK_AND_RETURN_RET_LOG(result->GetSize() >= frame->GetFlattenedSize(), nullptr, "size is incorrect");
+    CHECK_AND_RETURN_RET_LOG(convMem->GetSize() >= frame->GetFlattenedSize(), nullptr, "size is incorrect");
+
+    // lend the sink's buffer to the caller until the result is dropped. Keep one buffer for the sink,
+    // otherwise it waits for a free buffer while the caller still holds all of them.
+    std::shared_ptr<AVSharedMemory> result = nullptr;
+    if (lentFrames_->load() + 1 < poolCapacity_) {
+        GstBuffer *buffer = gst_buffer_ref(lastResult_);
+        std::shared_ptr<std::atomic<uint32_t>> lentFrames = lentFrames_;
+        (*lentFrames)++;
+        result = std::shared_ptr<AVSharedMemory>(convMem.get(), [buffer, lentFrames](AVSharedMemory *) {
+            gst_buffer_unref(buffer);
+            (*lentFrames)--;
+        });
+    } else {
+        result = AVSharedMemoryBase::CreateFromLocal(
+            frame->GetFlattenedSize(), AVSharedMemory::FLAGS_READ_WRITE, "frame");
+        CHECK_AND_RETURN_RET_LOG(result != nullptr, nullptr, "create frame memory failed");
+
+        errno_t rc = memcpy_s(result->GetBase(), static_cast<size_t>(result->GetSize()),
+            convMem->GetBase(), static_cast<size_t>(frame->GetFlattenedSize()));
+        CHECK_AND_RETURN_RET_LOG(rc == EOK, nullptr, "memcpy_s failed");
+    }
 
     MEDIA_LOGI("======================Convert Frame Finished=========================");
     MEDIA_LOGI("output width = %{public}d, stride = %{public}d, height = %{public}d, format = %{public}d",
@@ -218,11 +276,7 @@ int32_t AVMetaFrameConverter::Reset()
         lastCaps_ = nullptr;
     }
 
-    for (auto &sample : allResults_) {
-        gst_buffer_unref(sample);
-    }
-    allResults_.clear();
-
+    hasOutConfig_ = false;
     startConverting_ = false;
     cond_.notify_all();
 
@@ -270,7 +324,17 @@ int32_t AVMetaFrameConverter::SetupConvSrc()
     return MSERR_OK;
 }
 
-int32_t AVMetaFrameConverter::SetupConvSink(const OutputConfiguration &outConfig)
+int32_t AVMetaFrameConverter::SetupConvSink()
+{
+    g_object_set(G_OBJECT(vidShMemSink_), "mem-prefix-size", sizeof(OutputFrame), nullptr);
+    g_object_get(G_OBJECT(vidShMemSink_), "max-pool-capacity", &poolCapacity_, nullptr);
+
+    GstMemSinkCallbacks callbacks = { nullptr, nullptr, OnNotifyNewSample };
+    gst_mem_sink_set_callback(GST_MEM_SINK_CAST(vidShMemSink_), &callbacks, this, nullptr);
+    return MSERR_OK;
+}
+
+int32_t AVMetaFrameConverter::SetOutputCaps(const OutputConfiguration &outConfig)
 {
     if (PIXELFORMAT_INFO.count(outConfig.colorFormat) == 0) {
         MEDIA_LOGE("pixelformat unsupported: %{public}d", outConfig.colorFormat);
@@ -298,12 +362,9 @@ int32_t AVMetaFrameConverter::SetupConvSink(const OutputConfiguration &outConfig
     g_object_set(G_OBJECT(vidShMemSink_), "caps", caps, nullptr);
     gst_caps_unref(caps);
     caps = nullptr;
-    g_object_set(G_OBJECT(vidShMemSink_), "mem-prefix-size", sizeof(OutputFrame), nullptr);
-
-    GstMemSinkCallbacks callbacks = { nullptr, nullptr, OnNotifyNewSample };
-    gst_mem_sink_set_callback(GST_MEM_SINK_CAST(vidShMemSink_), &callbacks, this, nullptr);
 
     outConfig_ = outConfig;
+    hasOutConfig_ = true;
     return MSERR_OK;
 }
 
@@ -381,8 +442,6 @@ GstFlowReturn AVMetaFrameConverter::OnNotifyNewSample(GstMemSink *elem, GstBuffe
 
     thiz->lastResult_ = gst_buffer_ref(sample);
     CHECK_AND_RETURN_RET(thiz->lastResult_ != nullptr, GST_FLOW_ERROR);
-    // increase the refcount to avoid the buffer to be released to bufferpool.
-    thiz->allResults_.push_back(gst_buffer_ref(sample));
 
     thiz->cond_.notify_all();
     return GST_FLOW_OK;
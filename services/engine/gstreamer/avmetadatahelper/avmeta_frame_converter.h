@@ -16,6 +16,7 @@
 #ifndef AVMETA_FRAME_CONVERTER_H
 #define AVMETA_FRAME_CONVERTER_H
 
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 #include <gst/gst.h>
@@ -24,6 +25,7 @@
 #include "inner_msg_define.h"
 #include "gst_mem_sink.h"
 #include "gst_msg_processor.h"
+#include "avmeta_yuv_scaler.h"
 #include "nocopyable.h"
 
 namespace OHOS {
@@ -33,34 +35,39 @@ public:
     AVMetaFrameConverter();
     ~AVMetaFrameConverter();
 
-    int32_t Init(const OutputConfiguration &outConfig);
-    std::shared_ptr<AVSharedMemory> Convert(GstCaps &inCaps, GstBuffer &inBuf);
+    int32_t Init();
+    std::shared_ptr<AVSharedMemory> Convert(const OutputConfiguration &outConfig, GstCaps &inCaps, GstBuffer &inBuf);
 
 private:
     int32_t SetupConvPipeline();
     int32_t SetupConvSrc();
-    int32_t SetupConvSink(const OutputConfiguration &outConfig);
+    int32_t SetupConvSink();
     int32_t SetupMsgProcessor();
+    int32_t SetOutputCaps(const OutputConfiguration &outConfig);
     void UninstallPipeline();
     int32_t ChangeState(GstState targetState);
-    int32_t PrepareConvert(GstCaps &inCaps);
+    int32_t PrepareConvert(const OutputConfiguration &outConfig, GstCaps &inCaps);
     std::shared_ptr<AVSharedMemory> GetConvertResult();
     int32_t Reset();
     void OnNotifyMessage(const InnerMessage &msg);
     static GstFlowReturn OnNotifyNewSample(GstMemSink *elem, GstBuffer *sample, gpointer thiz);
 
     OutputConfiguration outConfig_;
+    bool hasOutConfig_ = false;
     GstPipeline *pipeline_ = nullptr;
     GstElement *vidShMemSink_ = nullptr;
     GstElement *appSrc_ = nullptr;
     std::unique_ptr<GstMsgProcessor> msgProcessor_;
+    std::unique_ptr<AVMetaYuvScaler> yuvScaler_;
     GstState currState_ = GST_STATE_NULL;
     GstCaps *lastCaps_ = nullptr;
     GstBuffer *lastResult_ = nullptr;
     std::mutex mutex_;
     std::condition_variable cond_;
     bool startConverting_ = false;
-    std::vector<GstBuffer *> allResults_;
+    guint poolCapacity_ = 0;
+    // results still referencing the sink's buffers, shared with their deleters
+    std::shared_ptr<std::atomic<uint32_t>> lentFrames_ = std::make_shared<std::atomic<uint32_t>>(0);
 };
 } // namespace Media
 } // namespace OHOS
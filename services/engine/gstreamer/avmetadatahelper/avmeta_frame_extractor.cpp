@@ -14,6 +14,8 @@
  */
 
 #include "avmeta_frame_extractor.h"
+#include <algorithm>
+#include <numeric>
 #include "media_errors.h"
 #include "media_log.h"
 #include "scope_guard.h"
@@ -21,6 +23,9 @@
 
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "AVMetaFrameExtract"};
+    // decoding forward is preferred to seeking only when the next position is within a typical gop.
+    constexpr int64_t MAX_DECODE_FORWARD_US = 1000000;
+    constexpr uint32_t MAX_DECODE_FORWARD_FRAMES = 240;
 }
 
 namespace OHOS {
@@ -60,17 +65,31 @@ int32_t AVMetaFrameExtractor::Init(const std::shared_ptr<IPlayBinCtrler> &playbi
     return MSERR_OK;
 }
 
-std::shared_ptr<AVSharedMemory> AVMetaFrameExtractor::ExtractFrame(
-    int64_t timeUs, int32_t option, const OutputConfiguration &param)
+std::vector<std::shared_ptr<AVSharedMemory>> AVMetaFrameExtractor::ExtractFrames(
+    const std::vector<int64_t> &timesUs, int32_t option, const OutputConfiguration &param)
 {
-    int32_t ret = StartExtract(1, timeUs, option, param);
-    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, nullptr, "start extract failed");
+    std::vector<std::shared_ptr<AVSharedMemory>> outFrames(timesUs.size(), nullptr);
+    CHECK_AND_RETURN_RET(!timesUs.empty(), outFrames);
+
+    // visit the positions in ascending order, so that a nearby position can be reached by decoding forward.
+    std::vector<size_t> order(timesUs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&timesUs](size_t lhs, size_t rhs) {
+        return timesUs[lhs] < timesUs[rhs];
+    });
 
-    auto outFrames = ExtractInternel();
-    StopExtract();
+    // hold the converter during the whole extraction, so that the Reset can not destroy it while converting.
+    auto frameConverter = StartExtract();
+    CHECK_AND_RETURN_RET_LOG(frameConverter != nullptr, outFrames, "start extract failed");
 
-    CHECK_AND_RETURN_RET_LOG(!outFrames.empty(), nullptr, "extract failed");
-    return outFrames[0];
+    ExtractCursor cursor;
+    for (auto index : order) {
+        outFrames[index] = ExtractInternel(timesUs[index], option, param, *frameConverter, cursor);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    StopExtract();
+    return outFrames;
 }
 
 void AVMetaFrameExtractor::ClearCache()
@@ -92,11 +111,13 @@ void AVMetaFrameExtractor::Reset()
 
     decltype(signalIds_) tempSignalIds;
     tempSignalIds.swap(signalIds_);
+    auto tempConverter = std::move(frameConverter_);
 
     lock.unlock();
     for(auto signalId : tempSignalIds) {
         g_signal_handler_disconnect(vidAppSink_, signalId);
     }
+    tempConverter = nullptr;
     lock.lock();
 
     if (vidAppSink_ != nullptr) {
@@ -106,47 +127,101 @@ void AVMetaFrameExtractor::Reset()
     playbin_ = nullptr;
 }
 
-std::vector<std::shared_ptr<AVSharedMemory>> AVMetaFrameExtractor::ExtractInternel()
+std::shared_ptr<AVSharedMemory> AVMetaFrameExtractor::ExtractInternel(int64_t timeUs, int32_t option,
+    const OutputConfiguration &param, AVMetaFrameConverter &frameConverter, ExtractCursor &cursor)
 {
-    std::vector<std::shared_ptr<AVSharedMemory>> outFrames;
+    if (cursor.frame != nullptr && timeUs >= cursor.timeUs) {
+        // the frame resolved for the last position is also the answer for this position.
+        bool sameFrame = (timeUs == cursor.timeUs);
+        if (option == AV_META_QUERY_NEXT_SYNC) {
+            sameFrame = sameFrame || timeUs <= cursor.ptsUs;
+        } else if (option == AV_META_QUERY_CLOSEST && cursor.durationUs > 0) {
+            sameFrame = sameFrame || (timeUs >= cursor.ptsUs && timeUs < cursor.ptsUs + cursor.durationUs);
+        }
+        if (sameFrame) {
+            MEDIA_LOGD("reuse the frame at %{public}" PRIi64 " for %{public}" PRIi64 "", cursor.ptsUs, timeUs);
+            cursor.timeUs = timeUs;
+            return cursor.frame;
+        }
+    }
 
-    std::unique_lock<std::mutex> lock(mutex_);
-    static constexpr int32_t timeout = 5;
-    cond_.wait_for(lock, std::chrono::seconds(timeout), [this]() {
-        return !originalFrames_.empty() || !startExtracting_;
-    });
-    CHECK_AND_RETURN_RET_LOG(startExtracting_, outFrames, "cancelled, exit frame extract");
-    CHECK_AND_RETURN_RET_LOG(!originalFrames_.empty(), outFrames, "no more frames");
+    GstBuffer *buffer = nullptr;
+    GstCaps *caps = nullptr;
+    int32_t ret = MSERR_UNKNOWN;
+    if (option == AV_META_QUERY_CLOSEST && cursor.frame != nullptr && cursor.ptsUs >= 0 &&
+        timeUs > cursor.ptsUs && timeUs - cursor.ptsUs <= MAX_DECODE_FORWARD_US) {
+        ret = StepToTime(timeUs, buffer, caps);
+        if (ret != MSERR_OK) {
+            MEDIA_LOGW("decode forward to %{public}" PRIi64 " failed, try to seek", timeUs);
+        }
+    }
+    if (ret != MSERR_OK) {
+        ret = SeekToTime(timeUs, option, buffer, caps);
+    }
+    if (ret != MSERR_OK) {
+        // the position of the video sink is unknown now, never derive the next frame from it.
+        cursor = ExtractCursor {};
+        MEDIA_LOGE("extract frame at %{public}" PRIi64 " failed", timeUs);
+        return nullptr;
+    }
 
-    auto item = originalFrames_.front();
-    originalFrames_.pop();
-    auto frameConverter = std::move(frameConverter_);
-    lock.unlock();
+    ON_SCOPE_EXIT(0) {
+        gst_buffer_unref(buffer);
+        gst_caps_unref(caps);
+    };
+
+    int64_t ptsUs = GST_BUFFER_PTS_IS_VALID(buffer) ?
+        static_cast<int64_t>(GST_TIME_AS_USECONDS(GST_BUFFER_PTS(buffer))) : -1;
+    int64_t durationUs = GST_BUFFER_DURATION_IS_VALID(buffer) ?
+        static_cast<int64_t>(GST_TIME_AS_USECONDS(GST_BUFFER_DURATION(buffer))) : -1;
 
-    auto outFrame = frameConverter->Convert(*item.second, *item.first);
+    if (cursor.frame != nullptr && ptsUs >= 0 && ptsUs == cursor.ptsUs) {
+        MEDIA_LOGD("same frame as the last position, skip convert");
+        cursor.timeUs = timeUs;
+        return cursor.frame;
+    }
+
+    auto outFrame = frameConverter.Convert(param, *caps, *buffer);
     if (outFrame == nullptr) {
-        gst_buffer_unref(item.first);
-        gst_caps_unref(item.second);
+        cursor = ExtractCursor {};
         MEDIA_LOGE("convert frame failed");
-        return outFrames;
+        // the conversion pipeline maybe broken, rebuild it at the next extraction.
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (frameConverter_.get() == &frameConverter) {
+            frameConverter_ = nullptr;
+        }
+        return nullptr;
     }
-    gst_buffer_unref(item.first);
-    gst_caps_unref(item.second);
 
-    outFrames.push_back(outFrame);
-    MEDIA_LOGD("extract frame success, frame number: %{public}zu", outFrames.size());
-    return outFrames;
+    cursor = ExtractCursor { timeUs, ptsUs, durationUs, outFrame };
+    MEDIA_LOGD("extract frame success, time: %{public}" PRIi64 ", pts: %{public}" PRIi64 "", timeUs, ptsUs);
+    return outFrame;
 }
 
-int32_t AVMetaFrameExtractor::StartExtract(
-    int32_t numFrames, int64_t timeUs, int32_t option, const OutputConfiguration &param)
+std::shared_ptr<AVMetaFrameConverter> AVMetaFrameExtractor::StartExtract()
 {
     std::unique_lock<std::mutex> lock(mutex_);
-
-    ON_SCOPE_EXIT(0) { StopExtract(); };
+    CHECK_AND_RETURN_RET_LOG(playbin_ != nullptr, nullptr, "not initialized");
+
+    // the conversion pipeline is built once and kept until the Reset.
+    if (frameConverter_ == nullptr) {
+        auto frameConverter = std::make_shared<AVMetaFrameConverter>();
+        int32_t ret = frameConverter->Init();
+        CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, nullptr, "init failed, cancel extract frames");
+        frameConverter_ = frameConverter;
+    }
 
     ClearCache();
     startExtracting_ = true;
+    return frameConverter_;
+}
+
+int32_t AVMetaFrameExtractor::SeekToTime(int64_t timeUs, int32_t option, GstBuffer *&buffer, GstCaps *&caps)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(startExtracting_, MSERR_INVALID_OPERATION, "cancelled, exit frame extract");
+
+    ClearCache();
 
     IPlayBinCtrler::PlayBinSeekMode mode = IPlayBinCtrler::PlayBinSeekMode::PREV_SYNC;
     if (SEEK_OPTION_MAPPING.find(option) != SEEK_OPTION_MAPPING.end()) {
@@ -156,10 +231,6 @@ int32_t AVMetaFrameExtractor::StartExtract(
     int32_t ret = playbin_->Seek(timeUs, mode);
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "seek failed, cancel extract frames");
 
-    frameConverter_ = std::make_unique<AVMetaFrameConverter>();
-    ret = frameConverter_->Init(param);
-    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "init failed, cancel extract frames");
-
     static constexpr int32_t timeout = 5;
     cond_.wait_for(lock, std::chrono::seconds(timeout), [this]() {
         return seekDone_ || !startExtracting_;
@@ -174,7 +245,77 @@ int32_t AVMetaFrameExtractor::StartExtract(
         CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "sek failed, cancel extract frames");
     }
 
-    CANCEL_SCOPE_EXIT_GUARD(0);
+    return PopFrame(lock, buffer, caps);
+}
+
+int32_t AVMetaFrameExtractor::StepToTime(int64_t timeUs, GstBuffer *&buffer, GstCaps *&caps)
+{
+    GstClockTime timeNs = static_cast<GstClockTime>(timeUs) * GST_USECOND;
+
+    for (uint32_t steps = 0; steps < MAX_DECODE_FORWARD_FRAMES; ++steps) {
+        int32_t ret = StepOneFrame(buffer, caps);
+        CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
+
+        if (!GST_BUFFER_PTS_IS_VALID(buffer)) {
+            MEDIA_LOGW("pts is invalid, stop decode forward");
+            break;
+        }
+
+        // stop at the frame that covers the position, same as what the accurate seek outputs.
+        GstClockTime pts = GST_BUFFER_PTS(buffer);
+        if (GST_BUFFER_DURATION_IS_VALID(buffer) ? (pts + GST_BUFFER_DURATION(buffer) > timeNs) : (pts >= timeNs)) {
+            MEDIA_LOGD("decode forward %{public}u frames", steps + 1);
+            return MSERR_OK;
+        }
+
+        gst_buffer_unref(buffer);
+        gst_caps_unref(caps);
+        buffer = nullptr;
+        caps = nullptr;
+    }
+
+    if (buffer != nullptr) {
+        gst_buffer_unref(buffer);
+        gst_caps_unref(caps);
+        buffer = nullptr;
+        caps = nullptr;
+    }
+    return MSERR_UNKNOWN;
+}
+
+int32_t AVMetaFrameExtractor::StepOneFrame(GstBuffer *&buffer, GstCaps *&caps)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(startExtracting_, MSERR_INVALID_OPERATION, "cancelled, exit frame extract");
+    CHECK_AND_RETURN_RET(vidAppSink_ != nullptr, MSERR_INVALID_OPERATION);
+
+    ClearCache();
+    GstElement *sink = GST_ELEMENT_CAST(gst_object_ref(vidAppSink_));
+
+    // the new-preroll callback is invoked with the sink's preroll lock held, unlock to avoid the deadlock.
+    lock.unlock();
+    GstEvent *event = gst_event_new_step(GST_FORMAT_BUFFERS, 1, 1.0, TRUE, FALSE);
+    gboolean ret = gst_element_send_event(sink, event);
+    gst_object_unref(sink);
+    lock.lock();
+    CHECK_AND_RETURN_RET_LOG(ret, MSERR_UNKNOWN, "step failed");
+
+    return PopFrame(lock, buffer, caps);
+}
+
+int32_t AVMetaFrameExtractor::PopFrame(std::unique_lock<std::mutex> &lock, GstBuffer *&buffer, GstCaps *&caps)
+{
+    static constexpr int32_t timeout = 5;
+    cond_.wait_for(lock, std::chrono::seconds(timeout), [this]() {
+        return !originalFrames_.empty() || !startExtracting_;
+    });
+    CHECK_AND_RETURN_RET_LOG(startExtracting_, MSERR_INVALID_OPERATION, "cancelled, exit frame extract");
+    CHECK_AND_RETURN_RET_LOG(!originalFrames_.empty(), MSERR_UNKNOWN, "no more frames");
+
+    auto item = originalFrames_.front();
+    originalFrames_.pop();
+    buffer = item.first;
+    caps = item.second;
     return MSERR_OK;
 }
 
@@ -183,7 +324,6 @@ void AVMetaFrameExtractor::StopExtract()
     ClearCache();
     startExtracting_ = false;
     cond_.notify_all();
-    frameConverter_ = nullptr;
 }
 
 void AVMetaFrameExtractor::NotifyPlayBinMsg(const PlayBinMessage &msg)
@@ -32,14 +32,27 @@ public:
     ~AVMetaFrameExtractor();
 
     int32_t Init(const std::shared_ptr<IPlayBinCtrler> &playbin, GstElement &vidAppSink);
-    std::shared_ptr<AVSharedMemory> ExtractFrame(int64_t timeUs, int32_t option, const OutputConfiguration &param);
+    std::vector<std::shared_ptr<AVSharedMemory>> ExtractFrames(
+        const std::vector<int64_t> &timesUs, int32_t option, const OutputConfiguration &param);
     void Reset();
     void NotifyPlayBinMsg(const PlayBinMessage &msg);
 
 private:
+    struct ExtractCursor {
+        int64_t timeUs = -1;
+        int64_t ptsUs = -1;
+        int64_t durationUs = -1;
+        std::shared_ptr<AVSharedMemory> frame;
+    };
+
     int32_t SetupVideoSink();
-    int32_t StartExtract(int32_t numFrames, int64_t timeUs, int32_t option, const OutputConfiguration &param);
-    std::vector<std::shared_ptr<AVSharedMemory>> ExtractInternel();
+    std::shared_ptr<AVMetaFrameConverter> StartExtract();
+    std::shared_ptr<AVSharedMemory> ExtractInternel(int64_t timeUs, int32_t option,
+        const OutputConfiguration &param, AVMetaFrameConverter &frameConverter, ExtractCursor &cursor);
+    int32_t SeekToTime(int64_t timeUs, int32_t option, GstBuffer *&buffer, GstCaps *&caps);
+    int32_t StepToTime(int64_t timeUs, GstBuffer *&buffer, GstCaps *&caps);
+    int32_t StepOneFrame(GstBuffer *&buffer, GstCaps *&caps);
+    int32_t PopFrame(std::unique_lock<std::mutex> &lock, GstBuffer *&buffer, GstCaps *&caps);
     void StopExtract();
     void ClearCache();
 
@@ -52,7 +65,7 @@ private:
     std::condition_variable cond_;
     bool seekDone_ = false;
     bool startExtracting_ = false;
-    std::unique_ptr<AVMetaFrameConverter> frameConverter_;
+    std::shared_ptr<AVMetaFrameConverter> frameConverter_;
     std::vector<gulong> signalIds_;
 };
 } // namespace Media
@@ -0,0 +1,363 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "avmeta_yuv_scaler.h"
+#include <algorithm>
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "media_errors.h"
+#include "media_log.h"
+#include "avsharedmemorybase.h"
+#include "scope_guard.h"
+
+namespace {
+    constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "AVMetaYuvScaler"};
+    constexpr int32_t KEEP_ORIGINAL_WIDTH_OR_HEIGHT = -1;
+    // the same limits as the output size that the avmetadatahelper engine accepts
+    constexpr int64_t MAX_DST_WIDTH = 7680;
+    constexpr int64_t MAX_DST_HEIGHT = 4320;
+    constexpr int32_t FIXED_POINT_SHIFT = 16;
+    constexpr int32_t FRAC_BITS = 8;
+    constexpr int32_t FRAC_ONE = 1 << FRAC_BITS;
+
+    // BT.601 limited range, the coefficients are scaled by 64, so the products fit in int16.
+    constexpr int16_t COEF_Y = 74;
+    constexpr int16_t COEF_RV = 102;
+    constexpr int16_t COEF_GU = 25;
+    constexpr int16_t COEF_GV = 52;
+    constexpr int16_t COEF_BU = 129;
+    constexpr int16_t Y_OFFSET = 16;
+    constexpr int16_t UV_OFFSET = 128;
+    constexpr int32_t COEF_SHIFT = 6;
+    constexpr int32_t COEF_ROUND = 1 << (COEF_SHIFT - 1);
+    constexpr uint8_t ALPHA_OPAQUE = 0xFF;
+}
+
+namespace OHOS {
+namespace Media {
+static inline uint8_t ClampToU8(int32_t val)
+{
+    return static_cast<uint8_t>(std::clamp(val, 0, static_cast<int32_t>(UINT8_MAX)));
+}
+
+static inline uint16_t PackRGB565(uint8_t r, uint8_t g, uint8_t b)
+{
+    return static_cast<uint16_t>(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+}
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+static int32_t ConvertRowSimd(const uint8_t *y, const uint8_t *u, const uint8_t *v,
+    uint8_t *dst, int32_t width, PixelFormat format)
+{
+    static constexpr int32_t lanes = 8;
+    const int16x8_t yOffset = vdupq_n_s16(Y_OFFSET);
+    const int16x8_t uvOffset = vdupq_n_s16(UV_OFFSET);
+    int32_t x = 0;
+    for (; x + lanes <= width; x += lanes) {
+        int16x8_t c = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(y + x))), yOffset);
+        int16x8_t d = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(u + x))), uvOffset);
+        int16x8_t e = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(v + x))), uvOffset);
+
+        int16x8_t yy = vmulq_n_s16(c, COEF_Y);
+        int16x8_t r = vqaddq_s16(yy, vmulq_n_s16(e, COEF_RV));
+        int16x8_t g = vqsubq_s16(vqsubq_s16(yy, vmulq_n_s16(d, COEF_GU)), vmulq_n_s16(e, COEF_GV));
+        int16x8_t b = vqaddq_s16(yy, vmulq_n_s16(d, COEF_BU));
+
+        uint8x8_t r8 = vqrshrun_n_s16(r, COEF_SHIFT);
+        uint8x8_t g8 = vqrshrun_n_s16(g, COEF_SHIFT);
+        uint8x8_t b8 = vqrshrun_n_s16(b, COEF_SHIFT);
+
+        if (format == PixelFormat::RGBA_8888) {
+            uint8x8x4_t rgba = { { r8, g8, b8, vdup_n_u8(ALPHA_OPAQUE) } };
+            vst4_u8(dst + x * sizeof(uint32_t), rgba);
+        } else {
+            uint16x8_t px = vshlq_n_u16(vmovl_u8(vshr_n_u8(r8, 3)), 11);
+            px = vorrq_u16(px, vshlq_n_u16(vmovl_u8(vshr_n_u8(g8, 2)), 5));
+            px = vorrq_u16(px, vmovl_u8(vshr_n_u8(b8, 3)));
+            vst1q_u8(dst + x * sizeof(uint16_t), vreinterpretq_u8_u16(px));
+        }
+    }
+    return x;
+}
+#elif defined(__SSE2__)
+static int32_t ConvertRowSimd(const uint8_t *y, const uint8_t *u, const uint8_t *v,
+    uint8_t *dst, int32_t width, PixelFormat format)
+{
+    static constexpr int32_t lanes = 8;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i yOffset = _mm_set1_epi16(Y_OFFSET);
+    const __m128i uvOffset = _mm_set1_epi16(UV_OFFSET);
+    const __m128i round = _mm_set1_epi16(COEF_ROUND);
+    int32_t x = 0;
+    for (; x + lanes <= width; x += lanes) {
+        __m128i c = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(y + x)), zero);
+        __m128i d = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(u + x)), zero);
+        __m128i e = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(v + x)), zero);
+        c = _mm_sub_epi16(c, yOffset);
+        d = _mm_sub_epi16(d, uvOffset);
+        e = _mm_sub_epi16(e, uvOffset);
+
+        __m128i yy = _mm_mullo_epi16(c, _mm_set1_epi16(COEF_Y));
+        __m128i r = _mm_adds_epi16(yy, _mm_mullo_epi16(e, _mm_set1_epi16(COEF_RV)));
+        __m128i g = _mm_subs_epi16(_mm_subs_epi16(yy, _mm_mullo_epi16(d, _mm_set1_epi16(COEF_GU))),
+            _mm_mullo_epi16(e, _mm_set1_epi16(COEF_GV)));
+        __m128i b = _mm_adds_epi16(yy, _mm_mullo_epi16(d, _mm_set1_epi16(COEF_BU)));
+
+        r = _mm_srai_epi16(_mm_adds_epi16(r, round), COEF_SHIFT);
+        g = _mm_srai_epi16(_mm_adds_epi16(g, round), COEF_SHIFT);
+        b = _mm_srai_epi16(_mm_adds_epi16(b, round), COEF_SHIFT);
+
+        // saturate to 0 ~ 255, the 8 pixels stay in the low half
+        __m128i r8 = _mm_packus_epi16(r, zero);
+        __m128i g8 = _mm_packus_epi16(g, zero);
+        __m128i b8 = _mm_packus_epi16(b, zero);
+
+        if (format == PixelFormat::RGBA_8888) {
+            __m128i rg = _mm_unpacklo_epi8(r8, g8);
+            __m128i ba = _mm_unpacklo_epi8(b8, _mm_set1_epi8(static_cast<char>(ALPHA_OPAQUE)));
+            __m128i *out = reinterpret_cast<__m128i *>(dst + x * sizeof(uint32_t));
+            _mm_storeu_si128(out, _mm_unpacklo_epi16(rg, ba));
+            _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(rg, ba));
+        } else {
+            __m128i px = _mm_slli_epi16(_mm_srli_epi16(_mm_unpacklo_epi8(r8, zero), 3), 11);
+            px = _mm_or_si128(px, _mm_slli_epi16(_mm_srli_epi16(_mm_unpacklo_epi8(g8, zero), 2), 5));
+            px = _mm_or_si128(px, _mm_srli_epi16(_mm_unpacklo_epi8(b8, zero), 3));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x * sizeof(uint16_t)), px);
+        }
+    }
+    return x;
+}
+#else
+static int32_t ConvertRowSimd(const uint8_t *y, const uint8_t *u, const uint8_t *v,
+    uint8_t *dst, int32_t width, PixelFormat format)
+{
+    (void)y;
+    (void)u;
+    (void)v;
+    (void)dst;
+    (void)width;
+    (void)format;
+    return 0;
+}
+#endif
+
+// The results are bit exact with the simd version, the saturation there only happens when
+// the value will be clamped to 255 anyway.
+static void ConvertRow(const uint8_t *y, const uint8_t *u, const uint8_t *v,
+    uint8_t *dst, int32_t width, PixelFormat format)
+{
+    int32_t x = ConvertRowSimd(y, u, v, dst, width, format);
+    for (; x < width; ++x) {
+        int32_t yy = (static_cast<int32_t>(y[x]) - Y_OFFSET) * COEF_Y;
+        int32_t d = static_cast<int32_t>(u[x]) - UV_OFFSET;
+        int32_t e = static_cast<int32_t>(v[x]) - UV_OFFSET;
+
+        uint8_t r = ClampToU8((yy + COEF_RV * e + COEF_ROUND) >> COEF_SHIFT);
+        uint8_t g = ClampToU8((yy - COEF_GU * d - COEF_GV * e + COEF_ROUND) >> COEF_SHIFT);
+        uint8_t b = ClampToU8((yy + COEF_BU * d + COEF_ROUND) >> COEF_SHIFT);
+
+        if (format == PixelFormat::RGBA_8888) {
+            uint8_t *px = dst + x * sizeof(uint32_t);
+            px[0] = r;
+            px[1] = g;
+            px[2] = b;
+            px[3] = ALPHA_OPAQUE;
+        } else {
+            reinterpret_cast<uint16_t *>(dst)[x] = PackRGB565(r, g, b);
+        }
+    }
+}
+
+AVMetaYuvScaler::AVMetaYuvScaler()
+{
+    MEDIA_LOGD("enter ctor, instance: 0x%{public}06" PRIXPTR "", FAKE_POINTER(this));
+}
+
+AVMetaYuvScaler::~AVMetaYuvScaler()
+{
+    MEDIA_LOGD("enter dtor, instance: 0x%{public}06" PRIXPTR "", FAKE_POINTER(this));
+}
+
+bool AVMetaYuvScaler::IsSupported(const GstVideoInfo &inInfo, const OutputConfiguration &outConfig)
+{
+    GstVideoFormat format = GST_VIDEO_INFO_FORMAT(&inInfo);
+    if (format != GST_VIDEO_FORMAT_NV12 && format != GST_VIDEO_FORMAT_NV21 && format != GST_VIDEO_FORMAT_I420) {
+        return false;
+    }
+
+    if (GST_VIDEO_INFO_IS_INTERLACED(&inInfo)) {
+        return false;
+    }
+
+    return outConfig.colorFormat == PixelFormat::RGB_565 || outConfig.colorFormat == PixelFormat::RGBA_8888;
+}
+
+std::shared_ptr<AVSharedMemory> AVMetaYuvScaler::Convert(
+    const OutputConfiguration &outConfig, GstCaps &inCaps, GstBuffer &inBuf)
+{
+    GstVideoInfo inInfo;
+    CHECK_AND_RETURN_RET_LOG(gst_video_info_from_caps(&inInfo, &inCaps), nullptr, "parse caps failed");
+    CHECK_AND_RETURN_RET(IsSupported(inInfo, outConfig), nullptr);
+    CHECK_AND_RETURN_RET(GST_VIDEO_INFO_WIDTH(&inInfo) > 0 && GST_VIDEO_INFO_HEIGHT(&inInfo) > 0, nullptr);
+
+    GstVideoFrame inFrame;
+    gboolean ret = gst_video_frame_map(&inFrame, &inInfo, &inBuf, GST_MAP_READ);
+    CHECK_AND_RETURN_RET_LOG(ret, nullptr, "map input frame failed");
+    ON_SCOPE_EXIT(0) { gst_video_frame_unmap(&inFrame); };
+
+    int32_t dstWidth = 0;
+    int32_t dstHeight = 0;
+    CHECK_AND_RETURN_RET_LOG(GetOutputSize(inInfo, outConfig, dstWidth, dstHeight), nullptr,
+        "invalid output size, width = %{public}d, height = %{public}d", outConfig.dstWidth, outConfig.dstHeight);
+
+    int32_t bytesPerPixel = (outConfig.colorFormat == PixelFormat::RGBA_8888) ?
+        static_cast<int32_t>(sizeof(uint32_t)) : static_cast<int32_t>(sizeof(uint16_t));
+    int32_t dstStride = dstWidth * bytesPerPixel;
+    int64_t memSize = static_cast<int64_t>(sizeof(OutputFrame)) + static_cast<int64_t>(dstStride) * dstHeight;
+    CHECK_AND_RETURN_RET_LOG(memSize <= INT32_MAX, nullptr, "the output frame is too large");
+    auto result = AVSharedMemoryBase::CreateFromLocal(static_cast<int32_t>(memSize),
+        AVSharedMemory::FLAGS_READ_WRITE, "frame");
+    CHECK_AND_RETURN_RET_LOG(result != nullptr, nullptr, "create frame memory failed");
+
+    auto frame = reinterpret_cast<OutputFrame *>(result->GetBase());
+    frame->bytesPerPixel_ = bytesPerPixel;
+    frame->width_ = dstWidth;
+    frame->height_ = dstHeight;
+    frame->stride_ = dstStride;
+    frame->size_ = dstStride * dstHeight;
+
+    PrepareTables(inInfo, dstWidth, dstHeight);
+
+    GstVideoFormat format = GST_VIDEO_INFO_FORMAT(&inInfo);
+    PlaneDesc yPlane = { static_cast<const uint8_t *>(GST_VIDEO_FRAME_PLANE_DATA(&inFrame, 0)),
+        GST_VIDEO_FRAME_PLANE_STRIDE(&inFrame, 0), 1 };
+    PlaneDesc uPlane {};
+    PlaneDesc vPlane {};
+    if (format == GST_VIDEO_FORMAT_I420) {
+        uPlane = { static_cast<const uint8_t *>(GST_VIDEO_FRAME_PLANE_DATA(&inFrame, 1)),
+            GST_VIDEO_FRAME_PLANE_STRIDE(&inFrame, 1), 1 };
+        vPlane = { static_cast<const uint8_t *>(GST_VIDEO_FRAME_PLANE_DATA(&inFrame, 2)),
+            GST_VIDEO_FRAME_PLANE_STRIDE(&inFrame, 2), 1 };
+    } else {
+        // the chroma of NV12 is stored as UVUV..., and NV21 is VUVU...
+        const uint8_t *uvData = static_cast<const uint8_t *>(GST_VIDEO_FRAME_PLANE_DATA(&inFrame, 1));
+        int32_t uvStride = GST_VIDEO_FRAME_PLANE_STRIDE(&inFrame, 1);
+        bool isNV12 = (format == GST_VIDEO_FORMAT_NV12);
+        uPlane = { isNV12 ? uvData : uvData + 1, uvStride, 2 };
+        vPlane = { isNV12 ? uvData + 1 : uvData, uvStride, 2 };
+    }
+
+    uint8_t *dstRow = frame->GetFlattenedData();
+    for (int32_t row = 0; row < dstHeight; ++row) {
+        ScaleRow(yPlane, lumaRows_[row], lumaCols_, yRow_.data());
+        ScaleRow(uPlane, chromaRows_[row], chromaCols_, uRow_.data());
+        ScaleRow(vPlane, chromaRows_[row], chromaCols_, vRow_.data());
+        ConvertRow(yRow_.data(), uRow_.data(), vRow_.data(), dstRow, dstWidth, outConfig.colorFormat);
+        dstRow += dstStride;
+    }
+
+    MEDIA_LOGI("yuv scaler output width = %{public}d, height = %{public}d, format = %{public}d",
+        dstWidth, dstHeight, outConfig.colorFormat);
+    return result;
+}
+
+bool AVMetaYuvScaler::GetOutputSize(const GstVideoInfo &inInfo, const OutputConfiguration &outConfig,
+    int32_t &dstWidth, int32_t &dstHeight)
+{
+    int64_t srcWidth = GST_VIDEO_INFO_WIDTH(&inInfo);
+    int64_t srcHeight = GST_VIDEO_INFO_HEIGHT(&inInfo);
+    int64_t width = outConfig.dstWidth;
+    int64_t height = outConfig.dstHeight;
+
+    // keep the aspect ratio when only one side is specified, as what the videoscale does.
+    if (width == KEEP_ORIGINAL_WIDTH_OR_HEIGHT && height == KEEP_ORIGINAL_WIDTH_OR_HEIGHT) {
+        width = srcWidth;
+        height = srcHeight;
+    } else if (width == KEEP_ORIGINAL_WIDTH_OR_HEIGHT) {
+        width = (srcWidth * height + srcHeight / 2) / srcHeight;
+    } else if (height == KEEP_ORIGINAL_WIDTH_OR_HEIGHT) {
+        height = (srcHeight * width + srcWidth / 2) / srcWidth;
+    }
+
+    // the derived side of a very narrow or wide source may be out of the limits, let the pipeline handle it.
+    if (width <= 0 || height <= 0 || width > MAX_DST_WIDTH || height > MAX_DST_HEIGHT) {
+        return false;
+    }
+    dstWidth = static_cast<int32_t>(width);
+    dstHeight = static_cast<int32_t>(height);
+    return true;
+}
+
+void AVMetaYuvScaler::BuildScaleTable(int32_t srcLen, int32_t dstLen, std::vector<ScaleTap> &table)
+{
+    table.resize(static_cast<size_t>(dstLen));
+
+    // map the center of the output samples to the input, in 16.16 fixed point
+    int64_t step = (static_cast<int64_t>(srcLen) << FIXED_POINT_SHIFT) / dstLen;
+    int64_t pos = step / 2 - (1 << (FIXED_POINT_SHIFT - 1));
+    for (int32_t i = 0; i < dstLen; ++i, pos += step) {
+        int64_t clamped = std::max<int64_t>(pos, 0);
+        int32_t index0 = std::min(static_cast<int32_t>(clamped >> FIXED_POINT_SHIFT), srcLen - 1);
+        table[i].index0 = index0;
+        table[i].index1 = std::min(index0 + 1, srcLen - 1);
+        table[i].frac = static_cast<int32_t>((clamped >> (FIXED_POINT_SHIFT - FRAC_BITS)) & (FRAC_ONE - 1));
+    }
+}
+
+void AVMetaYuvScaler::PrepareTables(const GstVideoInfo &inInfo, int32_t dstWidth, int32_t dstHeight)
+{
+    int32_t srcWidth = GST_VIDEO_INFO_WIDTH(&inInfo);
+    int32_t srcHeight = GST_VIDEO_INFO_HEIGHT(&inInfo);
+    if (srcWidth == srcWidth_ && srcHeight == srcHeight_ && dstWidth == dstWidth_ && dstHeight == dstHeight_) {
+        return;
+    }
+
+    BuildScaleTable(srcWidth, dstWidth, lumaCols_);
+    BuildScaleTable(srcHeight, dstHeight, lumaRows_);
+    BuildScaleTable((srcWidth + 1) / 2, dstWidth, chromaCols_);
+    BuildScaleTable((srcHeight + 1) / 2, dstHeight, chromaRows_);
+
+    yRow_.resize(static_cast<size_t>(dstWidth));
+    uRow_.resize(static_cast<size_t>(dstWidth));
+    vRow_.resize(static_cast<size_t>(dstWidth));
+
+    srcWidth_ = srcWidth;
+    srcHeight_ = srcHeight;
+    dstWidth_ = dstWidth;
+    dstHeight_ = dstHeight;
+}
+
+void AVMetaYuvScaler::ScaleRow(const PlaneDesc &plane, const ScaleTap &rowTap,
+    const std::vector<ScaleTap> &colTable, uint8_t *out)
+{
+    const uint8_t *row0 = plane.data + static_cast<ptrdiff_t>(rowTap.index0) * plane.stride;
+    const uint8_t *row1 = plane.data + static_cast<ptrdiff_t>(rowTap.index1) * plane.stride;
+    int32_t fy = rowTap.frac;
+    int32_t ps = plane.pixelStride;
+
+    for (size_t x = 0; x < colTable.size(); ++x) {
+        const ScaleTap &col = colTable[x];
+        int32_t fx = col.frac;
+        int32_t top = row0[col.index0 * ps] * (FRAC_ONE - fx) + row0[col.index1 * ps] * fx;
+        int32_t bottom = row1[col.index0 * ps] * (FRAC_ONE - fx) + row1[col.index1 * ps] * fx;
+        int32_t val = (top * (FRAC_ONE - fy) + bottom * fy + (1 << (FRAC_BITS * 2 - 1))) >> (FRAC_BITS * 2);
+        out[x] = static_cast<uint8_t>(val);
+    }
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AVMETA_YUV_SCALER_H
+#define AVMETA_YUV_SCALER_H
+
+#include <vector>
+#include <gst/gst.h>
+#include <gst/video/video.h>
+#include "i_avmetadatahelper_service.h"
+#include "avsharedmemory.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * Scale and convert the NV12, NV21 or I420 frame to RGB565 or RGBA8888 in one pass, the output
+ * rows are written without padding. Other formats are left to the conversion pipeline.
+ */
+class AVMetaYuvScaler : public NoCopyable {
+public:
+    AVMetaYuvScaler();
+    ~AVMetaYuvScaler();
+
+    static bool IsSupported(const GstVideoInfo &inInfo, const OutputConfiguration &outConfig);
+    std::shared_ptr<AVSharedMemory> Convert(const OutputConfiguration &outConfig, GstCaps &inCaps, GstBuffer &inBuf);
+
+private:
+    struct ScaleTap {
+        int32_t index0;
+        int32_t index1;
+        int32_t frac; // weight of the index1, 0 ~ 256
+    };
+
+    struct PlaneDesc {
+        const uint8_t *data;
+        int32_t stride;
+        int32_t pixelStride;
+    };
+
+    static bool GetOutputSize(const GstVideoInfo &inInfo, const OutputConfiguration &outConfig,
+        int32_t &dstWidth, int32_t &dstHeight);
+    static void BuildScaleTable(int32_t srcLen, int32_t dstLen, std::vector<ScaleTap> &table);
+    static void ScaleRow(const PlaneDesc &plane, const ScaleTap &rowTap,
+        const std::vector<ScaleTap> &colTable, uint8_t *out);
+    void PrepareTables(const GstVideoInfo &inInfo, int32_t dstWidth, int32_t dstHeight);
+
+    int32_t srcWidth_ = 0;
+    int32_t srcHeight_ = 0;
+    int32_t dstWidth_ = 0;
+    int32_t dstHeight_ = 0;
+    std::vector<ScaleTap> lumaCols_;
+    std::vector<ScaleTap> lumaRows_;
+    std::vector<ScaleTap> chromaCols_;
+    std::vector<ScaleTap> chromaRows_;
+    std::vector<uint8_t> yRow_;
+    std::vector<uint8_t> uRow_;
+    std::vector<uint8_t> vRow_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // AVMETA_YUV_SCALER_H
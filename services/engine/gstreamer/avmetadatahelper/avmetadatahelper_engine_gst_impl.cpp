@@ -14,6 +14,7 @@
  */
 
 #include "avmetadatahelper_engine_gst_impl.h"
+#include <algorithm>
 #include <gst/gst.h>
 #include "media_errors.h"
 #include "media_log.h"
@@ -46,9 +47,13 @@ static const std::set<PixelFormat> SUPPORTED_PIXELFORMAT = {
     PixelFormat::RGB_565, PixelFormat::RGB_888, PixelFormat::RGBA_8888
 };
 
-static bool CheckFrameFetchParam(int64_t timeUsOrIndex, int32_t option, const OutputConfiguration &param)
+static bool CheckFrameFetchParam(size_t numFrames, int32_t option, const OutputConfiguration &param)
 {
-    (void)timeUsOrIndex;
+    if (numFrames == 0 || numFrames > static_cast<size_t>(MAX_FETCH_FRAMES_NUM)) {
+        MEDIA_LOGE("Invalid frame number: %{public}zu", numFrames);
+        return false;
+    }
+
     if ((option != AV_META_QUERY_CLOSEST) && (option != AV_META_QUERY_CLOSEST_SYNC) &&
         (option != AV_META_QUERY_NEXT_SYNC) && (option != AV_META_QUERY_PREVIOUS_SYNC)) {
         MEDIA_LOGE("Invalid query option: %{public}d", option);
@@ -168,13 +173,31 @@ std::shared_ptr<AVSharedMemory> AVMetadataHelperEngineGstImpl::FetchFrameAtTime(
     }
 
     std::vector<std::shared_ptr<AVSharedMemory>> outFrames;
-    int32_t ret = FetchFrameInternel(timeUs, option, 1, param, outFrames);
+    int32_t ret = FetchFrameInternel({ timeUs }, option, param, outFrames);
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, nullptr, "fetch frame failed");
 
     MEDIA_LOGD("exit");
     return outFrames[0];
 }
 
+std::vector<std::shared_ptr<AVSharedMemory>> AVMetadataHelperEngineGstImpl::FetchFramesAtTimes(
+    const std::vector<int64_t> &timesUs, int32_t option, const OutputConfiguration &param)
+{
+    MEDIA_LOGD("enter");
+
+    if (usage_ != AVMetadataUsage::AV_META_USAGE_PIXEL_MAP) {
+        MEDIA_LOGE("current instance is unavailable for fetch frame, check usage !");
+        return {};
+    }
+
+    std::vector<std::shared_ptr<AVSharedMemory>> outFrames;
+    int32_t ret = FetchFrameInternel(timesUs, option, param, outFrames);
+    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, {}, "fetch frames failed");
+
+    MEDIA_LOGD("exit");
+    return outFrames;
+}
+
 int32_t AVMetadataHelperEngineGstImpl::SetSourceInternel(const std::string &uri, int32_t usage)
 {
     Reset();
@@ -251,14 +274,12 @@ int32_t AVMetadataHelperEngineGstImpl::PrepareInternel(bool async)
     return MSERR_OK;
 }
 
-int32_t AVMetadataHelperEngineGstImpl::FetchFrameInternel(int64_t timeUsOrIndex, int32_t option, int32_t numFrames,
+int32_t AVMetadataHelperEngineGstImpl::FetchFrameInternel(const std::vector<int64_t> &timesUs, int32_t option,
     const OutputConfiguration &param, std::vector<std::shared_ptr<AVSharedMemory>> &outFrames)
 {
-    (void)numFrames;
-
     AUTO_PERF(this, "FetchFrame");
 
-    if (!CheckFrameFetchParam(timeUsOrIndex, option, param)) {
+    if (!CheckFrameFetchParam(timesUs.size(), option, param)) {
         MEDIA_LOGE("fetch frame's param invalid");
         return MSERR_INVALID_OPERATION;
     }
@@ -282,8 +303,9 @@ int32_t AVMetadataHelperEngineGstImpl::FetchFrameInternel(int64_t timeUsOrIndex,
     ret = PrepareInternel(false);
     CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
 
-    auto frame = frameExtractor_->ExtractFrame(timeUsOrIndex, option, param);
-    if (frame == nullptr) {
+    auto frames = frameExtractor_->ExtractFrames(timesUs, option, param);
+    auto isFetched = [](const std::shared_ptr<AVSharedMemory> &frame) { return frame != nullptr; };
+    if (std::none_of(frames.begin(), frames.end(), isFetched)) {
         MEDIA_LOGE("fetch frame failed");
         return MSERR_UNKNOWN;
     }
@@ -293,7 +315,7 @@ int32_t AVMetadataHelperEngineGstImpl::FetchFrameInternel(int64_t timeUsOrIndex,
         firstFetch_ = false;
     }
 
-    outFrames.push_back(frame);
+    outFrames.swap(frames);
     return MSERR_OK;
 }
 
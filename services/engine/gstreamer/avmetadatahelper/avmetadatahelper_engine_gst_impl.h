@@ -38,6 +38,8 @@ public:
     std::unordered_map<int32_t, std::string> ResolveMetadata() override;
     std::shared_ptr<AVSharedMemory> FetchFrameAtTime(
         int64_t timeUs, int32_t option, const OutputConfiguration &param) override;
+    std::vector<std::shared_ptr<AVSharedMemory>> FetchFramesAtTimes(
+        const std::vector<int64_t> &timesUs, int32_t option, const OutputConfiguration &param) override;
     std::shared_ptr<AVSharedMemory> FetchArtPicture() override;
 
 private:
@@ -45,7 +47,7 @@ private:
     int32_t SetSourceInternel(const std::string &uri, int32_t usage);
     int32_t InitConverter(const OutputConfiguration &config);
     int32_t PrepareInternel(bool async);
-    int32_t FetchFrameInternel(int64_t timeUsOrIndex, int32_t option, int32_t numFrames,
+    int32_t FetchFrameInternel(const std::vector<int64_t> &timesUs, int32_t option,
         const OutputConfiguration &param, std::vector<std::shared_ptr<AVSharedMemory>> &outFrames);
     int32_t ExtractMetadata();
     void OnNotifyElemSetup(GstElement &elem);
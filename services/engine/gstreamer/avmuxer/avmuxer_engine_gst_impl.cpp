@@ -14,10 +14,13 @@
  */
 
 #include "avmuxer_engine_gst_impl.h"
+#include <algorithm>
+#include <chrono>
 #include <unistd.h>
 #include "gst_utils.h"
 #include "media_errors.h"
 #include "media_log.h"
+#include "param_wrapper.h"
 #include "uri_helper.h"
 
 namespace {
@@ -33,48 +36,113 @@ namespace {
     constexpr uint32_t MAX_VIDEO_TRACK_NUM = 1;
     constexpr uint32_t MAX_AUDIO_TRACK_NUM = 16;
     constexpr uint32_t US_TO_NS = 1000;
+    constexpr int32_t DEFAULT_WRITE_TIMEOUT_MS = 0;
+    constexpr int32_t MAX_WRITE_TIMEOUT_MS = 5000;
+    constexpr guint64 MAX_VIDEO_QUEUE_BYTES = 8 * 1024 * 1024;
+    constexpr guint64 MAX_AUDIO_QUEUE_BYTES = 512 * 1024;
 }
 
 namespace OHOS {
 namespace Media {
-static void StartFeed(GstElement *src, guint length, gpointer userData)
+AVMuxerEngineGstImpl::AVMuxerEngineGstImpl()
+{
+    MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances create", FAKE_POINTER(this));
+}
+
+AVMuxerEngineGstImpl::~AVMuxerEngineGstImpl()
+{
+    MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances destroy", FAKE_POINTER(this));
+    if (muxBin_ != nullptr) {
+        gst_object_unref(muxBin_);
+        muxBin_ = nullptr;
+    }
+}
+
+void AVMuxerEngineGstImpl::StartFeed(GstElement *src, guint length, gpointer userData)
 {
     (void)length;
     CHECK_AND_RETURN_LOG(src != nullptr, "AppSrc does not exist");
     CHECK_AND_RETURN_LOG(userData != nullptr, "User data does not exist");
-    std::map<int32_t, TrackInfo> trackInfo = *reinterpret_cast<std::map<int32_t, TrackInfo> *>(userData);
-    for (auto& info : trackInfo) {
-        if (info.second.src_ == src) {
-            info.second.needData_ = true;
-            break;
-        }
-    }
+    static_cast<AVMuxerEngineGstImpl *>(userData)->OnFeedChanged(src, true);
 }
 
-static void StopFeed(GstElement *src, gpointer userData)
+void AVMuxerEngineGstImpl::StopFeed(GstElement *src, gpointer userData)
 {
     CHECK_AND_RETURN_LOG(src != nullptr, "AppSrc does not exist");
     CHECK_AND_RETURN_LOG(userData != nullptr, "User data does not exist");
-    std::map<int32_t, TrackInfo> trackInfo = *reinterpret_cast<std::map<int32_t, TrackInfo> *>(userData);
-    for (auto& info : trackInfo) {
+    static_cast<AVMuxerEngineGstImpl *>(userData)->OnFeedChanged(src, false);
+}
+
+void AVMuxerEngineGstImpl::OnFeedChanged(const GstElement *src, bool needData)
+{
+    // the signals may be emitted inside the push-buffer with the mutex_ held, so the mutex_ is not
+    // acquired here. The tracks are not changed until the pipeline is stopped.
+    for (auto &info : trackInfo_) {
         if (info.second.src_ == src) {
-            info.second.needData_ = false;
+            info.second.needData_ = needData;
             break;
         }
     }
+    if (needData) {
+        NotifyFeed();
+    }
 }
 
-AVMuxerEngineGstImpl::AVMuxerEngineGstImpl()
+void AVMuxerEngineGstImpl::NotifyFeed()
 {
-    MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances create", FAKE_POINTER(this));
+    std::unique_lock<std::mutex> feedLock(feedMutex_);
+    feedSeq_++;
+    feedCond_.notify_all();
 }
 
-AVMuxerEngineGstImpl::~AVMuxerEngineGstImpl()
+bool AVMuxerEngineGstImpl::IsLaggingTrackLocked(int32_t trackId, int64_t timeUs)
 {
-    MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances destroy", FAKE_POINTER(this));
-    if (muxBin_ != nullptr) {
-        gst_object_unref(muxBin_);
-        muxBin_ = nullptr;
+    // the muxer can not go on without the samples of the track which falls behind all the others,
+    // so it is never throttled, otherwise one fast track may starve the others.
+    bool hasOtherTrack = false;
+    for (auto &info : trackInfo_) {
+        if (info.first == trackId) {
+            continue;
+        }
+        if (info.second.lastTimeUs_ < timeUs) {
+            return false;
+        }
+        hasOtherTrack = true;
+    }
+    return hasOtherTrack;
+}
+
+int32_t AVMuxerEngineGstImpl::WaitFeedLocked(std::unique_lock<std::mutex> &lock, int32_t trackId, int64_t timeUs)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(writeTimeoutMs_);
+    while (true) {
+        uint64_t feedSeq = 0;
+        {
+            std::unique_lock<std::mutex> feedLock(feedMutex_);
+            CHECK_AND_RETURN_RET_LOG(!feedStopped_, MSERR_INVALID_OPERATION, "Muxer is stopping");
+            feedSeq = feedSeq_;
+        }
+        CHECK_AND_RETURN_RET_LOG(errHappened_ != true, MSERR_INVALID_OPERATION, "Error happend");
+        auto iter = trackInfo_.find(trackId);
+        CHECK_AND_RETURN_RET_LOG(iter != trackInfo_.end() && iter->second.src_ != nullptr, MSERR_INVALID_VAL,
+            "Failed to get AppSrc, trackId: %{public}d", trackId);
+        if (iter->second.needData_ || IsLaggingTrackLocked(trackId, timeUs)) {
+            return MSERR_OK;
+        }
+        CHECK_AND_RETURN_RET_LOG(writeTimeoutMs_ > 0, MSERR_INVALID_OPERATION,
+            "Failed to push data, the queue is full, trackId: %{public}d", trackId);
+
+        lock.unlock();
+        bool fed = false;
+        {
+            std::unique_lock<std::mutex> feedLock(feedMutex_);
+            fed = feedCond_.wait_until(feedLock, deadline, [this, feedSeq]() {
+                return feedSeq_ != feedSeq || feedStopped_ || errHappened_;
+            });
+        }
+        lock.lock();
+        CHECK_AND_RETURN_RET_LOG(fed, MSERR_INVALID_OPERATION,
+            "Failed to push data, the queue is full, trackId: %{public}d", trackId);
     }
 }
 
@@ -90,6 +158,11 @@ int32_t AVMuxerEngineGstImpl::Init()
     allocator_ = gst_shmem_wrap_allocator_new();
     CHECK_AND_RETURN_RET_LOG(allocator_ != nullptr, MSERR_NO_MEMORY, "Failed to create allocator");
 
+    // the WriteTrackSample fails immediately for a full track by default, the callers that set the
+    // sys.media.avmuxer.write.timeout wait at most that long instead.
+    int32_t timeoutMs = OHOS::system::GetIntParameter("sys.media.avmuxer.write.timeout", DEFAULT_WRITE_TIMEOUT_MS);
+    writeTimeoutMs_ = std::clamp(timeoutMs, 0, MAX_WRITE_TIMEOUT_MS);
+
     return MSERR_OK;
 }
 
@@ -169,7 +242,6 @@ int32_t AVMuxerEngineGstImpl::AddTrack(const MediaDescription &trackDesc, int32_
         MSERR_INVALID_OPERATION, "The mime type can not be added in current container format");
 
     trackId = trackInfo_.size() + 1;
-    trackInfo_[trackId] = TrackInfo();
     trackInfo_[trackId].mimeType_ = mimeType;
     trackInfo_[trackId].needData_ = true;
 
@@ -190,6 +262,7 @@ int32_t AVMuxerEngineGstImpl::AddTrack(const MediaDescription &trackDesc, int32_
         MEDIA_LOGE("Failed to check track type");
         return MSERR_INVALID_VAL;
     }
+    trackInfo_[trackId].mediaType_ = mediaType;
 
     int32_t ret = AVMuxerUtil::SetCaps(trackDesc, mimeType, &srcCaps);
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "Failed to call SetCaps");
@@ -215,6 +288,10 @@ int32_t AVMuxerEngineGstImpl::Start()
     MEDIA_LOGD("Start");
     std::unique_lock<std::mutex> lock(mutex_);
     CHECK_AND_RETURN_RET_LOG(muxBin_ != nullptr, MSERR_INVALID_OPERATION, "Muxbin does not exist");
+    {
+        std::unique_lock<std::mutex> feedLock(feedMutex_);
+        feedStopped_ = false;
+    }
     gst_element_set_state(GST_ELEMENT_CAST(muxBin_), GST_STATE_PLAYING);
 
     for (auto& info : trackInfo_) {
@@ -222,8 +299,10 @@ int32_t AVMuxerEngineGstImpl::Start()
         name += static_cast<char>('0' + info.first);
         GstElement *src = gst_bin_get_by_name(GST_BIN_CAST(muxBin_), name.c_str());
         CHECK_AND_RETURN_RET_LOG(src != nullptr, MSERR_INVALID_OPERATION, "src does not exist");
-        g_signal_connect(src, "need-data", G_CALLBACK(StartFeed), reinterpret_cast<gpointer *>(&trackInfo_));
-        g_signal_connect(src, "enough-data", G_CALLBACK(StopFeed), reinterpret_cast<gpointer *>(&trackInfo_));
+        guint64 maxBytes = info.second.mediaType_ == MEDIA_TYPE_VID ? MAX_VIDEO_QUEUE_BYTES : MAX_AUDIO_QUEUE_BYTES;
+        g_object_set(src, "max-bytes", maxBytes, nullptr);
+        g_signal_connect(src, "need-data", G_CALLBACK(StartFeed), this);
+        g_signal_connect(src, "enough-data", G_CALLBACK(StopFeed), this);
         info.second.src_ = src;
     }
 
@@ -258,29 +337,28 @@ int32_t AVMuxerEngineGstImpl::WriteTrackSample(std::shared_ptr<AVSharedMemory> s
 {
     MEDIA_LOGD("WriteTrackSample, sampleInfo.trackIdx is %{public}d", sampleInfo.trackIdx);
     std::unique_lock<std::mutex> lock(mutex_);
-    CHECK_AND_RETURN_RET_LOG(errHappened_ != true, MSERR_INVALID_OPERATION, "Error happend");
     CHECK_AND_RETURN_RET_LOG(muxBin_ != nullptr, MSERR_INVALID_OPERATION, "Muxbin does not exist");
     CHECK_AND_RETURN_RET_LOG(sampleData != nullptr, MSERR_INVALID_VAL, "sampleData is nullptr");
-    CHECK_AND_RETURN_RET_LOG(trackInfo_[sampleInfo.trackIdx].needData_ == true, MSERR_INVALID_OPERATION,
-        "Failed to push data, the queue is full");
     CHECK_AND_RETURN_RET_LOG(sampleInfo.timeUs >= 0, MSERR_INVALID_VAL, "Failed to check dts, dts muxt >= 0");
-    
-    int32_t ret;
-    GstElement *src = trackInfo_[sampleInfo.trackIdx].src_;
-    CHECK_AND_RETURN_RET_LOG(src != nullptr, MSERR_INVALID_VAL, "Failed to get AppSrc");
-
-    if ((sampleInfo.flags & AVCODEC_BUFFER_FLAG_CODEC_DATA) &&
-        trackInfo_[sampleInfo.trackIdx].hasCodecData_ != true) {
-        CHECK_AND_RETURN_RET_LOG(trackInfo_[sampleInfo.trackIdx].caps_ != nullptr,
-            MSERR_INVALID_OPERATION, "Failed to check caps");
-        g_object_set(src, "caps", trackInfo_[sampleInfo.trackIdx].caps_, nullptr);
+
+    int32_t ret = WaitFeedLocked(lock, sampleInfo.trackIdx, sampleInfo.timeUs);
+    CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
+    TrackInfo &track = trackInfo_[sampleInfo.trackIdx];
+    GstElement *src = track.src_;
+
+    if ((sampleInfo.flags & AVCODEC_BUFFER_FLAG_CODEC_DATA) && track.hasCodecData_ != true) {
+        CHECK_AND_RETURN_RET_LOG(track.caps_ != nullptr, MSERR_INVALID_OPERATION, "Failed to check caps");
+        g_object_set(src, "caps", track.caps_, nullptr);
         ret = WriteData(sampleData, sampleInfo, src);
         CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "Failed to call WriteData");
-        trackInfo_[sampleInfo.trackIdx].hasCodecData_ = true;
+        track.hasCodecData_ = true;
     } else if (!(sampleInfo.flags & AVCODEC_BUFFER_FLAG_CODEC_DATA & AVCODEC_BUFFER_FLAG_EOS) &&
-        trackInfo_[sampleInfo.trackIdx].hasCodecData_ == true) {
+        track.hasCodecData_ == true) {
         ret = WriteData(sampleData, sampleInfo, src);
         CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "Failed to call WriteData");
+        track.lastTimeUs_ = std::max(track.lastTimeUs_, sampleInfo.timeUs);
+        // the tracks throttled for being ahead of this one may go on now
+        NotifyFeed();
     } else {
         MEDIA_LOGW("Failed to Write sample, note: first frame must be code_data");
     }
@@ -291,6 +369,12 @@ int32_t AVMuxerEngineGstImpl::WriteTrackSample(std::shared_ptr<AVSharedMemory> s
 int32_t AVMuxerEngineGstImpl::Stop()
 {
     MEDIA_LOGD("Stop");
+    {
+        // wake up the writers waiting for the full tracks
+        std::unique_lock<std::mutex> feedLock(feedMutex_);
+        feedStopped_ = true;
+        feedCond_.notify_all();
+    }
     std::unique_lock<std::mutex> lock(mutex_);
     CHECK_AND_RETURN_RET_LOG(muxBin_ != nullptr, MSERR_INVALID_OPERATION, "Muxbin does not exist");
 
@@ -345,6 +429,8 @@ void AVMuxerEngineGstImpl::OnNotifyMessage(const InnerMessage &msg)
             msgProcessor_->Reset();
             errHappened_ = true;
             cond_.notify_all();
+            // the writers waiting for the full tracks return the error instead of timing out
+            NotifyFeed();
             break;
         }
         case InnerMsgType::INNER_MSG_STATE_CHANGED: {
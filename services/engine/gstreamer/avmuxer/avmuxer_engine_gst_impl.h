@@ -16,9 +16,11 @@
 #ifndef AVMUXER_ENGINE_GST_IMPL_H
 #define AVMUXER_ENGINE_GST_IMPL_H
 
+#include <atomic>
 #include <set>
 #include <map>
 #include <tuple>
+#include <condition_variable>
 #include "nocopyable.h"
 #include "i_avmuxer_engine.h"
 #include "gst_msg_processor.h"
@@ -42,6 +44,12 @@ public:
     int32_t WriteTrackSample(std::shared_ptr<AVSharedMemory> sampleData, const TrackSampleInfo &sampleInfo) override;
     int32_t Stop() override;
 private:
+    static void StartFeed(GstElement *src, guint length, gpointer userData);
+    static void StopFeed(GstElement *src, gpointer userData);
+    void OnFeedChanged(const GstElement *src, bool needData);
+    void NotifyFeed();
+    bool IsLaggingTrackLocked(int32_t trackId, int64_t timeUs);
+    int32_t WaitFeedLocked(std::unique_lock<std::mutex> &lock, int32_t trackId, int64_t timeUs);
     void SetParse(const std::string &mimeType);
     int32_t WriteData(std::shared_ptr<AVSharedMemory> sampleData, const TrackSampleInfo &sampleInfo, GstElement *src);
     int32_t SetupMsgProcessor();
@@ -53,7 +61,8 @@ private:
     std::mutex mutex_;
     std::condition_variable cond_;
     bool endFlag_ = false;
-    bool errHappened_ = false;
+    // also read by the writers waiting on the feedCond_ without the mutex_
+    std::atomic<bool> errHappened_ = false;
     std::unique_ptr<GstMsgProcessor> msgProcessor_;
     uint32_t videoTrackNum_ = 0;
     uint32_t audioTrackNum_ = 0;
@@ -62,6 +71,14 @@ private:
     bool isPause_ = false;
     bool isPlay_ = false;
     GstShMemWrapAllocator *allocator_;
+
+    // the writer of a full track waits here without the mutex_, the feedSeq_ is increased whenever
+    // a track is fed or its appsrc asks for more data.
+    std::mutex feedMutex_;
+    std::condition_variable feedCond_;
+    uint64_t feedSeq_ = 0;
+    bool feedStopped_ = false;
+    int32_t writeTimeoutMs_ = 0;
 };
 }  // namespace Media
 }  // namespace OHOS
@@ -16,6 +16,7 @@
 #ifndef AVMUXER_UTIL_H
 #define AVMUXER_UTIL_H
 
+#include <atomic>
 #include <functional>
 #include <set>
 #include <map>
@@ -30,7 +31,10 @@ namespace OHOS {
 namespace Media {
 struct TrackInfo {
     bool hasCodecData_ = false;
-    bool needData_ = false;
+    // updated by the need-data and enough-data signals of the appsrc from the streaming thread
+    std::atomic<bool> needData_ = false;
+    int64_t lastTimeUs_ = -1;
+    MediaType mediaType_ = MEDIA_TYPE_AUD;
     GstCaps *caps_ = nullptr;
     GstElement *src_ = nullptr;
     std::string mimeType_;
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gst_msg_dispatcher.h"
+#include <algorithm>
+#include <condition_variable>
+#include <string>
+#include <thread>
+#include "media_errors.h"
+#include "media_log.h"
+#include "param_wrapper.h"
+
+namespace {
+    constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "GstMsgDispatcher"};
+    constexpr uint32_t MAX_LOOP_NUM = 8;
+}
+
+namespace OHOS {
+namespace Media {
+struct DispatchDoneWaiter {
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool done = false;
+};
+
+GstMsgDispatcher &GstMsgDispatcher::GetInstance()
+{
+    static GstMsgDispatcher instance;
+    return instance;
+}
+
+GstMsgDispatcher::GstMsgDispatcher()
+{
+    uint32_t loopNum = std::thread::hardware_concurrency();
+    int32_t value = OHOS::system::GetIntParameter("sys.media.gst.msg.loop.num", 0);
+    if (value > 0) {
+        loopNum = static_cast<uint32_t>(value);
+    }
+    maxLoopNum_ = std::clamp(loopNum, 1U, MAX_LOOP_NUM);
+    MEDIA_LOGI("max msg loop num: %{public}u", maxLoopNum_);
+}
+
+GstMsgDispatcher::~GstMsgDispatcher()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (auto &loop : loops_) {
+        StopLoop(*loop);
+    }
+    loops_.clear();
+}
+
+std::unique_ptr<GstMsgDispatcher::Loop> GstMsgDispatcher::StartLoop(uint32_t index)
+{
+    auto loop = std::make_unique<Loop>();
+    loop->thread = std::make_unique<TaskQueue>("gst_msg_loop" + std::to_string(index));
+    loop->context = g_main_context_new();
+    CHECK_AND_RETURN_RET(loop->context != nullptr, nullptr);
+    loop->mainLoop = g_main_loop_new(loop->context, FALSE);
+    if (loop->mainLoop == nullptr || loop->thread->Start() != MSERR_OK) {
+        StopLoop(*loop);
+        return nullptr;
+    }
+
+    GMainContext *context = loop->context;
+    GMainLoop *mainLoop = loop->mainLoop;
+    auto mainLoopRun = std::make_shared<TaskHandler<void>>([context, mainLoop, index] {
+        MEDIA_LOGI("start msg main loop %{public}u", index);
+        g_main_context_push_thread_default(context);
+        g_main_loop_run(mainLoop);
+        g_main_context_pop_thread_default(context);
+        MEDIA_LOGI("stop msg main loop %{public}u", index);
+    });
+    if (loop->thread->EnqueueTask(mainLoopRun) != MSERR_OK) {
+        StopLoop(*loop);
+        return nullptr;
+    }
+    return loop;
+}
+
+void GstMsgDispatcher::StopLoop(Loop &loop)
+{
+    if (loop.mainLoop != nullptr) {
+        g_main_loop_quit(loop.mainLoop);
+    }
+    if (loop.thread != nullptr) {
+        (void)loop.thread->Stop();
+    }
+    if (loop.mainLoop != nullptr) {
+        g_main_loop_unref(loop.mainLoop);
+        loop.mainLoop = nullptr;
+    }
+    if (loop.context != nullptr) {
+        g_main_context_unref(loop.context);
+        loop.context = nullptr;
+    }
+}
+
+GstMsgDispatcher::Loop *GstMsgDispatcher::GetIdleLoopLocked()
+{
+    Loop *idleLoop = nullptr;
+    for (auto &loop : loops_) {
+        if (idleLoop == nullptr || loop->sourceCount < idleLoop->sourceCount) {
+            idleLoop = loop.get();
+        }
+    }
+    if ((idleLoop == nullptr || idleLoop->sourceCount > 0) && loops_.size() < maxLoopNum_) {
+        auto loop = StartLoop(static_cast<uint32_t>(loops_.size()));
+        if (loop != nullptr) {
+            idleLoop = loop.get();
+            loops_.push_back(std::move(loop));
+        }
+    }
+    return idleLoop;
+}
+
+GMainContext *GstMsgDispatcher::Attach(GSource &source)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    Loop *loop = GetIdleLoopLocked();
+    CHECK_AND_RETURN_RET_LOG(loop != nullptr, nullptr, "no msg loop available");
+
+    guint ret = g_source_attach(&source, loop->context);
+    CHECK_AND_RETURN_RET_LOG(ret > 0, nullptr, "attach source failed");
+    loop->sourceCount++;
+    return loop->context;
+}
+
+void GstMsgDispatcher::Detach(GSource &source, GMainContext &context)
+{
+    g_source_destroy(&source);
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (auto &loop : loops_) {
+            if (loop->context == &context && loop->sourceCount > 0) {
+                loop->sourceCount--;
+                break;
+            }
+        }
+    }
+
+    // at the loop thread, the source is not dispatched again once the current callback returns.
+    if (!g_main_context_is_owner(&context)) {
+        WaitDispatchDone(context);
+    }
+}
+
+void GstMsgDispatcher::WaitDispatchDone(GMainContext &context)
+{
+    // the source may be dispatching when it is destroyed, attach a barrier to the same context
+    // and wait it, which can only be dispatched after the current dispatching is done.
+    auto waiter = std::make_shared<DispatchDoneWaiter>();
+    GSource *barrier = g_idle_source_new();
+    CHECK_AND_RETURN(barrier != nullptr);
+    g_source_set_priority(barrier, G_PRIORITY_HIGH);
+    g_source_set_callback(barrier, [](gpointer userData) -> gboolean {
+        auto doneWaiter = static_cast<std::shared_ptr<DispatchDoneWaiter> *>(userData);
+        std::unique_lock<std::mutex> lock((*doneWaiter)->mutex);
+        (*doneWaiter)->done = true;
+        (*doneWaiter)->cond.notify_all();
+        return G_SOURCE_REMOVE;
+    }, new std::shared_ptr<DispatchDoneWaiter>(waiter), [](gpointer userData) {
+        delete static_cast<std::shared_ptr<DispatchDoneWaiter> *>(userData);
+    });
+    guint ret = g_source_attach(barrier, &context);
+    g_source_unref(barrier);
+    CHECK_AND_RETURN_LOG(ret > 0, "attach barrier source failed");
+
+    std::unique_lock<std::mutex> lock(waiter->mutex);
+    waiter->cond.wait(lock, [&waiter] { return waiter->done; });
+}
+} // namespace Media
+} // namespace OHOS
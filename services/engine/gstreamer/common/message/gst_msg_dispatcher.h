@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GST_MSG_DISPATCHER_H
+#define GST_MSG_DISPATCHER_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <gst/gst.h>
+#include "task_queue.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * Shared main loops to dispatch the bus watches of all GstMsgProcessor. A source is always
+ * dispatched at the same loop thread, so the messages of one bus are still handled in order.
+ * The loops are started on demand, the max count is sized to the cores.
+ */
+class GstMsgDispatcher : public NoCopyable {
+public:
+    static GstMsgDispatcher &GetInstance();
+
+    /**
+     * Attach the source to the loop with the least sources.
+     * @return the context attached to, or nullptr if failed.
+     */
+    GMainContext *Attach(GSource &source);
+
+    /**
+     * Destroy the source. When it returns, the callback of the source is not running and will
+     * not be called anymore, except it is called at the loop thread of the source itself.
+     */
+    void Detach(GSource &source, GMainContext &context);
+
+private:
+    struct Loop {
+        GMainContext *context = nullptr;
+        GMainLoop *mainLoop = nullptr;
+        std::unique_ptr<TaskQueue> thread;
+        uint32_t sourceCount = 0;
+    };
+
+    GstMsgDispatcher();
+    ~GstMsgDispatcher();
+    Loop *GetIdleLoopLocked();
+    std::unique_ptr<Loop> StartLoop(uint32_t index);
+    static void StopLoop(Loop &loop);
+    static void WaitDispatchDone(GMainContext &context);
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<Loop>> loops_;
+    uint32_t maxLoopNum_ = 1;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // GST_MSG_DISPATCHER_H
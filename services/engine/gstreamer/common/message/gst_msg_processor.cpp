@@ -15,6 +15,7 @@
 
 #include "gst_msg_processor.h"
 #include <unordered_map>
+#include "gst_msg_dispatcher.h"
 #include "media_errors.h"
 #include "media_log.h"
 #include "scope_guard.h"
@@ -29,7 +30,7 @@ GstMsgProcessor::GstMsgProcessor(
     GstBus &gstBus,
     const InnerMsgNotifier &notifier,
     const std::shared_ptr<IGstMsgConverter> &converter)
-    : notifier_(notifier), guardTask_("msg_loop_guard"), msgConverter_(converter)
+    : notifier_(notifier), msgConverter_(converter)
 {
     gstBus_ = GST_BUS_CAST(gst_object_ref(&gstBus));
     MEDIA_LOGD("enter ctor, instance: 0x%{public}06" PRIXPTR "", FAKE_POINTER(this));
@@ -62,75 +63,19 @@ int32_t GstMsgProcessor::Init()
         msgConverter_ = std::make_shared<GstMsgConverterDefault>();
     }
 
-    int32_t ret = guardTask_.Start();
-    CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
-
-    auto mainLoopEnter = std::make_shared<TaskHandler<int32_t>>([this]() { return DoInit(); });
-    ret = guardTask_.EnqueueTask(mainLoopEnter);
-    CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
-
-    auto result = mainLoopEnter->GetResult();
-    CHECK_AND_RETURN_RET_LOG(result.HasResult(), MSERR_UNKNOWN, "msg processor init failed");
-    CHECK_AND_RETURN_RET_LOG(result.Value() == MSERR_OK, result.Value(), "msg processor init failed");
-
-    std::unique_lock<std::mutex> lock(mutex_);
-    cond_.wait(lock, [this] { return !needWaiting_; }); // wait main loop run done
-
-    CANCEL_SCOPE_EXIT_GUARD(0);
-    MEDIA_LOGD("Init exit");
-    return MSERR_OK;
-}
-
-int32_t GstMsgProcessor::DoInit()
-{
-    ON_SCOPE_EXIT(0) { DoReset(); };
-
-    context_ = g_main_context_new();
-    CHECK_AND_RETURN_RET(context_ != nullptr, MSERR_NO_MEMORY);
-
-    mainLoop_ = g_main_loop_new(context_, false);
-    CHECK_AND_RETURN_RET(mainLoop_ != nullptr, MSERR_NO_MEMORY);
-    g_main_context_push_thread_default(context_);
-
-    GSource *source = g_idle_source_new();
-    g_source_set_callback(source, (GSourceFunc)MainLoopRunDone, this, nullptr);
-    guint ret = g_source_attach(source, context_);
-    CHECK_AND_RETURN_RET_LOG(ret > 0, MSERR_INVALID_OPERATION, "add idle source failed");
-    g_source_unref(source);
-
     busSource_ = gst_bus_create_watch(gstBus_);
     CHECK_AND_RETURN_RET_LOG(busSource_ != nullptr, MSERR_NO_MEMORY, "add bus source failed");
     g_source_set_callback(busSource_, (GSourceFunc)&GstMsgProcessor::BusCallback, this, nullptr);
-    ret = g_source_attach(busSource_, context_);
-    CHECK_AND_RETURN_RET_LOG(ret > 0, MSERR_INVALID_OPERATION, "add bus source failed");
 
-    auto mainLoopRun = std::make_shared<TaskHandler<void>>([this] {
-        MEDIA_LOGI("start msg main loop...");
-        g_main_loop_run(mainLoop_);
-        MEDIA_LOGI("stop msg main loop...");
-        DoReset();
-    });
-
-    int32_t ret1 = guardTask_.EnqueueTask(mainLoopRun);
-    CHECK_AND_RETURN_RET(ret1 == MSERR_OK, ret1);
+    // the bus is watched at the shared msg loop instead of a dedicated thread.
+    context_ = GstMsgDispatcher::GetInstance().Attach(*busSource_);
+    CHECK_AND_RETURN_RET_LOG(context_ != nullptr, MSERR_INVALID_OPERATION, "add bus source failed");
 
     CANCEL_SCOPE_EXIT_GUARD(0);
+    MEDIA_LOGD("Init exit");
     return MSERR_OK;
 }
 
-gboolean GstMsgProcessor::MainLoopRunDone(GstMsgProcessor *thiz)
-{
-    if (thiz == nullptr) {
-        return G_SOURCE_REMOVE;
-    }
-
-    std::unique_lock<std::mutex> lock(thiz->mutex_);
-    thiz->needWaiting_ = false;
-    thiz->cond_.notify_one();
-
-    return G_SOURCE_REMOVE;
-}
-
 void GstMsgProcessor::AddMsgFilter(const std::string &filter)
 {
     std::unique_lock<std::mutex> lock(mutex_);
@@ -154,41 +99,16 @@ void GstMsgProcessor::FlushEnd()
     gst_bus_set_flushing(gstBus_, FALSE);
 }
 
-void GstMsgProcessor::DoReset()
+void GstMsgProcessor::Reset() noexcept
 {
     if (busSource_ != nullptr) {
-        g_source_destroy(busSource_);
+        if (context_ != nullptr) {
+            GstMsgDispatcher::GetInstance().Detach(*busSource_, *context_);
+            context_ = nullptr;
+        }
         g_source_unref(busSource_);
         busSource_ = nullptr;
     }
-
-    if (mainLoop_ != nullptr) {
-        g_main_loop_unref(mainLoop_);
-        mainLoop_ = nullptr;
-    }
-
-    if (context_ != nullptr) {
-        g_main_context_pop_thread_default(context_);
-        g_main_context_unref(context_);
-        context_ = nullptr;
-    }
-}
-
-void GstMsgProcessor::Reset() noexcept
-{
-    if (mainLoop_ != nullptr) {
-        if (g_main_loop_is_running(mainLoop_)) {
-            g_main_loop_quit(mainLoop_);
-        }
-    }
-
-    {
-        std::unique_lock<std::mutex> lock(mutex_);
-        needWaiting_ = false;
-    }
-
-    cond_.notify_all();
-    (void)guardTask_.Stop();
     msgConverter_ = nullptr;
 }
 
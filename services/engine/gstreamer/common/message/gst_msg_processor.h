@@ -17,12 +17,10 @@
 #define GST_MSG_PROCESSOR_H
 
 #include <mutex>
-#include <condition_variable>
 #include <string>
 #include <vector>
 #include <gst/gst.h>
 #include "inner_msg_define.h"
-#include "task_queue.h"
 #include "gst_msg_converter.h"
 #include "nocopyable.h"
 
@@ -47,21 +45,14 @@ public:
     void Reset() noexcept;
 
 private:
-    int32_t DoInit();
-    static gboolean MainLoopRunDone(GstMsgProcessor *thiz);
     static gboolean BusCallback(const GstBus *bus, GstMessage *msg, GstMsgProcessor *thiz);
     void ProcessGstMessage(GstMessage &msg);
-    void DoReset();
 
     GstBus *gstBus_ = nullptr;
-    GMainLoop *mainLoop_ = nullptr;
     GMainContext *context_ = nullptr;
-    GSource *busSource_ = 0;
+    GSource *busSource_ = nullptr;
     InnerMsgNotifier notifier_;
-    TaskQueue guardTask_;
     std::mutex mutex_;
-    std::condition_variable cond_;
-    bool needWaiting_ = true;
     std::shared_ptr<IGstMsgConverter> msgConverter_;
     std::vector<std::string> filters_;
 };
@@ -14,17 +14,41 @@
  */
 
 #include "gst_appsrc_warp.h"
+#include <algorithm>
+#include <cmath>
 #include "avsharedmemorybase.h"
+#include "gst_shmem_wrap_allocator.h"
 #include "media_log.h"
 #include "media_errors.h"
+#include "param_wrapper.h"
 #include "player.h"
 #include "securec.h"
+#include "time_perf.h"
 
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "GstAppsrcWarp"};
+    constexpr uint32_t APPSRC_TASK_NUM = 3;
     constexpr int32_t BUFFERS_NUM = 5;
+    constexpr int32_t ZERO_COPY_BUFFERS_NUM = 10;
     constexpr int32_t BUFFER_SIZE = 81920;
     constexpr int64_t INVALID_SIZE = -1;
+    // IMediaDataSource::ReadAt is not required to be reentrant, so the parallel reads are opt-in.
+    constexpr int32_t DEFAULT_FILL_TASK_NUM = 1;
+    constexpr int32_t MAX_FILL_TASK_NUM = 4;
+    constexpr int64_t RATE_WINDOW_US = 200000;
+    constexpr double READ_LATENCY_WEIGHT = 0.125;
+    constexpr double PERCENT = 100.0;
+    constexpr int64_t US_PER_MS = 1000;
+
+    uint32_t GetFillTaskNum(int64_t size)
+    {
+        // the stream source can only be read in order
+        if (size == INVALID_SIZE) {
+            return 1;
+        }
+        int32_t num = OHOS::system::GetIntParameter("sys.media.datasrc.prefetch.num", DEFAULT_FILL_TASK_NUM);
+        return static_cast<uint32_t>(std::clamp(num, 1, MAX_FILL_TASK_NUM));
+    }
 }
 
 namespace OHOS {
@@ -44,13 +68,17 @@ std::shared_ptr<GstAppsrcWarp> GstAppsrcWarp::Create(const std::shared_ptr<IMedi
 GstAppsrcWarp::GstAppsrcWarp(const std::shared_ptr<IMediaDataSource> &dataSrc, const int64_t size)
     : dataSrc_(dataSrc),
       size_(size),
-      fillTaskQue_("fillbufferTask"),
-      emptyTaskQue_("emptybufferTask"),
+      fillTaskNum_(GetFillTaskNum(size)),
+      taskQue_("appsrcTask", APPSRC_TASK_NUM + fillTaskNum_ - 1),
       bufferSize_(BUFFER_SIZE),
       buffersNum_(BUFFERS_NUM)
 {
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances create and size %{public}" PRId64 "", FAKE_POINTER(this), size);
     streamType_ = size == INVALID_SIZE ? GST_APP_STREAM_TYPE_STREAM : GST_APP_STREAM_TYPE_RANDOM_ACCESS;
+    zeroCopy_ = OHOS::system::GetIntParameter("sys.media.datasrc.zerocopy", 1) != 0;
+    if (zeroCopy_) {
+        buffersNum_ = ZERO_COPY_BUFFERS_NUM;
+    }
 }
 
 GstAppsrcWarp::~GstAppsrcWarp()
@@ -58,10 +86,18 @@ GstAppsrcWarp::~GstAppsrcWarp()
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances destroy", FAKE_POINTER(this));
     Stop();
     ClearAppsrc();
+    if (allocator_ != nullptr) {
+        gst_object_unref(allocator_);
+        allocator_ = nullptr;
+    }
 }
 
 int32_t GstAppsrcWarp::Init()
 {
+    if (zeroCopy_) {
+        allocator_ = GST_ALLOCATOR_CAST(gst_shmem_wrap_allocator_new());
+        CHECK_AND_RETURN_RET_LOG(allocator_ != nullptr, MSERR_NO_MEMORY, "init allocator failed");
+    }
     for (int i = 0; i < buffersNum_; ++i) {
         std::shared_ptr<AppsrcMemWarp> appSrcMem = std::make_shared<AppsrcMemWarp>();
         CHECK_AND_RETURN_RET_LOG(appSrcMem != nullptr, MSERR_NO_MEMORY, "init AppsrcMemWarp failed");
@@ -90,19 +126,33 @@ int32_t GstAppsrcWarp::Prepare()
     while (!filledBuffers_.empty()) {
         std::shared_ptr<AppsrcMemWarp> appSrcMem = filledBuffers_.front();
         filledBuffers_.pop();
-        emptyBuffers_.push(appSrcMem);
+        FreeMem(appSrcMem);
     }
-    CHECK_AND_RETURN_RET_LOG(fillTaskQue_.Start() == MSERR_OK, MSERR_INVALID_OPERATION, "init task failed");
-    CHECK_AND_RETURN_RET_LOG(emptyTaskQue_.Start() == MSERR_OK, MSERR_INVALID_OPERATION, "init task failed");
-    auto task = std::make_shared<TaskHandler<void>>([this] {
-        FillTask();
+    inflightReadNum_ = 0;
+    RestartReadLocked(0);
+    stats_ = AppsrcPrefetchStats();
+    CHECK_AND_RETURN_RET_LOG(taskQue_.Start() == MSERR_OK, MSERR_INVALID_OPERATION, "init task failed");
+    std::shared_ptr<TaskHandler<void>> task = nullptr;
+    for (uint32_t i = 0; i < fillTaskNum_; i++) {
+        task = std::make_shared<TaskHandler<void>>([this] {
+            FillTask();
+        });
+        CHECK_AND_RETURN_RET_LOG(taskQue_.EnqueueTask(task) == MSERR_OK,
+            MSERR_INVALID_OPERATION, "enque task failed");
+    }
+    task = std::make_shared<TaskHandler<void>>([this] {
+        EmptyTask();
     });
-    CHECK_AND_RETURN_RET_LOG(fillTaskQue_.EnqueueTask(task) == MSERR_OK,
+    CHECK_AND_RETURN_RET_LOG(taskQue_.EnqueueTask(task) == MSERR_OK,
         MSERR_INVALID_OPERATION, "enque task failed");
+    {
+        std::unique_lock<std::mutex> releaseLock(releaseMutex_);
+        releaseExit_ = false;
+    }
     task = std::make_shared<TaskHandler<void>>([this] {
-        EmptyTask();
+        ReleaseTask();
     });
-    CHECK_AND_RETURN_RET_LOG(emptyTaskQue_.EnqueueTask(task) == MSERR_OK,
+    CHECK_AND_RETURN_RET_LOG(taskQue_.EnqueueTask(task) == MSERR_OK,
         MSERR_INVALID_OPERATION, "enque task failed");
     MEDIA_LOGD("Prepare out");
     return MSERR_OK;
@@ -120,8 +170,12 @@ void GstAppsrcWarp::Stop()
         fillCond_.notify_all();
         emptyCond_.notify_all();
     }
-    (void)fillTaskQue_.Stop();
-    (void)emptyTaskQue_.Stop();
+    {
+        std::unique_lock<std::mutex> lock(releaseMutex_);
+        releaseExit_ = true;
+        releaseCond_.notify_all();
+    }
+    (void)taskQue_.Stop();
 }
 
 void GstAppsrcWarp::ClearAppsrc()
@@ -187,14 +241,20 @@ void GstAppsrcWarp::NeedDataInner(uint32_t size)
     std::unique_lock<std::mutex> lock(mutex_);
     int32_t ret = MSERR_OK;
     needDataSize_ = static_cast<int32_t>(size);
+    stats_.needDataCount++;
     if (!filledBuffers_.empty() && (needDataSize_ <= filledBufferSize_ || atEos_ ||
         streamType_ == GST_APP_STREAM_TYPE_STREAM) && !isExit_) {
+        stats_.hitCount++;
         ret = GetAndPushMem();
+        UpdateStallLocked();
         if (ret != MSERR_OK) {
             OnError(ret);
         }
     } else {
         needData_ = true;
+        if (stats_.stallStartUs < 0) {
+            stats_.stallStartUs = TimePerf::GetCurrentUs();
+        }
         if (!filledBuffers_.empty()) {
             emptyCond_.notify_all();
         }
@@ -221,6 +281,7 @@ void GstAppsrcWarp::EmptyTask()
             break;
         }
         ret = GetAndPushMem();
+        UpdateStallLocked();
     }
     if (ret != MSERR_OK) {
         OnError(ret);
@@ -244,7 +305,7 @@ void GstAppsrcWarp::SeekAndFreeBuffers(uint64_t pos)
         CHECK_AND_RETURN_LOG(appSrcMem != nullptr, "appSrcMem is nullptr");
         if (appSrcMem->size < 0) {
             filledBuffers_.pop();
-            emptyBuffers_.push(appSrcMem);
+            FreeMem(appSrcMem);
             continue;
         }
         if (appSrcMem->pos <= pos && appSrcMem->pos + static_cast<uint64_t>(appSrcMem->size) > pos) {
@@ -256,11 +317,13 @@ void GstAppsrcWarp::SeekAndFreeBuffers(uint64_t pos)
         }
         filledBufferSize_ = filledBufferSize_ - (appSrcMem->size - appSrcMem->offset);
         filledBuffers_.pop();
-        emptyBuffers_.push(appSrcMem);
+        FreeMem(appSrcMem);
     }
     if (filledBuffers_.empty()) {
         curPos_ = pos;
         atEos_ = false;
+        // the reads in flight are for the old position, drop them when they are done.
+        RestartReadLocked(pos);
     }
     fillCond_.notify_all();
 }
@@ -276,49 +339,172 @@ int32_t GstAppsrcWarp::ReadAndGetMem()
     int32_t ret = MSERR_OK;
     while (ret == MSERR_OK) {
         int32_t size = 0;
+        uint32_t generation = 0;
         std::shared_ptr<AppsrcMemWarp> appSrcMem = nullptr;
         {
             std::unique_lock<std::mutex> lock(mutex_);
-            fillCond_.wait(lock, [this] { return (!emptyBuffers_.empty() && !atEos_) || isExit_; });
+            fillCond_.wait(lock, [this] {
+                return CanReadLocked() || isExit_;
+            });
             if (isExit_) {
                 break;
             }
             appSrcMem = emptyBuffers_.front();
             CHECK_AND_RETURN_RET_LOG(appSrcMem != nullptr && appSrcMem->mem != nullptr, MSERR_NO_MEMORY, "no mem");
-            appSrcMem->pos = curPos_;
+            appSrcMem->pos = readPos_;
             emptyBuffers_.pop();
+            readPos_ += static_cast<uint64_t>(bufferSize_);
+            generation = readGeneration_;
+            inflightReadNum_++;
         }
+        int64_t startUs = TimePerf::GetCurrentUs();
         if (size_ == INVALID_SIZE) {
             size = dataSrc_->ReadAt(bufferSize_, appSrcMem->mem);
         } else {
             size = dataSrc_->ReadAt(static_cast<int64_t>(appSrcMem->pos), bufferSize_, appSrcMem->mem);
         }
+        double costUs = static_cast<double>(TimePerf::GetCurrentUs() - startUs);
         if (size > appSrcMem->mem->GetSize()) {
             ret = MSERR_INVALID_VAL;
         }
         {
             std::unique_lock<std::mutex> lock(mutex_);
-            if (size == 0 || curPos_ != appSrcMem->pos) {
+            inflightReadNum_--;
+            stats_.readCount++;
+            stats_.readLatencyUs = stats_.readLatencyUs == 0.0 ? costUs :
+                stats_.readLatencyUs + (costUs - stats_.readLatencyUs) * READ_LATENCY_WEIGHT;
+            if (generation != readGeneration_) {
+                stats_.droppedReadCount++;
                 emptyBuffers_.push(appSrcMem);
-            } else if (size < 0) {
-                appSrcMem->size = size;
-                atEos_ = true;
-                filledBuffers_.push(appSrcMem);
             } else {
-                size = std::min(size, appSrcMem->mem->GetSize());
-                appSrcMem->size = size;
-                filledBufferSize_ += size;
-                appSrcMem->pos = curPos_;
-                appSrcMem->offset = 0;
-                curPos_ = curPos_ + static_cast<uint64_t>(size);
-                filledBuffers_.push(appSrcMem);
+                OnReadDoneLocked(appSrcMem, size);
             }
+            fillCond_.notify_all();
             emptyCond_.notify_all();
         }
     }
     return ret;
 }
 
+bool GstAppsrcWarp::CanReadLocked() const
+{
+    if (emptyBuffers_.empty() || atEos_) {
+        return false;
+    }
+    // the read at the size gets the eos, no need to read beyond it.
+    if (size_ != INVALID_SIZE && readPos_ > static_cast<uint64_t>(size_)) {
+        return false;
+    }
+    return inflightReadNum_ < GetReadWindowLocked();
+}
+
+int32_t GstAppsrcWarp::GetReadWindowLocked() const
+{
+    int32_t maxWindow = static_cast<int32_t>(fillTaskNum_);
+    if (maxWindow <= 1 || stats_.consumeRate == 0.0 || stats_.readLatencyUs == 0.0) {
+        return maxWindow;
+    }
+    // keep enough reads in flight to cover what is consumed during one read, and one more to spare.
+    double bytesPerRead = stats_.consumeRate * stats_.readLatencyUs;
+    int32_t window = static_cast<int32_t>(std::ceil(bytesPerRead / bufferSize_)) + 1;
+    return std::clamp(window, 1, maxWindow);
+}
+
+void GstAppsrcWarp::OnReadDoneLocked(const std::shared_ptr<AppsrcMemWarp> &appSrcMem, int32_t size)
+{
+    if (size == 0) {
+        // nothing available yet, read this position again.
+        emptyBuffers_.push(appSrcMem);
+        if (appSrcMem->pos < readPos_) {
+            RestartReadLocked(appSrcMem->pos);
+        }
+        return;
+    }
+    appSrcMem->size = size > 0 ? std::min(size, appSrcMem->mem->GetSize()) : size;
+    appSrcMem->offset = 0;
+    readDoneBuffers_[appSrcMem->pos] = appSrcMem;
+    CommitReadDoneLocked();
+}
+
+void GstAppsrcWarp::CommitReadDoneLocked()
+{
+    while (!readDoneBuffers_.empty() && !atEos_) {
+        auto iter = readDoneBuffers_.begin();
+        if (size_ != INVALID_SIZE && iter->first != curPos_) {
+            break;
+        }
+        std::shared_ptr<AppsrcMemWarp> appSrcMem = iter->second;
+        (void)readDoneBuffers_.erase(iter);
+        appSrcMem->refs = 1;
+        filledBuffers_.push(appSrcMem);
+        if (appSrcMem->size < 0) {
+            atEos_ = true;
+            RestartReadLocked(curPos_);
+            break;
+        }
+        filledBufferSize_ += appSrcMem->size;
+        curPos_ = curPos_ + static_cast<uint64_t>(appSrcMem->size);
+        // the reads after a short read are not aligned to it, read again from the real position.
+        if (appSrcMem->size < bufferSize_) {
+            RestartReadLocked(curPos_);
+        }
+    }
+}
+
+void GstAppsrcWarp::RestartReadLocked(uint64_t pos)
+{
+    readGeneration_++;
+    readPos_ = pos;
+    for (auto &[bufferPos, appSrcMem] : readDoneBuffers_) {
+        (void)bufferPos;
+        emptyBuffers_.push(appSrcMem);
+    }
+    readDoneBuffers_.clear();
+}
+
+void GstAppsrcWarp::UpdateConsumeRateLocked(int32_t size)
+{
+    int64_t nowUs = TimePerf::GetCurrentUs();
+    if (stats_.rateStartUs == 0) {
+        stats_.rateStartUs = nowUs;
+        stats_.rateBytes = 0;
+    }
+    stats_.rateBytes += size;
+    int64_t elapsedUs = nowUs - stats_.rateStartUs;
+    if (elapsedUs < RATE_WINDOW_US) {
+        return;
+    }
+    double rate = static_cast<double>(stats_.rateBytes) / static_cast<double>(elapsedUs);
+    stats_.consumeRate = stats_.consumeRate == 0.0 ? rate : (stats_.consumeRate + rate) / 2;
+    stats_.rateStartUs = nowUs;
+    stats_.rateBytes = 0;
+}
+
+void GstAppsrcWarp::UpdateStallLocked()
+{
+    if (!needData_ && stats_.stallStartUs >= 0) {
+        stats_.stallUs += TimePerf::GetCurrentUs() - stats_.stallStartUs;
+        stats_.stallStartUs = -1;
+    }
+}
+
+void GstAppsrcWarp::DumpInfo(std::string &dumpString)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    double hitRate = stats_.needDataCount == 0 ? 0.0 :
+        PERCENT * static_cast<double>(stats_.hitCount) / static_cast<double>(stats_.needDataCount);
+    dumpString += "GstAppsrcWarp fill tasks: " + std::to_string(fillTaskNum_) +
+        ", read window: " + std::to_string(GetReadWindowLocked()) +
+        ", reads in flight: " + std::to_string(inflightReadNum_) + "\n";
+    dumpString += "GstAppsrcWarp need data: " + std::to_string(stats_.needDataCount) +
+        ", hit rate: " + std::to_string(hitRate) + "%" +
+        ", stall time: " + std::to_string(stats_.stallUs / US_PER_MS) + " ms\n";
+    dumpString += "GstAppsrcWarp reads: " + std::to_string(stats_.readCount) +
+        ", dropped: " + std::to_string(stats_.droppedReadCount) +
+        ", avg latency: " + std::to_string(static_cast<int64_t>(stats_.readLatencyUs)) + " us" +
+        ", consume rate: " + std::to_string(static_cast<int64_t>(stats_.consumeRate * US_PER_MS)) + " KB/s\n";
+}
+
 void GstAppsrcWarp::EosAndCheckSize(int32_t size)
 {
     MEDIA_LOGD("%{public}d", size);
@@ -345,7 +531,7 @@ int32_t GstAppsrcWarp::GetAndPushMem()
     if (size == 0) {
         EosAndCheckSize(appSrcMem->size);
         filledBuffers_.pop();
-        emptyBuffers_.push(appSrcMem);
+        FreeMem(appSrcMem);
         needData_ = false;
         return MSERR_OK;
     }
@@ -355,27 +541,28 @@ int32_t GstAppsrcWarp::GetAndPushMem()
     } else {
         bufferWarp_ = std::make_shared<AppsrcBufferWarp>();
         int32_t allocSize = streamType_ == GST_APP_STREAM_TYPE_STREAM ? size : needDataSize_;
-        buffer = gst_buffer_new_allocate(nullptr, static_cast<gsize>(allocSize), nullptr);
+        // fall back to copy when downstream holds too many mems, otherwise the fill task would starve
+        bufferWarp_->zeroCopy = zeroCopy_ && heldMemNum_ < buffersNum_ / 2;
+        if (bufferWarp_->zeroCopy) {
+            buffer = gst_buffer_new();
+        } else {
+            buffer = gst_buffer_new_allocate(nullptr, static_cast<gsize>(allocSize), nullptr);
+        }
         CHECK_AND_RETURN_RET_LOG(buffer != nullptr, MSERR_NO_MEMORY, "no mem");
         GST_BUFFER_OFFSET(buffer) = appSrcMem->pos + static_cast<uint64_t>(appSrcMem->offset);
         bufferWarp_->buffer = buffer;
         bufferWarp_->offset = 0;
         bufferWarp_->size = allocSize;
     }
-    GstMapInfo info = GST_MAP_INFO_INIT;
-    if (gst_buffer_map(buffer, &info, GST_MAP_WRITE) == FALSE) {
-        gst_buffer_unref(buffer);
-        MEDIA_LOGE("map buffer failed");
-        return MSERR_NO_MEMORY;
-    }
-    bool copyRet = CopyToGstBuffer(info);
-    gst_buffer_unmap(buffer, &info);
-    if (!copyRet) {
-        MEDIA_LOGE("copy buffer failed");
+    bool fillRet = bufferWarp_->zeroCopy ? WrapToGstBuffer(buffer) : CopyToGstBuffer(buffer);
+    if (!fillRet) {
+        MEDIA_LOGE("fill buffer failed");
+        bufferWarp_ = nullptr;
         gst_buffer_unref(buffer);
         return MSERR_NO_MEMORY;
     }
     if (bufferWarp_->size == bufferWarp_->offset) {
+        UpdateConsumeRateLocked(bufferWarp_->size);
         bufferWarp_ = nullptr;
         PushData(buffer);
         needDataSize_ = 0;
@@ -388,8 +575,10 @@ int32_t GstAppsrcWarp::GetAndPushMem()
     return MSERR_OK;
 }
 
-bool GstAppsrcWarp::CopyToGstBuffer(const GstMapInfo &info)
+bool GstAppsrcWarp::CopyToGstBuffer(GstBuffer *buffer)
 {
+    GstMapInfo info = GST_MAP_INFO_INIT;
+    CHECK_AND_RETURN_RET_LOG(gst_buffer_map(buffer, &info, GST_MAP_WRITE) == TRUE, false, "map buffer failed");
     guint8 *data = info.data + bufferWarp_->offset;
     int32_t size = static_cast<int32_t>(info.size) - bufferWarp_->offset;
     while (size > 0 && !filledBuffers_.empty()) {
@@ -405,8 +594,7 @@ bool GstAppsrcWarp::CopyToGstBuffer(const GstMapInfo &info)
             "get mem is nullptr");
         if (lastSize <= size) {
             filledBuffers_.pop();
-            emptyBuffers_.push(appSrcMem);
-            fillCond_.notify_all();
+            FreeMem(appSrcMem);
         } else {
             appSrcMem->offset += copySize;
         }
@@ -414,12 +602,103 @@ bool GstAppsrcWarp::CopyToGstBuffer(const GstMapInfo &info)
         bufferWarp_->offset += copySize;
         size -= copySize;
     }
+    gst_buffer_unmap(buffer, &info);
+    if (size != 0 && !filledBuffers_.empty()) {
+        return false;
+    }
+    return true;
+}
+
+bool GstAppsrcWarp::WrapToGstBuffer(GstBuffer *buffer)
+{
+    CHECK_AND_RETURN_RET_LOG(allocator_ != nullptr, false, "allocator is nullptr");
+    int32_t size = bufferWarp_->size - bufferWarp_->offset;
+    while (size > 0 && !filledBuffers_.empty()) {
+        std::shared_ptr<AppsrcMemWarp> appSrcMem = filledBuffers_.front();
+        CHECK_AND_BREAK_LOG(appSrcMem != nullptr && appSrcMem->mem != nullptr
+            && appSrcMem->mem->GetBase() != nullptr
+            && (appSrcMem->size - appSrcMem->offset) > 0,
+            "get mem is nullptr");
+        int32_t lastSize = appSrcMem->size - appSrcMem->offset;
+        int32_t wrapSize = std::min(lastSize, size);
+        GstMemory *mem = gst_shmem_wrap(allocator_, WrapMem(appSrcMem));
+        CHECK_AND_BREAK_LOG(mem != nullptr, "wrap mem failed");
+        gst_memory_resize(mem, static_cast<gssize>(appSrcMem->offset), static_cast<gsize>(wrapSize));
+        gst_buffer_append_memory(buffer, mem);
+        if (lastSize <= size) {
+            filledBuffers_.pop();
+            FreeMem(appSrcMem);
+        } else {
+            appSrcMem->offset += wrapSize;
+        }
+        bufferWarp_->offset += wrapSize;
+        size -= wrapSize;
+    }
     if (size != 0 && !filledBuffers_.empty()) {
         return false;
     }
     return true;
 }
 
+std::shared_ptr<AVSharedMemory> GstAppsrcWarp::WrapMem(const std::shared_ptr<AppsrcMemWarp> &appSrcMem)
+{
+    appSrcMem->refs++;
+    std::weak_ptr<GstAppsrcWarp> weakWarp = weak_from_this();
+    // The deleter runs in whichever thread drops the last GstMemory, possibly while mutex_ is held by
+    // the pushing thread or while appsrc holds its own lock, so it must not take mutex_.
+    return std::shared_ptr<AVSharedMemory>(appSrcMem->mem.get(), [weakWarp, appSrcMem](AVSharedMemory *) {
+        if (--appSrcMem->refs != 0) {
+            return;
+        }
+        std::shared_ptr<GstAppsrcWarp> warp = weakWarp.lock();
+        if (warp != nullptr) {
+            warp->OnMemReleased(appSrcMem);
+        }
+    });
+}
+
+void GstAppsrcWarp::FreeMem(const std::shared_ptr<AppsrcMemWarp> &appSrcMem)
+{
+    if (--appSrcMem->refs == 0) {
+        emptyBuffers_.push(appSrcMem);
+        fillCond_.notify_all();
+    } else {
+        heldMemNum_++;
+    }
+}
+
+void GstAppsrcWarp::OnMemReleased(const std::shared_ptr<AppsrcMemWarp> &appSrcMem)
+{
+    std::unique_lock<std::mutex> lock(releaseMutex_);
+    releasedBuffers_.push(appSrcMem);
+    releaseCond_.notify_all();
+}
+
+void GstAppsrcWarp::ReleaseTask()
+{
+    while (true) {
+        std::queue<std::shared_ptr<AppsrcMemWarp>> released;
+        {
+            std::unique_lock<std::mutex> lock(releaseMutex_);
+            releaseCond_.wait(lock, [this] {
+                return !releasedBuffers_.empty() || releaseExit_;
+            });
+            if (releaseExit_) {
+                break;
+            }
+            released.swap(releasedBuffers_);
+        }
+        // releaseMutex_ is dropped first, the deleter may be blocked on it while its thread holds mutex_
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!released.empty()) {
+            emptyBuffers_.push(released.front());
+            released.pop();
+            heldMemNum_--;
+        }
+        fillCond_.notify_all();
+    }
+}
+
 void GstAppsrcWarp::OnError(int32_t errorCode)
 {
     PlayerErrorType errorType = PLAYER_ERROR_UNKNOWN;
@@ -17,7 +17,10 @@
 #define GST_APPSRC_WARP_H_
 
 #include <gst/gst.h>
+#include <atomic>
+#include <map>
 #include <queue>
+#include <string>
 #include "task_queue.h"
 #include "media_data_source.h"
 #include "gst/app/gstappsrc.h"
@@ -34,15 +37,34 @@ struct AppsrcMemWarp {
     int32_t size;
     // offset of mem
     int32_t offset;
+    // one for filledBuffers_ and one for each GstMemory wrapping mem, back to emptyBuffers_ when drops to 0
+    std::atomic<int32_t> refs = 0;
+};
+
+struct AppsrcPrefetchStats {
+    uint64_t needDataCount = 0;
+    // need-data served by the filled buffers at once
+    uint64_t hitCount = 0;
+    int64_t stallUs = 0;
+    int64_t stallStartUs = -1;
+    uint64_t readCount = 0;
+    // reads finished after the seek, the data is dropped
+    uint64_t droppedReadCount = 0;
+    double readLatencyUs = 0.0;
+    // bytes consumed by the appsrc per us
+    double consumeRate = 0.0;
+    int64_t rateStartUs = 0;
+    int64_t rateBytes = 0;
 };
 
 struct AppsrcBufferWarp {
     GstBuffer *buffer = nullptr;
     int32_t offset = 0;
     int32_t size = 0;
+    bool zeroCopy = false;
 };
 
-class GstAppsrcWarp : public NoCopyable {
+class GstAppsrcWarp : public NoCopyable, public std::enable_shared_from_this<GstAppsrcWarp> {
 public:
     static std::shared_ptr<GstAppsrcWarp> Create(const std::shared_ptr<IMediaDataSource> &dataSrc);
     GstAppsrcWarp(const std::shared_ptr<IMediaDataSource> &dataSrc, const int64_t size);
@@ -54,6 +76,7 @@ public:
     int32_t Init();
     int32_t Prepare();
     void Stop();
+    void DumpInfo(std::string &dumpString);
 
 private:
     void SetCallBackForAppSrc();
@@ -64,6 +87,13 @@ private:
     gboolean SeekDataInner(uint64_t seekPos);
     void SeekAndFreeBuffers(uint64_t pos);
     int32_t ReadAndGetMem();
+    bool CanReadLocked() const;
+    int32_t GetReadWindowLocked() const;
+    void OnReadDoneLocked(const std::shared_ptr<AppsrcMemWarp> &appSrcMem, int32_t size);
+    void CommitReadDoneLocked();
+    void RestartReadLocked(uint64_t pos);
+    void UpdateConsumeRateLocked(int32_t size);
+    void UpdateStallLocked();
     void AnalyzeSize(int32_t size);
     int32_t GetAndPushMem();
     void OnError(int32_t errorCode);
@@ -71,17 +101,32 @@ private:
     void PushEos();
     void FillTask();
     void EmptyTask();
+    void ReleaseTask();
     void EosAndCheckSize(int32_t size);
-    bool CopyToGstBuffer(const GstMapInfo &info);
+    bool CopyToGstBuffer(GstBuffer *buffer);
+    bool WrapToGstBuffer(GstBuffer *buffer);
+    std::shared_ptr<AVSharedMemory> WrapMem(const std::shared_ptr<AppsrcMemWarp> &appSrcMem);
+    void FreeMem(const std::shared_ptr<AppsrcMemWarp> &appSrcMem);
+    void OnMemReleased(const std::shared_ptr<AppsrcMemWarp> &appSrcMem);
     std::shared_ptr<IMediaDataSource> dataSrc_ = nullptr;
     const int64_t size_;
+    // concurrent reads for the random access source, only one for the stream source
+    const uint32_t fillTaskNum_;
     uint64_t curPos_ = 0;
+    // next position to read, the reads ahead of curPos_ are done in parallel
+    uint64_t readPos_ = 0;
+    // increased when the reads in flight become useless, such as seek
+    uint32_t readGeneration_ = 0;
+    int32_t inflightReadNum_ = 0;
+    // reads done out of order, waiting for the reads before them
+    std::map<uint64_t, std::shared_ptr<AppsrcMemWarp>> readDoneBuffers_;
+    AppsrcPrefetchStats stats_;
     std::mutex mutex_;
     std::condition_variable emptyCond_;
     std::condition_variable fillCond_;
     GstElement *appSrc_ = nullptr;
-    TaskQueue fillTaskQue_;
-    TaskQueue emptyTaskQue_;
+    // runs the fill tasks and the empty task concurrently
+    TaskQueue taskQue_;
     GstAppStreamType streamType_ = GST_APP_STREAM_TYPE_STREAM;
     std::weak_ptr<IPlayerEngineObs> obs_;
     std::vector<gulong> callbackIds_;
@@ -95,6 +140,15 @@ private:
     int32_t bufferSize_;
     int32_t buffersNum_;
     std::shared_ptr<AppsrcBufferWarp> bufferWarp_;
+    bool zeroCopy_ = false;
+    GstAllocator *allocator_ = nullptr;
+    // mems popped from filledBuffers_ but still referenced by downstream
+    int32_t heldMemNum_ = 0;
+    // released by the mem deleters, which must not take mutex_, and recycled by ReleaseTask under mutex_
+    std::mutex releaseMutex_;
+    std::condition_variable releaseCond_;
+    std::queue<std::shared_ptr<AppsrcMemWarp>> releasedBuffers_;
+    bool releaseExit_ = true;
 };
 } // namespace Media
 } // namespace OHOS
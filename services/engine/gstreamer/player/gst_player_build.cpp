@@ -15,6 +15,7 @@
 
 #include "gst_player_build.h"
 #include "media_log.h"
+#include "media_errors.h"
 
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "GstPlayerBuild"};
@@ -118,6 +119,17 @@ std::shared_ptr<GstPlayerCtrl> GstPlayerBuild::BuildPlayerCtrl()
     return playerCtrl_;
 }
 
+int32_t GstPlayerBuild::BindSurface(const sptr<Surface> &surface)
+{
+    CHECK_AND_RETURN_RET_LOG(gstPlayer_ != nullptr && rendererCtrl_ != nullptr, MSERR_INVALID_OPERATION,
+        "player is not built");
+    GstElement *playbin = gst_player_get_pipeline(gstPlayer_);
+    CHECK_AND_RETURN_RET_LOG(playbin != nullptr, MSERR_INVALID_OPERATION, "playbin is nullptr");
+    int32_t ret = rendererCtrl_->BindSurface(surface, playbin);
+    gst_object_unref(playbin);
+    return ret;
+}
+
 void GstPlayerBuild::CreateLoop()
 {
     MEDIA_LOGI("Create the loop for the current context");
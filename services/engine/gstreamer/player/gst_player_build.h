@@ -32,6 +32,7 @@ public:
 
     std::shared_ptr<GstPlayerVideoRendererCtrl> BuildRendererCtrl(sptr<Surface> surface = nullptr);
     std::shared_ptr<GstPlayerCtrl> BuildPlayerCtrl();
+    int32_t BindSurface(const sptr<Surface> &surface);
     void CreateLoop();
     void DestroyLoop() const;
     void WaitMainLoopStart();
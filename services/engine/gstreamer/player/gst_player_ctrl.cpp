@@ -22,6 +22,7 @@
 namespace {
     constexpr float INVALID_VOLUME = -1.0;
     constexpr double DEFAULT_RATE = 1.0;
+    constexpr double TRICK_MODE_MIN_RATE = 4.0;
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "GstPlayerCtrl"};
     constexpr int MILLI = 1000;
     constexpr int MICRO = MILLI * 1000;
@@ -81,6 +82,16 @@ GstPlayerCtrl::~GstPlayerCtrl()
     condVarStopSync_.notify_all();
     condVarSeekSync_.notify_all();
     condVarPreparingSync_.notify_all();
+    if (bus_ != nullptr) {
+        g_signal_handler_disconnect(bus_, signalIdStreamStart_);
+        gst_object_unref(bus_);
+        bus_ = nullptr;
+    }
+    if (playbin_ != nullptr) {
+        g_signal_handler_disconnect(playbin_, signalIdAboutToFinish_);
+        gst_object_unref(playbin_);
+        playbin_ = nullptr;
+    }
     (void)taskQue_.Stop();
     for (auto &signalId : signalIds_) {
         g_signal_handler_disconnect(gstPlayer_, signalId);
@@ -138,6 +149,121 @@ int32_t GstPlayerCtrl::SetSource(const std::shared_ptr<GstAppsrcWarp> &appsrcWar
     return MSERR_OK;
 }
 
+int32_t GstPlayerCtrl::SetNextUrl(const std::string &url)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(gstPlayer_ != nullptr, MSERR_INVALID_OPERATION, "gstPlayer_ is nullptr");
+    CHECK_AND_RETURN_RET_LOG(appsrcWarp_ == nullptr, MSERR_INVALID_OPERATION, "not support for the appsrc");
+    CHECK_AND_RETURN_RET_LOG(!isExit_, MSERR_INVALID_OPERATION, "the player is stopped");
+    if (playbin_ == nullptr) {
+        int32_t ret = InitGapless();
+        CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
+    }
+
+    std::unique_lock<std::mutex> nextLock(nextMutex_);
+    CHECK_AND_RETURN_RET_LOG(!switchPending_, MSERR_INVALID_OPERATION, "the switch to the next source is pending");
+    // the playbin asks the next source only once, it's too late after that
+    CHECK_AND_RETURN_RET_LOG(url.empty() || !aboutToFinish_, MSERR_INVALID_OPERATION,
+        "the current source is already finishing");
+    nextUrl_ = url;
+    MEDIA_LOGI("next source %{public}s", url.empty() ? "cleared" : "set");
+    return MSERR_OK;
+}
+
+int32_t GstPlayerCtrl::InitGapless()
+{
+    GstElement *playbin = gst_player_get_pipeline(gstPlayer_);
+    CHECK_AND_RETURN_RET_LOG(playbin != nullptr, MSERR_INVALID_OPERATION, "playbin is null");
+
+    // the playbin posts the stream-start once all of its sinks start the next source, whatever tracks the
+    // next source has. The message is emitted by the signal watch that the gstplayer adds on the bus.
+    GstBus *bus = gst_element_get_bus(playbin);
+    if (bus == nullptr) {
+        MEDIA_LOGE("get bus fail");
+        gst_object_unref(playbin);
+        return MSERR_INVALID_OPERATION;
+    }
+
+    bus_ = bus;
+    signalIdStreamStart_ = g_signal_connect(bus_, "message::stream-start", G_CALLBACK(OnStreamStartCb), this);
+    playbin_ = playbin;
+    signalIdAboutToFinish_ = g_signal_connect(playbin_, "about-to-finish", G_CALLBACK(OnAboutToFinishCb), this);
+    return MSERR_OK;
+}
+
+void GstPlayerCtrl::OnAboutToFinishCb(const GstElement *playbin, GstPlayerCtrl *playerGst)
+{
+    CHECK_AND_RETURN_LOG(playbin != nullptr, "playbin is null");
+    CHECK_AND_RETURN_LOG(playerGst != nullptr, "playerGst is null");
+    playerGst->ProcessAboutToFinish(playbin);
+}
+
+void GstPlayerCtrl::ProcessAboutToFinish(const GstElement *playbin)
+{
+    // called at the streaming thread, the uri must be set before return so the playbin prerolls it
+    // while the current source drains, and keeps the sinks running across the switch.
+    std::unique_lock<std::mutex> nextLock(nextMutex_);
+    aboutToFinish_ = true;
+    if (nextUrl_.empty()) {
+        return;
+    }
+
+    MEDIA_LOGI("about to finish, switch to the next source");
+    g_object_set(const_cast<GstElement *>(playbin), "uri", nextUrl_.c_str(), nullptr);
+    nextUrl_.clear();
+    switchPending_ = true;
+}
+
+void GstPlayerCtrl::OnStreamStartCb(const GstBus *bus, const GstMessage *msg, GstPlayerCtrl *playerGst)
+{
+    (void)bus;
+    CHECK_AND_RETURN_LOG(msg != nullptr, "msg is null");
+    CHECK_AND_RETURN_LOG(playerGst != nullptr, "playerGst is null");
+    playerGst->ProcessStreamStart();
+}
+
+void GstPlayerCtrl::ProcessStreamStart()
+{
+    std::unique_lock<std::mutex> nextLock(nextMutex_);
+    if (!switchPending_) {
+        return;
+    }
+
+    auto task = std::make_shared<TaskHandler<void>>([this] { OnNextSourceStart(); });
+    if (taskQue_.EnqueueTask(task) != 0) {
+        MEDIA_LOGE("notify next source start fail");
+        switchPending_ = false;
+    }
+}
+
+void GstPlayerCtrl::OnNextSourceStart()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    {
+        std::unique_lock<std::mutex> nextLock(nextMutex_);
+        CHECK_AND_RETURN(switchPending_);
+        switchPending_ = false;
+        aboutToFinish_ = false;
+    }
+    CHECK_AND_RETURN(!isExit_);
+
+    InitDuration();
+    MEDIA_LOGI("next source starts, duration %{public}" PRIu64 "", sourceDuration_);
+    std::shared_ptr<IPlayerEngineObs> tempObs = obs_.lock();
+    Format format;
+    if (tempObs != nullptr) {
+        tempObs->OnInfo(INFO_TYPE_NEXT_SOURCE_START, 0, format);
+    }
+}
+
+void GstPlayerCtrl::ResetNextSource()
+{
+    std::unique_lock<std::mutex> nextLock(nextMutex_);
+    nextUrl_.clear();
+    switchPending_ = false;
+    aboutToFinish_ = false;
+}
+
 int32_t GstPlayerCtrl::SetCallbacks(const std::weak_ptr<IPlayerEngineObs> &obs)
 {
     CHECK_AND_RETURN_RET_LOG(obs.lock() != nullptr,
@@ -312,6 +438,21 @@ int32_t GstPlayerCtrl::ChangeSeekModeToGstFlag(const PlayerSeekMode mode) const
     return flag;
 }
 
+int32_t GstPlayerCtrl::GetTrickModeFlag() const
+{
+    // only the key frames are decoded and the audio is dropped, which costs about one decode per GOP.
+    if (!trickMode_) {
+        return 0;
+    }
+    return GST_SEEK_FLAG_TRICKMODE | GST_SEEK_FLAG_TRICKMODE_KEY_UNITS | GST_SEEK_FLAG_TRICKMODE_NO_AUDIO;
+}
+
+bool GstPlayerCtrl::IsTrickModeRate(double rate)
+{
+    // the decoder can not keep up with every frame above the rate, and the reverse is played by key frames.
+    return rate < 0 || rate >= TRICK_MODE_MIN_RATE;
+}
+
 int32_t GstPlayerCtrl::Seek(uint64_t position, const PlayerSeekMode mode)
 {
     std::unique_lock<std::mutex> lock(mutex_);
@@ -325,6 +466,11 @@ int32_t GstPlayerCtrl::Seek(uint64_t position, const PlayerSeekMode mode)
     }
 
     position = (position > sourceDuration_) ? sourceDuration_ : position;
+    {
+        // the playbin asks the next source again after seek back, unless the switch is already pending
+        std::unique_lock<std::mutex> nextLock(nextMutex_);
+        aboutToFinish_ = false;
+    }
     auto task = std::make_shared<TaskHandler<void>>([this, position, mode] { SeekSync(position, mode); });
     if (taskQue_.EnqueueTask(task) != 0) {
         MEDIA_LOGE("Seek fail");
@@ -353,9 +499,14 @@ void GstPlayerCtrl::SeekSync(uint64_t position, const PlayerSeekMode mode)
     }
 
     CHECK_AND_RETURN_LOG(gstPlayer_ != nullptr, "gstPlayer_ is nullptr");
-    // need keep the seek and seek modes consistent.
-    g_object_set(gstPlayer_, "seek-mode", static_cast<gint>(ChangeSeekModeToGstFlag(mode)), nullptr);
+    // need keep the seek and seek modes consistent, and keep the trick mode after the seek.
+    int32_t flag = ChangeSeekModeToGstFlag(mode);
     GstClockTime time = static_cast<GstClockTime>(position * MICRO);
+    if (trickMode_) {
+        // the seek mode chosen in the trick mode is the one to restore when the trick mode ends
+        savedSeekMode_ = flag;
+    }
+    g_object_set(gstPlayer_, "seek-mode", static_cast<gint>(flag | GetTrickModeFlag()), nullptr);
     (void)GetPositionInner();
     seeking_ = true;
     gst_player_seek(gstPlayer_, time);
@@ -409,7 +560,14 @@ void GstPlayerCtrl::Stop()
     speeding_ = false;
     seeking_ = false;
     rate_ = DEFAULT_RATE;
+    appliedRate_ = DEFAULT_RATE;
+    if (trickMode_) {
+        g_object_set(gstPlayer_, "seek-mode", static_cast<gint>(savedSeekMode_), nullptr);
+    }
+    trickMode_ = false;
+    savedSeekMode_ = 0;
     lastTime_ = 0;
+    ResetNextSource();
     if (audioSink_ != nullptr) {
         g_signal_handler_disconnect(audioSink_, signalIdVolume_);
         signalIdVolume_ = 0;
@@ -565,8 +723,21 @@ void GstPlayerCtrl::SetRateSync(double rate)
 
     CHECK_AND_RETURN_LOG(gstPlayer_ != nullptr, "gstPlayer_ is nullptr");
     MEDIA_LOGD("SetRateSync in, rate=(%{public}lf)", rate);
+    bool trickMode = IsTrickModeRate(rate);
+    if (trickMode || trickMode_) {
+        if (!trickMode_) {
+            // restore the seek mode in use when the trick mode ends, not a default one
+            gint seekMode = 0;
+            g_object_get(gstPlayer_, "seek-mode", &seekMode, nullptr);
+            savedSeekMode_ = static_cast<int32_t>(seekMode);
+        }
+        trickMode_ = trickMode;
+        MEDIA_LOGI("trick mode %{public}d, rate=(%{public}lf)", trickMode_, rate);
+        g_object_set(gstPlayer_, "seek-mode", static_cast<gint>(savedSeekMode_ | GetTrickModeFlag()), nullptr);
+    }
     (void)GetPositionInner();
     speeding_ = true;
+    appliedRate_ = rate;
     gst_player_set_rate(gstPlayer_, static_cast<gdouble>(rate));
 
     condVarSeekSync_.wait(lock);
@@ -681,7 +852,8 @@ void GstPlayerCtrl::ProcessEndOfStream(const GstPlayer *cbPlayer)
         return;
     }
 
-    if (enableLooping_) {
+    // the reverse playback ends at the beginning, there is nothing to loop.
+    if (enableLooping_ && rate_ > 0) {
         (void)Seek(0, SEEK_PREVIOUS_SYNC);
     } else {
         Pause();
@@ -1064,6 +1236,7 @@ void GstPlayerCtrl::OnSeekDone()
         Format format;
         if (tempObs != nullptr) {
             if (speeding_) {
+                (void)format.PutDoubleValue(PlayerKeys::PLAYER_PLAYBACK_RATE, appliedRate_);
                 tempObs->OnInfo(INFO_TYPE_SPEEDDONE, 0, format);
                 speeding_ = false;
             } else {
@@ -1083,7 +1256,7 @@ void GstPlayerCtrl::OnEndOfStream()
         std::shared_ptr<IPlayerEngineObs> tempObs = obs_.lock();
         Format format;
         if (tempObs != nullptr) {
-            tempObs->OnInfo(INFO_TYPE_EOS, static_cast<int32_t>(enableLooping_), format);
+            tempObs->OnInfo(INFO_TYPE_EOS, static_cast<int32_t>(enableLooping_ && rate_ > 0), format);
         }
         endOfStreamCb_ = false;
     }
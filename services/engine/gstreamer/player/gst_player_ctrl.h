@@ -35,6 +35,7 @@ public:
 
     int32_t SetUrl(const std::string &url);
     int32_t SetSource(const std::shared_ptr<GstAppsrcWarp> &appsrcWarp);
+    int32_t SetNextUrl(const std::string &url);
     int32_t SetCallbacks(const std::weak_ptr<IPlayerEngineObs> &obs);
     void SetVideoTrack(bool enable);
     void Pause();
@@ -53,6 +54,7 @@ public:
     int32_t GetVideoWidth();
     int32_t GetVideoHeight();
     int32_t SetRate(double rate);
+    static bool IsTrickModeRate(double rate);
     double GetRate();
     PlayerStates GetState() const;
     void SetRingBufferMaxSize(uint64_t size);
@@ -78,10 +80,13 @@ public:
     static void OnBufferingTimeCb(const GstPlayer *player, guint64 bufferingTime, guint mqNumId,
         GstPlayerCtrl *playerGst);
     static void OnMqNumUseBufferingCb(const GstPlayer *player, guint mqNumUseBuffering, GstPlayerCtrl *playerGst);
+    static void OnAboutToFinishCb(const GstElement *playbin, GstPlayerCtrl *playerGst);
+    static void OnStreamStartCb(const GstBus *bus, const GstMessage *msg, GstPlayerCtrl *playerGst);
 private:
     PlayerStates ProcessStoppedState();
     PlayerStates ProcessPausedState();
     int32_t ChangeSeekModeToGstFlag(const PlayerSeekMode mode) const;
+    int32_t GetTrickModeFlag() const;
     void ProcessStateChanged(const GstPlayer *cbPlayer, GstPlayerState state);
     void ProcessSeekDone(const GstPlayer *cbPlayer, uint64_t position);
     void ProcessPositionUpdated(const GstPlayer *cbPlayer, uint64_t position);
@@ -108,6 +113,11 @@ private:
     void ProcessMqNumUseBuffering(const GstPlayer *cbPlayer, uint32_t mqNumUseBuffering);
     bool IsLiveMode() const;
     bool SetAudioRendererInfo(const Format &param);
+    int32_t InitGapless();
+    void ProcessAboutToFinish(const GstElement *playbin);
+    void ProcessStreamStart();
+    void OnNextSourceStart();
+    void ResetNextSource();
     std::mutex mutex_;
     std::condition_variable condVarPlaySync_;
     std::condition_variable condVarPauseSync_;
@@ -141,6 +151,8 @@ private:
     std::shared_ptr<ITaskHandler> seekTask_ = nullptr;
     std::shared_ptr<ITaskHandler> rateTask_ = nullptr;
     double rate_; // inited at the constructor
+    // the rate set to the gstplayer, reported with the speed done
+    double appliedRate_ = 1.0;
     uint64_t lastTime_ = 0;
     bool speeding_ = false;
     bool isExit_ = true;
@@ -150,6 +162,18 @@ private:
     int32_t videoWidth_ = 0;
     int32_t videoHeight_ = 0;
     bool isHardWare_ = false;
+    bool trickMode_ = false;
+    // the gstplayer seek mode before the trick mode, restored when it ends
+    int32_t savedSeekMode_ = 0;
+    // the gapless switch to the next source, nextMutex_ is taken after mutex_, and alone at the streaming threads
+    std::mutex nextMutex_;
+    std::string nextUrl_;
+    bool switchPending_ = false;
+    bool aboutToFinish_ = false;
+    GstElement *playbin_ = nullptr;
+    gulong signalIdAboutToFinish_ = 0;
+    GstBus *bus_ = nullptr;
+    gulong signalIdStreamStart_ = 0;
 };
 } // namespace Media
 } // namespace OHOS
@@ -0,0 +1,341 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gst_player_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include "media_errors.h"
+#include "media_log.h"
+#include "param_wrapper.h"
+
+namespace {
+    constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "GstPlayerPool"};
+    constexpr std::chrono::seconds BUILD_TIMEOUT(1);
+    constexpr int32_t DEFAULT_POOL_SIZE = 1;
+    constexpr int32_t MAX_POOL_SIZE = 4;
+    constexpr int32_t DEFAULT_MAX_IDLE_SEC = 60;
+    constexpr int32_t DEFAULT_MIN_FREE_MB = 256;
+    constexpr int64_t US_PER_SEC = 1000000;
+    constexpr int64_t KB_PER_MB = 1024;
+    // refill after the acquired instance prepared, not to compete with it
+    constexpr uint64_t REFILL_DELAY_US = 1000000;
+    constexpr uint64_t CHECK_IDLE_INTERVAL_US = 10000000;
+    constexpr size_t COST_WINDOW_SIZE = 128;
+    constexpr int32_t PERCENTILE_50 = 50;
+    constexpr int32_t PERCENTILE_90 = 90;
+    constexpr int32_t PERCENTILE_99 = 99;
+    constexpr int32_t PERCENTILE_MAX = 100;
+
+    int64_t GetNowUs()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+namespace OHOS {
+namespace Media {
+std::unique_ptr<GstPlayerInstance> GstPlayerInstance::Create(const sptr<Surface> &surface)
+{
+    std::unique_ptr<GstPlayerInstance> instance(new (std::nothrow) GstPlayerInstance());
+    CHECK_AND_RETURN_RET_LOG(instance != nullptr, nullptr, "new GstPlayerInstance failed");
+    CHECK_AND_RETURN_RET(instance->Init(surface) == MSERR_OK, nullptr);
+    return instance;
+}
+
+GstPlayerInstance::~GstPlayerInstance()
+{
+    Stop();
+    rendererCtrl_ = nullptr;
+    playerCtrl_ = nullptr;
+    playerBuild_ = nullptr;
+}
+
+int32_t GstPlayerInstance::Init(const sptr<Surface> &surface)
+{
+    playerThread_.reset(new(std::nothrow) std::thread(&GstPlayerInstance::PlayerLoop, this, surface));
+    CHECK_AND_RETURN_RET_LOG(playerThread_ != nullptr, MSERR_NO_MEMORY, "new std::thread failed.");
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        (void)cond_.wait_for(lock, BUILD_TIMEOUT, [this] { return buildDone_; });
+        if (playerCtrl_ == nullptr) {
+            MEDIA_LOGE("gstplayer initialized failed");
+            abort_ = true;
+            return MSERR_INVALID_VAL;
+        }
+    }
+
+    playerBuild_->WaitMainLoopStart();
+    return MSERR_OK;
+}
+
+void GstPlayerInstance::PlayerLoop(const sptr<Surface> &surface)
+{
+    MEDIA_LOGD("PlayerLoop in");
+    auto playerBuild = std::make_unique<GstPlayerBuild>();
+    auto rendererCtrl = playerBuild->BuildRendererCtrl(surface);
+    std::shared_ptr<GstPlayerCtrl> playerCtrl = nullptr;
+    if (rendererCtrl != nullptr) {
+        playerCtrl = playerBuild->BuildPlayerCtrl();
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        playerBuild_ = std::move(playerBuild);
+        rendererCtrl_ = rendererCtrl;
+        playerCtrl_ = playerCtrl;
+        buildDone_ = true;
+        cond_.notify_all();
+        // the waiter gives up if the build timeout, do not run the loop nobody will quit
+        CHECK_AND_RETURN_LOG(playerCtrl_ != nullptr && !abort_, "gstplayer build failed or aborted");
+    }
+
+    MEDIA_LOGD("Start the player loop");
+    playerBuild_->CreateLoop();
+    MEDIA_LOGD("Stop the player loop");
+}
+
+int32_t GstPlayerInstance::BindSurface(const sptr<Surface> &surface)
+{
+    CHECK_AND_RETURN_RET_LOG(playerBuild_ != nullptr, MSERR_INVALID_OPERATION, "playerBuild_ is nullptr");
+    return playerBuild_->BindSurface(surface);
+}
+
+void GstPlayerInstance::Stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        abort_ = true;
+        if (playerBuild_ != nullptr) {
+            playerBuild_->DestroyLoop();
+        }
+    }
+
+    if (playerThread_ != nullptr && playerThread_->joinable()) {
+        playerThread_->join();
+    }
+}
+
+void GstPlayerPool::CostWindow::Add(int64_t costUs)
+{
+    if (samples_.size() < COST_WINDOW_SIZE) {
+        samples_.push_back(costUs);
+    } else {
+        samples_[next_] = costUs;
+    }
+    next_ = (next_ + 1) % COST_WINDOW_SIZE;
+}
+
+void GstPlayerPool::CostWindow::Dump(const std::string &name, std::string &dumpString) const
+{
+    dumpString += "    " + name + ": ";
+    if (samples_.empty()) {
+        dumpString += "no sample\n";
+        return;
+    }
+
+    std::vector<int64_t> sorted = samples_;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](int32_t percent) {
+        return sorted[(sorted.size() - 1) * static_cast<size_t>(percent) / PERCENTILE_MAX];
+    };
+    dumpString += "samples " + std::to_string(sorted.size()) +
+        ", p50 " + std::to_string(percentile(PERCENTILE_50)) +
+        " us, p90 " + std::to_string(percentile(PERCENTILE_90)) +
+        " us, p99 " + std::to_string(percentile(PERCENTILE_99)) + " us\n";
+}
+
+GstPlayerPool &GstPlayerPool::GetInstance()
+{
+    static GstPlayerPool instance;
+    return instance;
+}
+
+GstPlayerPool::GstPlayerPool()
+    : taskQue_("GstPlayerPool")
+{
+    int32_t size = OHOS::system::GetIntParameter("sys.media.player.pool.size", DEFAULT_POOL_SIZE);
+    maxSize_ = static_cast<uint32_t>(std::clamp(size, 0, MAX_POOL_SIZE));
+    int32_t idleSec = OHOS::system::GetIntParameter("sys.media.player.pool.idle.sec", DEFAULT_MAX_IDLE_SEC);
+    maxIdleUs_ = static_cast<int64_t>(std::max(idleSec, 0)) * US_PER_SEC;
+    int32_t minFreeMb = OHOS::system::GetIntParameter("sys.media.player.pool.minfree.mb", DEFAULT_MIN_FREE_MB);
+    minFreeKb_ = static_cast<int64_t>(std::max(minFreeMb, 0)) * KB_PER_MB;
+    if (maxSize_ > 0) {
+        (void)taskQue_.Start();
+    }
+    MEDIA_LOGI("player pool size: %{public}u, max idle: %{public}d s, min free: %{public}d MB",
+        maxSize_, idleSec, minFreeMb);
+}
+
+GstPlayerPool::~GstPlayerPool()
+{
+    (void)taskQue_.Stop();
+    std::unique_lock<std::mutex> lock(mutex_);
+    idleInstances_.clear();
+}
+
+std::unique_ptr<GstPlayerInstance> GstPlayerPool::Acquire(const sptr<Surface> &surface, bool &warm)
+{
+    std::unique_ptr<GstPlayerInstance> instance = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        // take the newest one, the older ones are released first when idle
+        if (!idleInstances_.empty()) {
+            instance = std::move(idleInstances_.back().instance);
+            idleInstances_.pop_back();
+        }
+        ScheduleRefillLocked();
+    }
+
+    if (instance != nullptr && surface != nullptr && instance->BindSurface(surface) != MSERR_OK) {
+        MEDIA_LOGW("bind surface to the prebuilt instance failed, build a new one");
+        instance = nullptr;
+    }
+
+    warm = instance != nullptr;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (warm) {
+            hitCount_++;
+        } else {
+            missCount_++;
+        }
+    }
+
+    if (instance == nullptr) {
+        instance = GstPlayerInstance::Create(surface);
+    }
+    return instance;
+}
+
+void GstPlayerPool::RecordInitCost(bool warm, int64_t costUs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    (warm ? warmInitCost_ : coldInitCost_).Add(costUs);
+}
+
+void GstPlayerPool::RecordPrepareCost(bool warm, int64_t costUs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    (warm ? warmPrepareCost_ : coldPrepareCost_).Add(costUs);
+}
+
+void GstPlayerPool::DumpInfo(std::string &dumpString)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    dumpString += "GstPlayerPool: idle " + std::to_string(idleInstances_.size()) + "/" + std::to_string(maxSize_) +
+        ", hit " + std::to_string(hitCount_) + ", miss " + std::to_string(missCount_) +
+        ", trimmed " + std::to_string(trimCount_) + "\n";
+    warmInitCost_.Dump("init cost with the pool", dumpString);
+    coldInitCost_.Dump("init cost without the pool", dumpString);
+    warmPrepareCost_.Dump("prepare cost with the pool", dumpString);
+    coldPrepareCost_.Dump("prepare cost without the pool", dumpString);
+}
+
+void GstPlayerPool::ScheduleRefillLocked()
+{
+    if (refilling_ || idleInstances_.size() >= maxSize_) {
+        return;
+    }
+
+    auto task = std::make_shared<TaskHandler<void>>([this] { Refill(); });
+    CHECK_AND_RETURN_LOG(taskQue_.EnqueueTask(task, false, REFILL_DELAY_US) == MSERR_OK, "enqueue refill failed");
+    refilling_ = true;
+}
+
+void GstPlayerPool::ScheduleCheckIdleLocked()
+{
+    if (checkingIdle_ || idleInstances_.empty()) {
+        return;
+    }
+
+    auto task = std::make_shared<TaskHandler<void>>([this] { CheckIdle(); });
+    CHECK_AND_RETURN_LOG(taskQue_.EnqueueTask(task, false, CHECK_IDLE_INTERVAL_US) == MSERR_OK,
+        "enqueue idle check failed");
+    checkingIdle_ = true;
+}
+
+void GstPlayerPool::Refill()
+{
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (idleInstances_.size() >= maxSize_ || IsMemoryLow()) {
+                refilling_ = false;
+                return;
+            }
+        }
+
+        int64_t startUs = GetNowUs();
+        auto instance = GstPlayerInstance::Create(nullptr);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (instance == nullptr) {
+            MEDIA_LOGE("prebuild player instance failed");
+            refilling_ = false;
+            return;
+        }
+        int64_t nowUs = GetNowUs();
+        MEDIA_LOGI("prebuild player instance cost %{public}" PRId64 " us", nowUs - startUs);
+        idleInstances_.push_back({ std::move(instance), nowUs });
+        ScheduleCheckIdleLocked();
+    }
+}
+
+void GstPlayerPool::CheckIdle()
+{
+    std::deque<IdleInstance> expired;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        checkingIdle_ = false;
+        bool memoryLow = IsMemoryLow();
+        int64_t nowUs = GetNowUs();
+        while (!idleInstances_.empty() &&
+            (memoryLow || nowUs - idleInstances_.front().idleSinceUs >= maxIdleUs_)) {
+            expired.push_back(std::move(idleInstances_.front()));
+            idleInstances_.pop_front();
+        }
+        trimCount_ += expired.size();
+        ScheduleCheckIdleLocked();
+    }
+
+    if (!expired.empty()) {
+        MEDIA_LOGI("release %{public}zu idle player instances", expired.size());
+    }
+}
+
+bool GstPlayerPool::IsMemoryLow() const
+{
+    if (minFreeKb_ == 0) {
+        return false;
+    }
+
+    std::ifstream meminfo("/proc/meminfo");
+    std::string line;
+    while (std::getline(meminfo, line)) {
+        std::istringstream fields(line);
+        std::string key;
+        int64_t valueKb = 0;
+        if ((fields >> key >> valueKb) && key == "MemAvailable:") {
+            return valueKb < minFreeKb_;
+        }
+    }
+    return false;
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GST_PLAYER_POOL_H
+#define GST_PLAYER_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "gst_player_build.h"
+#include "task_queue.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * The gstplayer with its renderer and the thread running its main loop. The instance is built
+ * without the source, so it can be built before it is used.
+ */
+class GstPlayerInstance : public NoCopyable {
+public:
+    static std::unique_ptr<GstPlayerInstance> Create(const sptr<Surface> &surface);
+    ~GstPlayerInstance();
+
+    // bind the surface to the instance built without surface
+    int32_t BindSurface(const sptr<Surface> &surface);
+    // quit the main loop and wait the thread exit, the ctrls must be released after it
+    void Stop();
+
+    std::shared_ptr<GstPlayerCtrl> GetPlayerCtrl() const
+    {
+        return playerCtrl_;
+    }
+
+    std::shared_ptr<GstPlayerVideoRendererCtrl> GetRendererCtrl() const
+    {
+        return rendererCtrl_;
+    }
+
+private:
+    GstPlayerInstance() = default;
+    int32_t Init(const sptr<Surface> &surface);
+    void PlayerLoop(const sptr<Surface> &surface);
+
+    std::unique_ptr<GstPlayerBuild> playerBuild_ = nullptr;
+    std::shared_ptr<GstPlayerCtrl> playerCtrl_ = nullptr;
+    std::shared_ptr<GstPlayerVideoRendererCtrl> rendererCtrl_ = nullptr;
+    std::unique_ptr<std::thread> playerThread_ = nullptr;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    bool buildDone_ = false;
+    bool abort_ = false;
+};
+
+/**
+ * Keep a few instances built ahead of time, so the prepare does not wait the gstplayer and its
+ * main loop to be created. The pool is filled after the first instance acquired, the idle
+ * instances are released after a while or when the available memory is low.
+ */
+class GstPlayerPool : public NoCopyable {
+public:
+    static GstPlayerPool &GetInstance();
+
+    /**
+     * Get a prebuilt instance, or build a new one if the pool is empty.
+     * @param warm set to true if the instance comes from the pool.
+     */
+    std::unique_ptr<GstPlayerInstance> Acquire(const sptr<Surface> &surface, bool &warm);
+    void RecordInitCost(bool warm, int64_t costUs);
+    void RecordPrepareCost(bool warm, int64_t costUs);
+    void DumpInfo(std::string &dumpString);
+
+private:
+    struct IdleInstance {
+        std::unique_ptr<GstPlayerInstance> instance;
+        int64_t idleSinceUs = 0;
+    };
+
+    class CostWindow {
+    public:
+        void Add(int64_t costUs);
+        void Dump(const std::string &name, std::string &dumpString) const;
+    private:
+        std::vector<int64_t> samples_;
+        size_t next_ = 0;
+    };
+
+    GstPlayerPool();
+    ~GstPlayerPool();
+    void ScheduleRefillLocked();
+    void ScheduleCheckIdleLocked();
+    void Refill();
+    void CheckIdle();
+    bool IsMemoryLow() const;
+
+    std::mutex mutex_;
+    std::deque<IdleInstance> idleInstances_;
+    uint32_t maxSize_ = 0;
+    int64_t maxIdleUs_ = 0;
+    int64_t minFreeKb_ = 0;
+    bool refilling_ = false;
+    bool checkingIdle_ = false;
+    uint64_t hitCount_ = 0;
+    uint64_t missCount_ = 0;
+    uint64_t trimCount_ = 0;
+    CostWindow warmInitCost_;
+    CostWindow coldInitCost_;
+    CostWindow warmPrepareCost_;
+    CostWindow coldPrepareCost_;
+    TaskQueue taskQue_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // GST_PLAYER_POOL_H
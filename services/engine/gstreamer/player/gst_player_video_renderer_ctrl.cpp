@@ -257,6 +257,14 @@ int32_t GstPlayerVideoRendererCtrl::InitVideoSink(const GstElement *playbin)
     return MSERR_OK;
 }
 
+int32_t GstPlayerVideoRendererCtrl::BindSurface(const sptr<Surface> &surface, const GstElement *playbin)
+{
+    CHECK_AND_RETURN_RET_LOG(surface != nullptr, MSERR_INVALID_VAL, "surface is nullptr");
+    CHECK_AND_RETURN_RET_LOG(producerSurface_ == nullptr, MSERR_INVALID_OPERATION, "surface is bound already");
+    producerSurface_ = surface;
+    return InitVideoSink(playbin);
+}
+
 const sptr<Surface> GstPlayerVideoRendererCtrl::GetProducerSurface() const
 {
     return producerSurface_;
@@ -33,6 +33,8 @@ public:
 
     int32_t InitVideoSink(const GstElement *playbin);
     int32_t InitAudioSink(const GstElement *playbin);
+    // bind the surface to the renderer built without surface, the playbin must be at the NULL state
+    int32_t BindSurface(const sptr<Surface> &surface, const GstElement *playbin);
     const GstElement *GetVideoSink() const;
     const GstElement *GetAudioSink() const;
     const sptr<Surface> GetProducerSurface() const;
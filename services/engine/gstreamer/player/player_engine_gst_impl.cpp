@@ -16,12 +16,19 @@
 #include "player_engine_gst_impl.h"
 
 #include <unistd.h>
+#include <chrono>
 #include "media_log.h"
 #include "media_errors.h"
 #include "directory_ex.h"
 
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "PlayerEngineGstImpl"};
+
+    int64_t GetCostUs(const std::chrono::steady_clock::time_point &startTime)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startTime).count();
+    }
 }
 
 namespace OHOS {
@@ -32,9 +39,51 @@ constexpr float SPEED_1_00_X = 1.00;
 constexpr float SPEED_1_25_X = 1.25;
 constexpr float SPEED_1_75_X = 1.75;
 constexpr float SPEED_2_00_X = 2.00;
+constexpr float SPEED_4_00_X = 4.00;
+constexpr float SPEED_8_00_X = 8.00;
+constexpr float SPEED_16_00_X = 16.00;
 constexpr size_t MAX_URI_SIZE = 4096;
 constexpr uint64_t RING_BUFFER_MAX_SIZE = 5242880; // 5 * 1024 * 1024
 
+void PlayerPrepareCostObs::OnError(PlayerErrorType errorType, int32_t errorCode)
+{
+    Cancel();
+    std::shared_ptr<IPlayerEngineObs> tempObs = obs_.lock();
+    if (tempObs != nullptr) {
+        tempObs->OnError(errorType, errorCode);
+    }
+}
+
+void PlayerPrepareCostObs::OnInfo(PlayerOnInfoType type, int32_t extra, const Format &infoBody)
+{
+    if (type == INFO_TYPE_STATE_CHANGE && extra == PLAYER_PREPARED) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (pending_) {
+            pending_ = false;
+            GstPlayerPool::GetInstance().RecordPrepareCost(warm_, GetCostUs(startTime_));
+        }
+    }
+
+    std::shared_ptr<IPlayerEngineObs> tempObs = obs_.lock();
+    if (tempObs != nullptr) {
+        tempObs->OnInfo(type, extra, infoBody);
+    }
+}
+
+void PlayerPrepareCostObs::Start(const std::chrono::steady_clock::time_point &startTime, bool warm)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    startTime_ = startTime;
+    warm_ = warm;
+    pending_ = true;
+}
+
+void PlayerPrepareCostObs::Cancel()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    pending_ = false;
+}
+
 PlayerEngineGstImpl::PlayerEngineGstImpl()
 {
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances create", FAKE_POINTER(this));
@@ -105,10 +154,30 @@ int32_t PlayerEngineGstImpl::SetSource(const std::shared_ptr<IMediaDataSource> &
     return MSERR_OK;
 }
 
+int32_t PlayerEngineGstImpl::SetNextSource(const std::string &url)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(playerCtrl_ != nullptr, MSERR_INVALID_OPERATION, "playerCtrl_ is nullptr");
+    CHECK_AND_RETURN_RET_LOG(appsrcWarp_ == nullptr, MSERR_INVALID_OPERATION, "not support for the data source");
+    CHECK_AND_RETURN_RET_LOG(url.length() <= MAX_URI_SIZE, MSERR_INVALID_VAL, "input url length is invalid!");
+
+    std::string nextUrl = url;
+    if (IsFileUrl(url)) {
+        std::string realUriPath;
+        int32_t ret = GetRealPath(url, realUriPath);
+        CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
+        nextUrl = "file://" + realUriPath;
+    }
+
+    MEDIA_LOGD("set player next source: %{public}s", nextUrl.c_str());
+    return playerCtrl_->SetNextUrl(nextUrl);
+}
+
 int32_t PlayerEngineGstImpl::SetObs(const std::weak_ptr<IPlayerEngineObs> &obs)
 {
     std::unique_lock<std::mutex> lock(mutex_);
     obs_ = obs;
+    prepareObs_ = std::make_shared<PlayerPrepareCostObs>(obs);
     return MSERR_OK;
 }
 
@@ -125,6 +194,7 @@ int32_t PlayerEngineGstImpl::Prepare()
 {
     std::unique_lock<std::mutex> lock(mutex_);
     MEDIA_LOGD("Prepare in");
+    auto startTime = std::chrono::steady_clock::now();
 
     int32_t ret = GstPlayerInit();
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, MSERR_INVALID_VAL, "GstPlayerInit failed");
@@ -137,6 +207,7 @@ int32_t PlayerEngineGstImpl::Prepare()
         GstPlayerDeInit();
         return MSERR_INVALID_VAL;
     }
+    GstPlayerPool::GetInstance().RecordPrepareCost(warmInstance_, GetCostUs(startTime));
 
     // The duration of some resources without header information cannot be obtained.
     MEDIA_LOGD("Prepared ok out");
@@ -147,11 +218,16 @@ int32_t PlayerEngineGstImpl::PrepareAsync()
 {
     std::unique_lock<std::mutex> lock(mutex_);
     MEDIA_LOGD("Prepare in");
+    auto startTime = std::chrono::steady_clock::now();
 
     int32_t ret = GstPlayerInit();
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, MSERR_INVALID_VAL, "GstPlayerInit failed");
 
     CHECK_AND_RETURN_RET_LOG(playerCtrl_ != nullptr, MSERR_INVALID_VAL, "playerCtrl_ is nullptr");
+    // the prepared state is reported on the main loop, record the cost there
+    if (prepareObs_ != nullptr) {
+        prepareObs_->Start(startTime, warmInstance_);
+    }
     playerCtrl_->PrepareAsync();
 
     // The duration of some resources without header information cannot be obtained.
@@ -159,25 +235,6 @@ int32_t PlayerEngineGstImpl::PrepareAsync()
     return MSERR_OK;
 }
 
-void PlayerEngineGstImpl::PlayerLoop()
-{
-    MEDIA_LOGD("PlayerLoop in");
-    playerBuild_ = std::make_unique<GstPlayerBuild>();
-    CHECK_AND_RETURN_LOG(playerBuild_ != nullptr, "playerBuild_ is nullptr");
-
-    rendererCtrl_ = playerBuild_->BuildRendererCtrl(producerSurface_);
-    CHECK_AND_RETURN_LOG(rendererCtrl_ != nullptr, "rendererCtrl_ is nullptr");
-
-    playerCtrl_ = playerBuild_->BuildPlayerCtrl();
-    CHECK_AND_RETURN_LOG(playerCtrl_ != nullptr, "playerCtrl_ is nullptr");
-
-    condVarSync_.notify_all();
-
-    MEDIA_LOGD("Start the player loop");
-    playerBuild_->CreateLoop();
-    MEDIA_LOGD("Stop the player loop");
-}
-
 int32_t PlayerEngineGstImpl::GstPlayerInit()
 {
     if (gstPlayerInit_) {
@@ -185,19 +242,15 @@ int32_t PlayerEngineGstImpl::GstPlayerInit()
     }
 
     MEDIA_LOGD("GstPlayerInit in");
-    playerThread_.reset(new(std::nothrow) std::thread(&PlayerEngineGstImpl::PlayerLoop, this));
-    CHECK_AND_RETURN_RET_LOG(playerThread_ != nullptr, MSERR_NO_MEMORY, "new std::thread failed.");
-
-    if (!playerCtrl_) {
-        MEDIA_LOGD("Player not yet initialized, wait for 1 second");
-        std::unique_lock<std::mutex> lockSync(mutexSync_);
-        (void)condVarSync_.wait_for(lockSync, std::chrono::seconds(1));
-        if (playerCtrl_ == nullptr) {
-            MEDIA_LOGE("gstplayer initialized failed");
-            GstPlayerDeInit();
-            return MSERR_INVALID_VAL;
-        }
+    auto startTime = std::chrono::steady_clock::now();
+    playerInstance_ = GstPlayerPool::GetInstance().Acquire(producerSurface_, warmInstance_);
+    if (playerInstance_ == nullptr) {
+        MEDIA_LOGE("gstplayer initialized failed");
+        GstPlayerDeInit();
+        return MSERR_INVALID_VAL;
     }
+    playerCtrl_ = playerInstance_->GetPlayerCtrl();
+    rendererCtrl_ = playerInstance_->GetRendererCtrl();
 
     int ret = GstPlayerPrepare();
     if (ret != MSERR_OK) {
@@ -206,26 +259,27 @@ int32_t PlayerEngineGstImpl::GstPlayerInit()
         return MSERR_INVALID_VAL;
     }
 
-    playerBuild_->WaitMainLoopStart();
-
-    MEDIA_LOGD("GstPlayerInit out");
+    int64_t costUs = GetCostUs(startTime);
+    GstPlayerPool::GetInstance().RecordInitCost(warmInstance_, costUs);
+    MEDIA_LOGD("GstPlayerInit out, warm: %{public}d, cost: %{public}" PRId64 " us", warmInstance_, costUs);
     gstPlayerInit_ = true;
     return MSERR_OK;
 }
 
 void PlayerEngineGstImpl::GstPlayerDeInit()
 {
-    if (playerBuild_ != nullptr) {
-        playerBuild_->DestroyLoop();
+    if (prepareObs_ != nullptr) {
+        prepareObs_->Cancel();
     }
 
-    if (playerThread_ != nullptr && playerThread_->joinable()) {
-        playerThread_->join();
+    // the ctrls are shared with the instance, release them after the main loop stopped
+    if (playerInstance_ != nullptr) {
+        playerInstance_->Stop();
     }
 
     rendererCtrl_ = nullptr;
     playerCtrl_ = nullptr;
-    playerBuild_ = nullptr;
+    playerInstance_ = nullptr;
     gstPlayerInit_ = false;
     appsrcWarp_ = nullptr;
 }
@@ -247,7 +301,11 @@ int32_t PlayerEngineGstImpl::GstPlayerPrepare() const
     ret = rendererCtrl_->SetCallbacks(obs_);
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, MSERR_INVALID_VAL, "SetCallbacks failed");
 
-    ret = playerCtrl_->SetCallbacks(obs_);
+    if (prepareObs_ != nullptr) {
+        ret = playerCtrl_->SetCallbacks(prepareObs_);
+    } else {
+        ret = playerCtrl_->SetCallbacks(obs_);
+    }
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, MSERR_INVALID_VAL, "SetCallbacks failed");
 
     if (producerSurface_ == nullptr) {
@@ -354,6 +412,20 @@ double PlayerEngineGstImpl::ChangeModeToSpeed(const PlaybackRateMode &mode) cons
             return SPEED_1_75_X;
         case SPEED_FORWARD_2_00_X:
             return SPEED_2_00_X;
+        case SPEED_FORWARD_4_00_X:
+            return SPEED_4_00_X;
+        case SPEED_FORWARD_8_00_X:
+            return SPEED_8_00_X;
+        case SPEED_FORWARD_16_00_X:
+            return SPEED_16_00_X;
+        case SPEED_BACKWARD_1_00_X:
+            return -SPEED_1_00_X;
+        case SPEED_BACKWARD_4_00_X:
+            return -SPEED_4_00_X;
+        case SPEED_BACKWARD_8_00_X:
+            return -SPEED_8_00_X;
+        case SPEED_BACKWARD_16_00_X:
+            return -SPEED_16_00_X;
         default:
             MEDIA_LOGW("unknown mode:%{public}d, return default speed(SPEED_1_00_X)", mode);
     }
@@ -378,6 +450,27 @@ PlaybackRateMode PlayerEngineGstImpl::ChangeSpeedToMode(double rate) const
     if (abs(rate - SPEED_2_00_X) < EPSINON) {
         return SPEED_FORWARD_2_00_X;
     }
+    if (abs(rate - SPEED_4_00_X) < EPSINON) {
+        return SPEED_FORWARD_4_00_X;
+    }
+    if (abs(rate - SPEED_8_00_X) < EPSINON) {
+        return SPEED_FORWARD_8_00_X;
+    }
+    if (abs(rate - SPEED_16_00_X) < EPSINON) {
+        return SPEED_FORWARD_16_00_X;
+    }
+    if (abs(rate + SPEED_1_00_X) < EPSINON) {
+        return SPEED_BACKWARD_1_00_X;
+    }
+    if (abs(rate + SPEED_4_00_X) < EPSINON) {
+        return SPEED_BACKWARD_4_00_X;
+    }
+    if (abs(rate + SPEED_8_00_X) < EPSINON) {
+        return SPEED_BACKWARD_8_00_X;
+    }
+    if (abs(rate + SPEED_16_00_X) < EPSINON) {
+        return SPEED_BACKWARD_16_00_X;
+    }
 
     MEDIA_LOGW("unknown rate:%{public}lf, return default speed(SPEED_FORWARD_1_00_X)", rate);
 
@@ -389,6 +482,9 @@ int32_t PlayerEngineGstImpl::SetPlaybackSpeed(PlaybackRateMode mode)
     std::unique_lock<std::mutex> lock(mutex_);
     if (playerCtrl_ != nullptr) {
         double rate = ChangeModeToSpeed(mode);
+        // the trick modes only render the key frames, nothing is left to play without the video
+        CHECK_AND_RETURN_RET_LOG(!GstPlayerCtrl::IsTrickModeRate(rate) || producerSurface_ != nullptr,
+            MSERR_INVALID_OPERATION, "trick mode rate %{public}lf needs the video", rate);
         return playerCtrl_->SetRate(rate);
     }
     return MSERR_OK;
@@ -424,6 +520,15 @@ int32_t PlayerEngineGstImpl::SetParameter(const Format &param)
     return MSERR_OK;
 }
 
+void PlayerEngineGstImpl::DumpInfo(std::string &dumpString)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (appsrcWarp_ != nullptr) {
+        appsrcWarp_->DumpInfo(dumpString);
+    }
+    GstPlayerPool::GetInstance().DumpInfo(dumpString);
+}
+
 int32_t PlayerEngineGstImpl::Stop()
 {
     std::unique_lock<std::mutex> lock(mutex_);
@@ -20,14 +20,38 @@
 #include <cstdint>
 #include <thread>
 #include <map>
+#include <chrono>
 
 #include "i_player_engine.h"
 #include "gst_player_build.h"
 #include "gst_player_ctrl.h"
+#include "gst_player_pool.h"
 #include "gst_appsrc_warp.h"
 
 namespace OHOS {
 namespace Media {
+/**
+ * Forward the engine events to the observer of the engine, and record the cost from PrepareAsync to
+ * the prepared state, which can not be measured inside the asynchronous call.
+ */
+class PlayerPrepareCostObs : public IPlayerEngineObs, public NoCopyable {
+public:
+    explicit PlayerPrepareCostObs(const std::weak_ptr<IPlayerEngineObs> &obs) : obs_(obs) {}
+    ~PlayerPrepareCostObs() = default;
+
+    void OnError(PlayerErrorType errorType, int32_t errorCode) override;
+    void OnInfo(PlayerOnInfoType type, int32_t extra, const Format &infoBody) override;
+    void Start(const std::chrono::steady_clock::time_point &startTime, bool warm);
+    void Cancel();
+
+private:
+    std::mutex mutex_;
+    std::weak_ptr<IPlayerEngineObs> obs_;
+    std::chrono::steady_clock::time_point startTime_;
+    bool warm_ = false;
+    bool pending_ = false;
+};
+
 class PlayerEngineGstImpl : public IPlayerEngine, public NoCopyable {
 public:
     PlayerEngineGstImpl();
@@ -35,6 +59,7 @@ public:
 
     int32_t SetSource(const std::string &url) override;
     int32_t SetSource(const std::shared_ptr<IMediaDataSource> &dataSrc) override;
+    int32_t SetNextSource(const std::string &url) override;
     int32_t SetObs(const std::weak_ptr<IPlayerEngineObs> &obs) override;
     int32_t SetVideoSurface(sptr<Surface> surface) override;
     int32_t Prepare() override;
@@ -54,6 +79,7 @@ public:
     int32_t SetPlaybackSpeed(PlaybackRateMode mode) override;
     int32_t GetPlaybackSpeed(PlaybackRateMode &mode) override;
     int32_t SetParameter(const Format &param) override;
+    void DumpInfo(std::string &dumpString) override;
     int32_t SetLooping(bool loop) override;
 
 private:
@@ -61,21 +87,19 @@ private:
     PlaybackRateMode ChangeSpeedToMode(double rate) const;
     int32_t GstPlayerInit();
     int32_t GstPlayerPrepare() const;
-    void PlayerLoop();
     void GstPlayerDeInit();
     int32_t GetRealPath(const std::string &url, std::string &realUrlPath) const;
     bool IsFileUrl(const std::string &url) const;
     std::mutex mutex_;
-    std::mutex mutexSync_;
-    std::unique_ptr<GstPlayerBuild> playerBuild_ = nullptr;
+    std::unique_ptr<GstPlayerInstance> playerInstance_ = nullptr;
+    bool warmInstance_ = false;
     std::shared_ptr<GstPlayerCtrl> playerCtrl_ = nullptr;
     std::shared_ptr<GstPlayerVideoRendererCtrl> rendererCtrl_ = nullptr;
     std::weak_ptr<IPlayerEngineObs> obs_;
+    std::shared_ptr<PlayerPrepareCostObs> prepareObs_ = nullptr;
     sptr<Surface> producerSurface_ = nullptr;
     std::string url_ = "";
-    std::condition_variable condVarSync_;
     bool gstPlayerInit_ = false;
-    std::unique_ptr<std::thread> playerThread_;
     std::shared_ptr<GstAppsrcWarp> appsrcWarp_ = nullptr;
 };
 } // namespace Media
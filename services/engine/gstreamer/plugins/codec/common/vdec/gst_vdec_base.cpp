@@ -165,6 +165,10 @@ static void gst_vdec_base_init(GstVdecBase *self)
     self->rect = {0};
     self->inpool = nullptr;
     self->outpool = nullptr;
+    self->video_meta_supported = FALSE;
+    self->nostride_pool = nullptr;
+    self->nostride_allocator = gst_shmem_allocator_new();
+    gst_video_info_init(&self->nostride_info);
 }
 
 static void gst_vdec_base_finalize(GObject *object)
@@ -191,6 +195,14 @@ static void gst_vdec_base_finalize(GObject *object)
         gst_object_unref(self->outpool);
         self->outpool = nullptr;
     }
+    if (self->nostride_pool) {
+        gst_object_unref(self->nostride_pool);
+        self->nostride_pool = nullptr;
+    }
+    if (self->nostride_allocator) {
+        gst_object_unref(self->nostride_allocator);
+        self->nostride_allocator = nullptr;
+    }
     self->input.av_shmem_pool = nullptr;
     self->output.av_shmem_pool = nullptr;
     G_OBJECT_CLASS(parent_class)->finalize(object);
@@ -235,6 +247,9 @@ static GstStateChangeReturn gst_vdec_base_change_state(GstElement *element, GstS
     switch (transition) {
         case GST_STATE_CHANGE_PAUSED_TO_READY:
             gst_buffer_pool_set_active(self->outpool, FALSE);
+            if (self->nostride_pool != nullptr) {
+                gst_buffer_pool_set_active(self->nostride_pool, FALSE);
+            }
             GST_VIDEO_DECODER_STREAM_LOCK(self);
             if (self->decoder != nullptr) {
                 (void)self->decoder->Flush(GST_CODEC_ALL);
@@ -789,13 +804,18 @@ static void update_video_meta(const GstVdecBase *self, GstBuffer *buffer)
     g_return_if_fail(buffer != nullptr);
     GstVideoMeta *video_meta = gst_buffer_get_video_meta(buffer);
     if (video_meta == nullptr) {
-        gst_buffer_add_video_meta(buffer, GST_VIDEO_FRAME_FLAG_NONE, self->format, self->width, self->height);
+        gint stride[GST_VIDEO_MAX_PLANES] = { self->stride, self->stride, 0, 0 };
+        gsize offset[GST_VIDEO_MAX_PLANES] = { 0, (gsize)self->stride * self->stride_height, 0, 0 };
+        static const gint nplane = 2; // nv12 or nv21 planes count
+        gst_buffer_add_video_meta_full(buffer, GST_VIDEO_FRAME_FLAG_NONE, self->format,
+            self->width, self->height, nplane, offset, stride);
     } else {
         video_meta->width = self->width;
         video_meta->height = self->height;
         video_meta->offset[0] = 0;
         video_meta->stride[0] = self->stride;
         video_meta->offset[1] = video_meta->stride[0] * self->stride_height;
+        video_meta->stride[1] = self->stride;
     }
 }
 
@@ -825,57 +845,128 @@ static GstVideoCodecFrame *gst_vdec_base_new_frame(GstVdecBase *self)
 
     return frame;
 }
-// copy for avshmem
-static void copy_to_no_stride_buffer(GstVdecBase *self, GstVideoCodecFrame *frame)
+
+static GstBufferPool *gst_vdec_base_new_nostride_pool(GstVdecBase *self, GstVideoInfo *info)
 {
-    if (self->memtype == GST_MEMTYPE_SURFACE) {
-        return;
+    GstCaps *caps = gst_video_info_to_caps(info);
+    g_return_val_if_fail(caps != nullptr, nullptr);
+    ON_SCOPE_EXIT(0) { gst_caps_unref(caps); };
+    GstShMemPool *pool = gst_shmem_pool_new();
+    g_return_val_if_fail(pool != nullptr, nullptr);
+    ON_SCOPE_EXIT(1) { gst_object_unref(pool); };
+    g_return_val_if_fail(self->nostride_allocator != nullptr, nullptr);
+
+    auto av_shmem_pool = std::make_shared<OHOS::Media::AVSharedMemoryPool>("vdec_nostride");
+    (void)gst_shmem_pool_set_avshmempool(pool, av_shmem_pool);
+    (void)gst_shmem_allocator_set_pool(self->nostride_allocator, av_shmem_pool);
+    GstStructure *config = gst_buffer_pool_get_config(GST_BUFFER_POOL_CAST(pool));
+    g_return_val_if_fail(config != nullptr, nullptr);
+    GstAllocationParams params;
+    gst_allocation_params_init(&params);
+    gst_buffer_pool_config_set_allocator(config, GST_ALLOCATOR_CAST(self->nostride_allocator), &params);
+    gst_buffer_pool_config_set_params(config, caps, (guint)GST_VIDEO_INFO_SIZE(info), 0, self->out_buffer_max_cnt);
+    g_return_val_if_fail(gst_buffer_pool_set_config(GST_BUFFER_POOL_CAST(pool), config), nullptr);
+    g_return_val_if_fail(gst_buffer_pool_set_active(GST_BUFFER_POOL_CAST(pool), TRUE), nullptr);
+    CANCEL_SCOPE_EXIT_GUARD(1);
+    return GST_BUFFER_POOL(pool);
+}
+
+static GstBuffer *gst_vdec_base_acquire_nostride_buffer(GstVdecBase *self)
+{
+    GstVideoInfo info;
+    gst_video_info_init(&info);
+    g_return_val_if_fail(gst_video_info_set_format(&info, self->format, self->width, self->height), nullptr);
+
+    // the pool is kept until the output format changes, so the shared memory is reused between frames.
+    if (self->nostride_pool == nullptr || !gst_video_info_is_equal(&info, &self->nostride_info)) {
+        self->nostride_info = info;
+        GstBufferPool *pool = gst_vdec_base_new_nostride_pool(self, &self->nostride_info);
+        // the flush start reads the pool from the other thread
+        GST_OBJECT_LOCK(self);
+        GstBufferPool *old_pool = self->nostride_pool;
+        self->nostride_pool = pool;
+        GST_OBJECT_UNLOCK(self);
+        if (old_pool != nullptr) {
+            gst_buffer_pool_set_active(old_pool, FALSE);
+            gst_object_unref(old_pool);
+        }
+        g_return_val_if_fail(self->nostride_pool != nullptr, nullptr);
+    } else if (!gst_buffer_pool_is_active(self->nostride_pool)) {
+        g_return_val_if_fail(gst_buffer_pool_set_active(self->nostride_pool, TRUE), nullptr);
     }
-    GstBuffer *src_buffer = frame->output_buffer;
-    frame->output_buffer = nullptr;
-    ON_SCOPE_EXIT(0) { gst_buffer_unref(src_buffer); };
-    // yuv buffer size
-    guint size = (guint)(self->width * self->height * 3 / 2);
+
+    GstBuffer *buffer = nullptr;
+    GstFlowReturn ret = gst_buffer_pool_acquire_buffer(self->nostride_pool, &buffer, nullptr);
+    g_return_val_if_fail(ret == GST_FLOW_OK && buffer != nullptr, nullptr);
+    return buffer;
+}
+
+// libc memcpy is already vectorized, so copy the whole plane at once when there is no padding.
+static gboolean gst_vdec_base_copy_plane(guint8 *dst, guint dst_stride, const guint8 *src, guint src_stride,
+    guint row_bytes, guint rows)
+{
+    if (dst_stride == row_bytes && src_stride == row_bytes) {
+        return memcpy_s(dst, (gsize)dst_stride * rows, src, (gsize)row_bytes * rows) == EOK;
+    }
+    for (guint row = 0; row < rows; row++) {
+        if (memcpy_s(dst, dst_stride, src, row_bytes) != EOK) {
+            return FALSE;
+        }
+        dst += dst_stride;
+        src += src_stride;
+    }
+    return TRUE;
+}
+
+static gboolean gst_vdec_base_copy_planes(GstVdecBase *self, GstBuffer *dst_buffer, GstBuffer *src_buffer)
+{
+    const GstVideoInfo *info = &self->nostride_info;
     guint stride = (guint)(self->real_stride == 0 ? self->stride : self->real_stride);
     guint stride_height = (guint)(self->real_stride_height == 0 ? self->stride_height : self->real_stride_height);
-    guint offset = stride * stride_height;
-    GstBuffer *dts_buffer = gst_buffer_new_allocate(nullptr, size, nullptr);
-    g_return_if_fail(dts_buffer != nullptr);
-    frame->output_buffer = dts_buffer;
+    guint src_offset[] = { 0, stride * stride_height };
+    static const guint nplane = 2; // nv12 or nv21 planes count
+    g_return_val_if_fail(GST_VIDEO_INFO_N_PLANES(info) == nplane, FALSE);
 
-    GstMapInfo dts_map = GST_MAP_INFO_INIT;
-    if (gst_buffer_map(dts_buffer, &dts_map, GST_MAP_WRITE) != TRUE) {
+    GstMapInfo dst_map = GST_MAP_INFO_INIT;
+    g_return_val_if_fail(gst_buffer_map(dst_buffer, &dst_map, GST_MAP_WRITE), FALSE);
+    ON_SCOPE_EXIT(0) { gst_buffer_unmap(dst_buffer, &dst_map); };
+    GstMapInfo src_map = GST_MAP_INFO_INIT;
+    g_return_val_if_fail(gst_buffer_map(src_buffer, &src_map, GST_MAP_READ), FALSE);
+    ON_SCOPE_EXIT(1) { gst_buffer_unmap(src_buffer, &src_map); };
+
+    for (guint plane = 0; plane < nplane; plane++) {
+        guint row_bytes = (guint)GST_VIDEO_INFO_COMP_WIDTH(info, plane) * GST_VIDEO_INFO_COMP_PSTRIDE(info, plane);
+        guint rows = (guint)GST_VIDEO_INFO_COMP_HEIGHT(info, plane);
+        guint dst_stride = (guint)GST_VIDEO_INFO_PLANE_STRIDE(info, plane);
+        gsize dst_offset = GST_VIDEO_INFO_PLANE_OFFSET(info, plane);
+        g_return_val_if_fail(rows > 0 && row_bytes <= stride && row_bytes <= dst_stride, FALSE);
+        g_return_val_if_fail(src_map.size >= src_offset[plane] + (gsize)stride * (rows - 1) + row_bytes, FALSE);
+        g_return_val_if_fail(dst_map.size >= dst_offset + (gsize)dst_stride * (rows - 1) + row_bytes, FALSE);
+        g_return_val_if_fail(gst_vdec_base_copy_plane(dst_map.data + dst_offset, dst_stride,
+            src_map.data + src_offset[plane], stride, row_bytes, rows), FALSE);
+    }
+    return TRUE;
+}
+
+// copy for avshmem
+static void copy_to_no_stride_buffer(GstVdecBase *self, GstVideoCodecFrame *frame)
+{
+    // the downstream reads the planes by the strides in video meta, no need to copy.
+    if (self->memtype == GST_MEMTYPE_SURFACE || self->video_meta_supported) {
         return;
     }
-    ON_SCOPE_EXIT(1) { gst_buffer_unmap(dts_buffer, &dts_map); };
-    GstMapInfo src_map = GST_MAP_INFO_INIT;
-    if (gst_buffer_map(src_buffer, &src_map, GST_MAP_READ) != TRUE) {
+    GstBuffer *dst_buffer = gst_vdec_base_acquire_nostride_buffer(self);
+    if (dst_buffer == nullptr) {
+        GST_WARNING_OBJECT(self, "Acquire no stride buffer failed, push the strided buffer");
+        return;
+    }
+    if (!gst_vdec_base_copy_planes(self, dst_buffer, frame->output_buffer)) {
+        GST_WARNING_OBJECT(self, "Copy to no stride buffer failed, push the strided buffer");
+        gst_buffer_unref(dst_buffer);
         return;
     }
-    ON_SCOPE_EXIT(2) { gst_buffer_unmap(src_buffer, &src_map); };
-    // yuv buffer size
-    g_return_if_fail(src_map.size >= offset * 3 / 2);
-    errno_t ret = EOK;
-    guint src_offset = 0;
-    guint dts_offset = 0;
-    for (int pos = 0; pos < self->height; pos++) {
-        ret = memcpy_s(dts_map.data + dts_offset, dts_map.size - dts_offset, src_map.data + src_offset, self->width);
-        g_return_if_fail(ret == EOK);
-        dts_offset += (guint)self->width;
-        src_offset += stride;
-    }
-    src_offset = offset;
-    for (int pos = 0; pos < self->height / 2; pos++) {
-        ret = memcpy_s(dts_map.data + dts_offset, dts_map.size - dts_offset, src_map.data + src_offset, self->width);
-        g_return_if_fail(ret == EOK);
-        dts_offset += self->width;
-        src_offset += stride;
-    }
-    gint rst_stride[GST_VIDEO_MAX_PLANES] = { self->width, self->width, 0, 0 };
-    gsize rst_offset[GST_VIDEO_MAX_PLANES] = { 0, self->width * self->height, 0, 0 };
-    static const gint nplane = 2; // nv12 or nv21 planes count
-    gst_buffer_add_video_meta_full(dts_buffer, GST_VIDEO_FRAME_FLAG_NONE, self->format,
-        self->width, self->height, nplane, rst_offset, rst_stride);
+    gst_buffer_unref(frame->output_buffer);
+    frame->output_buffer = dst_buffer;
 }
 
 static GstFlowReturn push_output_buffer(GstVdecBase *self, GstBuffer *buffer)
@@ -1175,6 +1266,23 @@ static GstFlowReturn gst_vdec_base_drain(GstVideoDecoder *decoder)
     return ret;
 }
 
+// the acquire blocks while all the buffers are held downstream, wake it up when flushing.
+static void gst_vdec_base_set_nostride_pool_flushing(GstVdecBase *self, gboolean flushing)
+{
+    GstBufferPool *pool = nullptr;
+    GST_OBJECT_LOCK(self);
+    if (self->nostride_pool != nullptr) {
+        pool = GST_BUFFER_POOL_CAST(gst_object_ref(self->nostride_pool));
+    }
+    GST_OBJECT_UNLOCK(self);
+    if (pool != nullptr) {
+        if (gst_buffer_pool_is_active(pool)) {
+            gst_buffer_pool_set_flushing(pool, flushing);
+        }
+        gst_object_unref(pool);
+    }
+}
+
 static gboolean gst_vdec_base_event(GstVideoDecoder *decoder, GstEvent *event)
 {
     g_return_val_if_fail(decoder != nullptr, FALSE);
@@ -1187,6 +1295,7 @@ static gboolean gst_vdec_base_event(GstVideoDecoder *decoder, GstEvent *event)
     switch (GST_EVENT_TYPE(event)) {
         case GST_EVENT_FLUSH_START:
             {
+                gst_vdec_base_set_nostride_pool_flushing(self, TRUE);
                 GST_VIDEO_DECODER_STREAM_LOCK(self);
                 gst_vdec_base_set_flushing(self, TRUE);
                 self->decoder_start = FALSE;
@@ -1207,6 +1316,7 @@ static gboolean gst_vdec_base_event(GstVideoDecoder *decoder, GstEvent *event)
                 g_mutex_unlock(&self->lock);
             }
             gst_vdec_base_set_flushing(self, FALSE);
+            gst_vdec_base_set_nostride_pool_flushing(self, FALSE);
             self->flushing_stoping = FALSE;
             return ret;
         default:
@@ -1303,6 +1413,8 @@ static gboolean gst_vdec_base_decide_allocation(GstVideoDecoder *decoder, GstQue
     if (outcaps != nullptr) {
         gst_video_info_from_caps(&vinfo, outcaps);
     }
+    self->video_meta_supported = gst_query_find_allocation_meta(query, GST_VIDEO_META_API_TYPE, nullptr);
+    GST_INFO_OBJECT(self, "Downstream video meta supported %d", self->video_meta_supported);
     gboolean update_pool = FALSE;
     guint pool_num = gst_query_get_n_allocation_pools(query);
     if (pool_num > 0) {
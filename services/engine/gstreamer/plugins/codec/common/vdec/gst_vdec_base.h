@@ -108,6 +108,10 @@ struct _GstVdecBase {
     gint real_stride;
     gint real_stride_height;
     DisplayRect rect;
+    gboolean video_meta_supported;
+    GstBufferPool *nostride_pool;
+    GstShMemAllocator *nostride_allocator;
+    GstVideoInfo nostride_info;
 };
 
 struct _GstVdecBaseClass {
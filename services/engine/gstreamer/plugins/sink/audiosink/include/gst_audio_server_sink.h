@@ -50,7 +50,8 @@ struct _GstAudioServerSink {
     gfloat min_volume;
     guint min_buffer_size;
     guint min_frame_count;
-    GstBuffer *cache_buffer;
+    guint8 *cache_data; /* accumulate the small buffers to a full period of min_buffer_size */
+    guint cache_capacity;
     guint cache_size;
     gboolean enable_cache;
     gboolean frame_after_segment;
@@ -15,8 +15,10 @@
 
 #include "config.h"
 #include "gst_audio_server_sink.h"
+#include <algorithm>
 #include <cinttypes>
 #include <gst/gst.h>
+#include "securec.h"
 #include "gst/audio/audio.h"
 #include "media_errors.h"
 #include "media_log.h"
@@ -138,7 +140,8 @@ static void gst_audio_server_sink_init(GstAudioServerSink *sink)
     sink->min_volume = 0;
     sink->min_buffer_size = 0;
     sink->min_frame_count = 0;
-    sink->cache_buffer = nullptr;
+    sink->cache_data = nullptr;
+    sink->cache_capacity = 0;
     sink->pause_cache_buffer = nullptr;
     sink->cache_size = 0;
     sink->enable_cache = FALSE;
@@ -159,6 +162,11 @@ static void gst_audio_server_sink_finalize(GObject *object)
         sink->audio_sink = nullptr;
     }
     gst_audio_server_sink_clear_cache_buffer(sink);
+    if (sink->cache_data != nullptr) {
+        g_free(sink->cache_data);
+        sink->cache_data = nullptr;
+        sink->cache_capacity = 0;
+    }
 }
 
 static gboolean gst_audio_server_sink_set_volume(GstAudioServerSink *sink, gfloat volume)
@@ -290,6 +298,14 @@ static gboolean gst_audio_server_sink_set_caps(GstBaseSink *basesink, GstCaps *c
     g_return_val_if_fail(sink->audio_sink->GetMinimumBufferSize(sink->min_buffer_size) == MSERR_OK, FALSE);
     g_return_val_if_fail(sink->audio_sink->GetMinimumFrameCount(sink->min_frame_count) == MSERR_OK, FALSE);
 
+    if (sink->enable_cache && sink->cache_capacity != sink->min_buffer_size) {
+        std::unique_lock<std::mutex> lock(sink->mutex_);
+        g_free(sink->cache_data);
+        sink->cache_data = static_cast<guint8 *>(g_malloc(sink->min_buffer_size));
+        sink->cache_capacity = sink->min_buffer_size;
+        sink->cache_size = 0;
+    }
+
     return TRUE;
 }
 
@@ -354,6 +370,7 @@ static void gst_audio_server_sink_clear_cache_buffer(GstAudioServerSink *sink)
         gst_buffer_unref(sink->pause_cache_buffer);
         sink->pause_cache_buffer = nullptr;
     }
+    sink->cache_size = 0;
 }
 
 static gboolean gst_audio_server_sink_stop(GstBaseSink *basesink)
@@ -371,58 +388,45 @@ static gboolean gst_audio_server_sink_stop(GstBaseSink *basesink)
 
 static GstFlowReturn gst_audio_server_sink_cache_render(GstAudioServerSink *sink, GstBuffer *buffer)
 {
+    g_return_val_if_fail(sink->cache_data != nullptr && sink->cache_capacity > 0, GST_FLOW_ERROR);
     GstMapInfo map;
     if (gst_buffer_map(buffer, &map, GST_MAP_READ) != TRUE) {
         return GST_FLOW_ERROR;
     }
-    gsize size = map.size;
 
-    if (sink->cache_size == 0 && size >= sink->min_buffer_size) {
-        if (sink->audio_sink->Write(map.data, size) != MSERR_OK) {
-            gst_buffer_unmap(buffer, &map);
-            return GST_FLOW_ERROR;
-        }
-        gst_buffer_unmap(buffer, &map);
-        return GST_FLOW_OK;
-    }
-    gst_buffer_unmap(buffer, &map);
-
-    if (sink->cache_size == 0 && size < sink->min_buffer_size) {
-        sink->cache_size += static_cast<guint>(size);
-        sink->cache_buffer = gst_buffer_copy(buffer);
-        if (sink->cache_buffer == nullptr) {
-            return GST_FLOW_ERROR;
+    // each input byte is copied at most once, the full periods are written from the cache directly.
+    std::unique_lock<std::mutex> lock(sink->mutex_);
+    GstFlowReturn ret = GST_FLOW_OK;
+    guint8 *data = map.data;
+    gsize left = map.size;
+    while (left > 0) {
+        if (sink->cache_size == 0 && left >= sink->cache_capacity) {
+            if (sink->audio_sink->Write(data, left) != MSERR_OK) {
+                ret = GST_FLOW_ERROR;
+            }
+            break;
         }
-        return GST_FLOW_OK;
-    }
 
-    sink->cache_size += static_cast<guint>(size);
-    GstBuffer *buf = gst_buffer_copy(sink->cache_buffer);
-    if (buf == nullptr) {
-        gst_buffer_unref(sink->cache_buffer);
-        return GST_FLOW_ERROR;
-    }
-    (void)gst_buffer_ref(buffer);
-    buf = gst_buffer_append(buf, buffer);
-    gst_buffer_unref(sink->cache_buffer);
-    sink->cache_buffer = buf;
-
-    if (sink->cache_size >= sink->min_buffer_size) {
-        if (gst_buffer_map(sink->cache_buffer, &map, GST_MAP_READ) != TRUE) {
-            gst_buffer_unref(sink->cache_buffer);
-            return GST_FLOW_ERROR;
+        guint space = sink->cache_capacity - sink->cache_size;
+        guint copySize = static_cast<guint>(std::min<gsize>(left, space));
+        if (memcpy_s(sink->cache_data + sink->cache_size, space, data, copySize) != EOK) {
+            ret = GST_FLOW_ERROR;
+            break;
         }
-        int32_t ret = sink->audio_sink->Write(map.data, sink->cache_size);
-        gst_buffer_unmap(sink->cache_buffer, &map);
-        gst_buffer_unref(sink->cache_buffer);
-        sink->cache_size = 0;
-        sink->cache_buffer = nullptr;
-        if (ret != MSERR_OK) {
-            return GST_FLOW_ERROR;
+        sink->cache_size += copySize;
+        data += copySize;
+        left -= copySize;
+
+        if (sink->cache_size == sink->cache_capacity) {
+            sink->cache_size = 0;
+            if (sink->audio_sink->Write(sink->cache_data, sink->cache_capacity) != MSERR_OK) {
+                ret = GST_FLOW_ERROR;
+                break;
+            }
         }
-        return GST_FLOW_OK;
     }
-    return GST_FLOW_OK;
+    gst_buffer_unmap(buffer, &map);
+    return ret;
 }
 
 static GstStateChangeReturn gst_audio_server_sink_change_state(GstElement *element, GstStateChange transition)
@@ -19,8 +19,8 @@
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <vector>
 #include "audio_capture.h"
 #include "audio_capturer.h"
 #include "nocopyable.h"
@@ -31,7 +31,12 @@ struct AudioCacheCtrl {
     std::mutex captureMutex_;
     std::condition_variable captureCond_;
     std::condition_variable pauseCond_;
-    std::queue<std::shared_ptr<AudioBuffer>> captureQueue_;
+    // fixed capacity ring of the captured buffers, the oldest one is dropped when it is full.
+    std::vector<AudioBuffer> captureRing_;
+    size_t ringHead_ = 0;
+    size_t ringCount_ = 0;
+    uint64_t droppedCount_ = 0;
+    bool captureStopped_ = false;
     uint64_t lastTimeStamp_ = 0;
     uint64_t pausedTime_ = 0; // the timestamp when audio pause called
     uint64_t resumeTime_ = 0; // the timestamp when audio resume called
@@ -69,7 +74,13 @@ private:
     };
 
     void GetAudioCaptureBuffer();
+    int32_t CreateBufferPool();
+    void DestroyBufferPool();
+    void PushBufferLocked(const AudioBuffer &buffer);
+    bool PopBufferLocked(AudioBuffer &buffer);
+    void ClearBufferLocked();
     std::unique_ptr<AudioCacheCtrl> audioCacheCtrl_;
+    GstBufferPool *bufferPool_ = nullptr;
     std::unique_ptr<std::thread> captureLoop_;
     std::mutex pauseMutex_;
     std::atomic<int32_t> curState_ = RECORDER_INITIALIZED;
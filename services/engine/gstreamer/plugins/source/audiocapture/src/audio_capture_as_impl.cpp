@@ -23,6 +23,7 @@
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "AudioCaptureAsImpl"};
     constexpr size_t MAXIMUM_BUFFER_SIZE = 100000;
+    constexpr size_t MAX_CACHE_BUFFER_NUM = 32;
     constexpr uint64_t SEC_TO_NANOSECOND = 1000000000;
 }
 
@@ -38,6 +39,11 @@ AudioCaptureAsImpl::~AudioCaptureAsImpl()
         (void)audioCapturer_->Release();
         audioCapturer_ = nullptr;
     }
+    if (audioCacheCtrl_ != nullptr) {
+        std::unique_lock<std::mutex> loopLock(audioCacheCtrl_->captureMutex_);
+        ClearBufferLocked();
+    }
+    DestroyBufferPool();
 }
 
 int32_t AudioCaptureAsImpl::SetCaptureParameter(uint32_t bitrate, uint32_t channels, uint32_t sampleRate)
@@ -50,6 +56,7 @@ int32_t AudioCaptureAsImpl::SetCaptureParameter(uint32_t bitrate, uint32_t chann
     }
     audioCacheCtrl_ = std::make_unique<AudioCacheCtrl>();
     CHECK_AND_RETURN_RET_LOG(audioCacheCtrl_ != nullptr, MSERR_NO_MEMORY, "create audio cache ctrl failed");
+    audioCacheCtrl_->captureRing_.resize(MAX_CACHE_BUFFER_NUM);
 
     AudioStandard::AudioCapturerParams params;
     auto supportedSampleList = AudioStandard::AudioCapturer::GetSupportedSamplingRates();
@@ -125,6 +132,70 @@ int32_t AudioCaptureAsImpl::GetSegmentInfo(uint64_t &start)
     return MSERR_OK;
 }
 
+int32_t AudioCaptureAsImpl::CreateBufferPool()
+{
+    CHECK_AND_RETURN_RET(bufferSize_ > 0 && bufferSize_ < MAXIMUM_BUFFER_SIZE, MSERR_INVALID_OPERATION);
+    DestroyBufferPool();
+
+    // preallocate the buffers for the full ring, the pool only grows if the downstream holds many of them.
+    bufferPool_ = gst_buffer_pool_new();
+    CHECK_AND_RETURN_RET_LOG(bufferPool_ != nullptr, MSERR_NO_MEMORY, "create buffer pool failed");
+    GstStructure *config = gst_buffer_pool_get_config(bufferPool_);
+    CHECK_AND_RETURN_RET_LOG(config != nullptr, MSERR_NO_MEMORY, "get buffer pool config failed");
+    gst_buffer_pool_config_set_params(config, nullptr, static_cast<guint>(bufferSize_),
+        static_cast<guint>(MAX_CACHE_BUFFER_NUM), 0);
+    CHECK_AND_RETURN_RET_LOG(gst_buffer_pool_set_config(bufferPool_, config), MSERR_UNKNOWN,
+        "set buffer pool config failed");
+    CHECK_AND_RETURN_RET_LOG(gst_buffer_pool_set_active(bufferPool_, TRUE), MSERR_UNKNOWN,
+        "active buffer pool failed");
+    return MSERR_OK;
+}
+
+void AudioCaptureAsImpl::DestroyBufferPool()
+{
+    if (bufferPool_ != nullptr) {
+        (void)gst_buffer_pool_set_active(bufferPool_, FALSE);
+        gst_object_unref(bufferPool_);
+        bufferPool_ = nullptr;
+    }
+}
+
+void AudioCaptureAsImpl::PushBufferLocked(const AudioBuffer &buffer)
+{
+    auto &ring = audioCacheCtrl_->captureRing_;
+    if (audioCacheCtrl_->ringCount_ == ring.size()) {
+        AudioBuffer dropped;
+        (void)PopBufferLocked(dropped);
+        gst_buffer_unref(dropped.gstBuffer);
+        audioCacheCtrl_->droppedCount_++;
+        MEDIA_LOGW("audio cache is full, drop the oldest buffer, total dropped: %{public}" PRIu64 "",
+            audioCacheCtrl_->droppedCount_);
+    }
+    ring[(audioCacheCtrl_->ringHead_ + audioCacheCtrl_->ringCount_) % ring.size()] = buffer;
+    audioCacheCtrl_->ringCount_++;
+}
+
+bool AudioCaptureAsImpl::PopBufferLocked(AudioBuffer &buffer)
+{
+    if (audioCacheCtrl_->ringCount_ == 0) {
+        return false;
+    }
+    auto &ring = audioCacheCtrl_->captureRing_;
+    buffer = ring[audioCacheCtrl_->ringHead_];
+    ring[audioCacheCtrl_->ringHead_].gstBuffer = nullptr;
+    audioCacheCtrl_->ringHead_ = (audioCacheCtrl_->ringHead_ + 1) % ring.size();
+    audioCacheCtrl_->ringCount_--;
+    return true;
+}
+
+void AudioCaptureAsImpl::ClearBufferLocked()
+{
+    AudioBuffer buffer;
+    while (PopBufferLocked(buffer)) {
+        gst_buffer_unref(buffer.gstBuffer);
+    }
+}
+
 void AudioCaptureAsImpl::GetAudioCaptureBuffer()
 {
     while (true) {
@@ -144,39 +215,39 @@ void AudioCaptureAsImpl::GetAudioCaptureBuffer()
             break;
         }
 
-        CHECK_AND_BREAK(audioCapturer_ != nullptr);
-        std::shared_ptr<AudioBuffer> tempBuffer = std::make_shared<AudioBuffer>();
-        CHECK_AND_BREAK(bufferSize_ > 0 && bufferSize_ < MAXIMUM_BUFFER_SIZE);
-        tempBuffer->gstBuffer = gst_buffer_new_allocate(nullptr, bufferSize_, nullptr);
-        CHECK_AND_BREAK(tempBuffer->gstBuffer != nullptr);
+        CHECK_AND_BREAK(audioCapturer_ != nullptr && bufferPool_ != nullptr);
+        AudioBuffer tempBuffer;
+        tempBuffer.gstBuffer = nullptr;
+        CHECK_AND_BREAK(gst_buffer_pool_acquire_buffer(bufferPool_, &tempBuffer.gstBuffer, nullptr) == GST_FLOW_OK);
+        CHECK_AND_BREAK(tempBuffer.gstBuffer != nullptr);
 
         GstMapInfo map = GST_MAP_INFO_INIT;
-        if (gst_buffer_map(tempBuffer->gstBuffer, &map, GST_MAP_READ) != TRUE) {
-            gst_buffer_unref(tempBuffer->gstBuffer);
+        if (gst_buffer_map(tempBuffer.gstBuffer, &map, GST_MAP_WRITE) != TRUE) {
+            gst_buffer_unref(tempBuffer.gstBuffer);
             break;
         }
         bool isBlocking = true;
         int32_t bytesRead = audioCapturer_->Read(*(map.data), map.size, isBlocking);
-        gst_buffer_unmap(tempBuffer->gstBuffer, &map);
+        gst_buffer_unmap(tempBuffer.gstBuffer, &map);
         if (bytesRead <= 0) {
-            gst_buffer_unref(tempBuffer->gstBuffer);
+            gst_buffer_unref(tempBuffer.gstBuffer);
             break;
         }
         uint64_t curTimeStamp = 0;
         if (GetSegmentInfo(curTimeStamp) != MSERR_OK) {
-            gst_buffer_unref(tempBuffer->gstBuffer);
+            gst_buffer_unref(tempBuffer.gstBuffer);
             break;
         }
 
-        tempBuffer->timestamp = curTimeStamp;
-        tempBuffer->duration = bufferDurationNs_;
-        tempBuffer->dataLen = bufferSize_;
+        tempBuffer.timestamp = curTimeStamp;
+        tempBuffer.duration = bufferDurationNs_;
+        tempBuffer.dataLen = bufferSize_;
 
         {
             std::unique_lock<std::mutex> loopLock(audioCacheCtrl_->captureMutex_);
-            audioCacheCtrl_->captureQueue_.push(tempBuffer);
-            MEDIA_LOGD("audio cache queue size is %{public}zu", audioCacheCtrl_->captureQueue_.size());
-            audioCacheCtrl_->captureCond_.notify_all();
+            PushBufferLocked(tempBuffer);
+            MEDIA_LOGD("audio cache queue size is %{public}zu", audioCacheCtrl_->ringCount_);
+            audioCacheCtrl_->captureCond_.notify_one();
         }
     }
 }
@@ -184,32 +255,32 @@ void AudioCaptureAsImpl::GetAudioCaptureBuffer()
 std::shared_ptr<AudioBuffer> AudioCaptureAsImpl::GetBuffer()
 {
     std::unique_lock<std::mutex> loopLock(audioCacheCtrl_->captureMutex_);
-    audioCacheCtrl_->captureCond_.wait(loopLock, [this]() { return audioCacheCtrl_->captureQueue_.size() > 0; });
+    auto waitBuffer = [this]() { return audioCacheCtrl_->ringCount_ > 0 || audioCacheCtrl_->captureStopped_; };
+    audioCacheCtrl_->captureCond_.wait(loopLock, waitBuffer);
 
-    if (curState_.load() == RECORDER_STOP) {
+    if (curState_.load() == RECORDER_STOP || audioCacheCtrl_->captureStopped_) {
         return nullptr;
     }
 
     if (curState_.load() == RECORDER_RESUME && audioCacheCtrl_->pausedTime_ == -1) {
         audioCacheCtrl_->pausedTime_ = audioCacheCtrl_->lastTimeStamp_;
         MEDIA_LOGD("audio pause timestamp %{public}" PRIu64 "", audioCacheCtrl_->pausedTime_);
-        MEDIA_LOGD("%{public}zu audio buffer has been dropped", audioCacheCtrl_->captureQueue_.size());
-        while (!audioCacheCtrl_->captureQueue_.empty()) {
-            audioCacheCtrl_->captureQueue_.pop();
+        MEDIA_LOGD("%{public}zu audio buffer has been dropped", audioCacheCtrl_->ringCount_);
+        ClearBufferLocked();
+        audioCacheCtrl_->captureCond_.wait(loopLock, waitBuffer);
+        if (audioCacheCtrl_->captureStopped_) {
+            return nullptr;
         }
-        audioCacheCtrl_->captureCond_.wait(loopLock, [this]() { return audioCacheCtrl_->captureQueue_.size() > 0; });
     }
 
-    std::shared_ptr<AudioBuffer> bufferOut = audioCacheCtrl_->captureQueue_.front();
-    audioCacheCtrl_->captureQueue_.pop();
+    std::shared_ptr<AudioBuffer> bufferOut = std::make_shared<AudioBuffer>();
+    (void)PopBufferLocked(*bufferOut);
 
     if (curState_.load() == RECORDER_PAUSED) {
         audioCacheCtrl_->pausedTime_ = bufferOut->timestamp;
         MEDIA_LOGD("audio pause timestamp %{public}" PRIu64 "", audioCacheCtrl_->pausedTime_);
-        MEDIA_LOGD("%{public}zu audio buffer has been dropped", audioCacheCtrl_->captureQueue_.size());
-        while (!audioCacheCtrl_->captureQueue_.empty()) {
-            audioCacheCtrl_->captureQueue_.pop();
-        }
+        MEDIA_LOGD("%{public}zu audio buffer has been dropped", audioCacheCtrl_->ringCount_);
+        ClearBufferLocked();
     }
     if (curState_.load() == RECORDER_RESUME) {
         curState_.store(RECORDER_RUNNING);
@@ -230,7 +301,9 @@ int32_t AudioCaptureAsImpl::StartAudioCapture()
 {
     MEDIA_LOGD("StartAudioCapture");
 
-    CHECK_AND_RETURN_RET(audioCapturer_ != nullptr, MSERR_INVALID_OPERATION);
+    CHECK_AND_RETURN_RET(audioCapturer_ != nullptr && audioCacheCtrl_ != nullptr, MSERR_INVALID_OPERATION);
+    int32_t ret = CreateBufferPool();
+    CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
     CHECK_AND_RETURN_RET(audioCapturer_->Start(), MSERR_UNKNOWN);
 
     curState_.store(RECORDER_RUNNING);
@@ -247,7 +320,7 @@ int32_t AudioCaptureAsImpl::StopAudioCapture()
 
     if (captureLoop_ != nullptr && captureLoop_->joinable()) {
         std::unique_lock<std::mutex> loopLock(audioCacheCtrl_->captureMutex_);
-        audioCacheCtrl_->captureQueue_.push(nullptr); // to wake up the loop thread
+        audioCacheCtrl_->captureStopped_ = true; // to wake up the loop thread
         audioCacheCtrl_->captureCond_.notify_all();
         audioCacheCtrl_->pauseCond_.notify_all();
         loopLock.unlock();
@@ -263,9 +336,13 @@ int32_t AudioCaptureAsImpl::StopAudioCapture()
         CHECK_AND_RETURN_RET(audioCapturer_->Release(), MSERR_UNKNOWN);
     }
 
-    while (!audioCacheCtrl_->captureQueue_.empty()) {
-        audioCacheCtrl_->captureQueue_.pop();
+    {
+        std::unique_lock<std::mutex> loopLock(audioCacheCtrl_->captureMutex_);
+        MEDIA_LOGI("audio capture stopped, %{public}" PRIu64 " buffers dropped for the full cache",
+            audioCacheCtrl_->droppedCount_);
+        ClearBufferLocked();
     }
+    DestroyBufferPool();
 
     audioCapturer_ = nullptr;
     audioCacheCtrl_ = nullptr;
@@ -17,6 +17,7 @@
 #define I_AVCODEC_SERVICE_H
 
 #include <string>
+#include <vector>
 #include "avcodec_common.h"
 #include "avcodec_info.h"
 #include "avsharedmemory.h"
@@ -25,6 +26,8 @@
 
 namespace OHOS {
 namespace Media {
+constexpr uint32_t MAX_AVCODEC_BATCH_NUM = 64;
+
 class IAVCodecService {
 public:
     virtual ~IAVCodecService() = default;
@@ -41,11 +44,19 @@ public:
     virtual int32_t SetOutputSurface(sptr<Surface> surface) = 0;
     virtual std::shared_ptr<AVSharedMemory> GetInputBuffer(uint32_t index) = 0;
     virtual int32_t QueueInputBuffer(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag) = 0;
+    /**
+     * Queue the input buffers in the given order, stop at the first failure and return its error code.
+     */
+    virtual int32_t QueueInputBuffers(const std::vector<AVCodecInputRequest> &requests) = 0;
     virtual std::shared_ptr<AVSharedMemory> GetOutputBuffer(uint32_t index) = 0;
     virtual int32_t GetOutputFormat(Format &format) = 0;
     virtual std::shared_ptr<AudioCaps> GetAudioCaps() = 0;
     virtual std::shared_ptr<VideoCaps> GetVideoCaps() = 0;
     virtual int32_t ReleaseOutputBuffer(uint32_t index, bool render = false) = 0;
+    /**
+     * Release the output buffers in the given order, stop at the first failure and return its error code.
+     */
+    virtual int32_t ReleaseOutputBuffers(const std::vector<uint32_t> &indexes, bool render = false) = 0;
     virtual int32_t SetParameter(const Format &format) = 0;
     virtual int32_t SetCallback(const std::shared_ptr<AVCodecCallback> &callback) = 0;
 };
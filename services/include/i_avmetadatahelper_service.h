@@ -16,6 +16,7 @@
 #ifndef IAVMETADATAHELPER_SERVICE_H
 #define IAVMETADATAHELPER_SERVICE_H
 
+#include <vector>
 #include "avmetadatahelper.h"
 #include "avsharedmemory.h"
 
@@ -55,6 +56,9 @@ struct OutputConfiguration {
     PixelFormat colorFormat = PixelFormat::RGB_565;
 };
 
+// the max number of time positions that can be fetched in one FetchFramesAtTimes call
+constexpr int32_t MAX_FETCH_FRAMES_NUM = 32;
+
 class IAVMetadataHelperService {
 public:
     virtual ~IAVMetadataHelperService() = default;
@@ -126,6 +130,21 @@ public:
     virtual std::shared_ptr<AVSharedMemory> FetchFrameAtTime(
         int64_t timeUs, int32_t option, const OutputConfiguration &param) = 0;
 
+    /**
+     * Fetch the representative video frames near the given timestamps in one call, see
+     * {@link FetchFrameAtTime}. The positions are decoded in ascending time order within
+     * one conversion pipeline, nearby positions are reached by decoding forward rather
+     * than seeking again. This method must be called after the SetSource.
+     * @param timesUs The time positions in microseconds where the frames will be fetched,
+     * at most {@link MAX_FETCH_FRAMES_NUM} positions.
+     * @param option the hint about how to fetch the frames, see {@link AVMetadataQueryOption}
+     * @param param the desired configuration of returned video frames, see {@link OutputConfiguration}.
+     * @return Returns the video frames in the same order as timesUs, an element is null if the
+     * frame at that position cannot be fetched. Returns an empty vector if no frame can be fetched.
+     */
+    virtual std::vector<std::shared_ptr<AVSharedMemory>> FetchFramesAtTimes(
+        const std::vector<int64_t> &timesUs, int32_t option, const OutputConfiguration &param) = 0;
+
     /**
      * Release the internel resource. After this method called, the service instance
      * can not be used again.
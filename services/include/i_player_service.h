@@ -57,6 +57,28 @@ public:
      * @version 1.0
      */
     virtual int32_t SetSource(int32_t fd, int64_t offset, int64_t size) = 0;
+    /**
+     * @brief Sets the media source to play right after the current one, without a gap.
+     *
+     * @param url Indicates the playback source address, empty to clear the next source.
+     * @return Returns {@link MSERR_OK} if the next source is set successfully; returns an error code defined
+     * in {@link media_errors.h} otherwise.
+     * @since 1.0
+     * @version 1.0
+     */
+    virtual int32_t SetNextSource(const std::string &url) = 0;
+    /**
+     * @brief Sets the media file descriptor source to play right after the current one, without a gap.
+     *
+     * @param fd Indicates the file descriptor of media source.
+     * @param offset Indicates the offset of media source in file descriptor.
+     * @param size Indicates the size of media source.
+     * @return Returns {@link MSERR_OK} if the next source is set successfully; returns an error code defined
+     * in {@link media_errors.h} otherwise.
+     * @since 1.0
+     * @version 1.0
+     */
+    virtual int32_t SetNextSource(int32_t fd, int64_t offset, int64_t size) = 0;
     /**
      * @brief Start playback.
      *
@@ -14,8 +14,10 @@
  */
 
 #include "avcodec_client.h"
+#include <algorithm>
 #include "media_log.h"
 #include "media_errors.h"
+#include "param_wrapper.h"
 
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "AVCodecClient"};
@@ -44,20 +46,35 @@ AVCodecClient::AVCodecClient(const sptr<IStandardAVCodecService> &ipcProxy)
 
 AVCodecClient::~AVCodecClient()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (codecProxy_ != nullptr) {
-        (void)codecProxy_->DestroyStub();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (codecProxy_ != nullptr) {
+            (void)codecProxy_->DestroyStub();
+        }
+    }
+    if (listenerStub_ != nullptr) {
+        listenerStub_->StopNoticeRing();
     }
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances destroy", FAKE_POINTER(this));
 }
 
 void AVCodecClient::MediaServerDied()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    codecProxy_ = nullptr;
-    listenerStub_ = nullptr;
-    if (callback_ != nullptr) {
-        callback_->OnError(AVCODEC_ERROR_INTERNAL, MSERR_SERVICE_DIED);
+    sptr<AVCodecListenerStub> listenerStub = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        codecProxy_ = nullptr;
+        requestRing_ = nullptr;
+        listenerStub = listenerStub_;
+        listenerStub_ = nullptr;
+        if (callback_ != nullptr) {
+            callback_->OnError(AVCODEC_ERROR_INTERNAL, MSERR_SERVICE_DIED);
+        }
+    }
+
+    // the notice ring consumer may be blocked at the lock inside the callback, stop it without the lock.
+    if (listenerStub != nullptr) {
+        listenerStub->StopNoticeRing();
     }
 }
 
@@ -147,6 +164,7 @@ int32_t AVCodecClient::Release()
     int32_t ret = codecProxy_->Release();
     (void)codecProxy_->DestroyStub();
     codecProxy_ = nullptr;
+    requestRing_ = nullptr;
     return ret;
 }
 
@@ -179,9 +197,51 @@ int32_t AVCodecClient::QueueInputBuffer(uint32_t index, AVCodecBufferInfo info,
 {
     std::lock_guard<std::mutex> lock(mutex_);
     CHECK_AND_RETURN_RET_LOG(codecProxy_ != nullptr, MSERR_NO_MEMORY, "codec service does not exist.");
+
+    AVShMemRingItem item;
+    item.type = RING_QUEUE_INPUT_BUFFER;
+    item.index = index;
+    item.pts = info.presentationTimeUs;
+    item.size = info.size;
+    item.offset = info.offset;
+    item.flag = static_cast<uint32_t>(flag);
+    if (PushRequestLocked(item)) {
+        return MSERR_OK;
+    }
     return codecProxy_->QueueInputBuffer(index, info, flag);
 }
 
+int32_t AVCodecClient::QueueInputBuffers(const std::vector<AVCodecInputRequest> &requests)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(codecProxy_ != nullptr, MSERR_NO_MEMORY, "codec service does not exist.");
+
+    size_t pushed = 0;
+    for (auto &request : requests) {
+        AVShMemRingItem item;
+        item.type = RING_QUEUE_INPUT_BUFFER;
+        item.index = request.index;
+        item.pts = request.info.presentationTimeUs;
+        item.size = request.info.size;
+        item.offset = request.info.offset;
+        item.flag = static_cast<uint32_t>(request.flag);
+        if (!PushRequestLocked(item)) {
+            break;
+        }
+        ++pushed;
+    }
+    // the rest goes through the binder, one transaction per MAX_AVCODEC_BATCH_NUM buffers
+    while (pushed < requests.size()) {
+        size_t count = std::min(requests.size() - pushed, static_cast<size_t>(MAX_AVCODEC_BATCH_NUM));
+        auto begin = requests.begin() + static_cast<ptrdiff_t>(pushed);
+        std::vector<AVCodecInputRequest> batch(begin, begin + static_cast<ptrdiff_t>(count));
+        int32_t ret = codecProxy_->QueueInputBuffers(batch);
+        CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
+        pushed += count;
+    }
+    return MSERR_OK;
+}
+
 std::shared_ptr<AVSharedMemory> AVCodecClient::GetOutputBuffer(uint32_t index)
 {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -219,9 +279,44 @@ int32_t AVCodecClient::ReleaseOutputBuffer(uint32_t index, bool render)
 {
     std::lock_guard<std::mutex> lock(mutex_);
     CHECK_AND_RETURN_RET_LOG(codecProxy_ != nullptr, MSERR_NO_MEMORY, "codec service does not exist.");
+
+    AVShMemRingItem item;
+    item.type = RING_RELEASE_OUTPUT_BUFFER;
+    item.index = index;
+    item.flag = render ? 1 : 0;
+    if (PushRequestLocked(item)) {
+        return MSERR_OK;
+    }
     return codecProxy_->ReleaseOutputBuffer(index, render);
 }
 
+int32_t AVCodecClient::ReleaseOutputBuffers(const std::vector<uint32_t> &indexes, bool render)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(codecProxy_ != nullptr, MSERR_NO_MEMORY, "codec service does not exist.");
+
+    size_t pushed = 0;
+    for (auto index : indexes) {
+        AVShMemRingItem item;
+        item.type = RING_RELEASE_OUTPUT_BUFFER;
+        item.index = index;
+        item.flag = render ? 1 : 0;
+        if (!PushRequestLocked(item)) {
+            break;
+        }
+        ++pushed;
+    }
+    while (pushed < indexes.size()) {
+        size_t count = std::min(indexes.size() - pushed, static_cast<size_t>(MAX_AVCODEC_BATCH_NUM));
+        auto begin = indexes.begin() + static_cast<ptrdiff_t>(pushed);
+        std::vector<uint32_t> batch(begin, begin + static_cast<ptrdiff_t>(count));
+        int32_t ret = codecProxy_->ReleaseOutputBuffers(batch, render);
+        CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
+        pushed += count;
+    }
+    return MSERR_OK;
+}
+
 int32_t AVCodecClient::SetParameter(const Format &format)
 {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -239,7 +334,43 @@ int32_t AVCodecClient::SetCallback(const std::shared_ptr<AVCodecCallback> &callb
     callback_ = callback;
     MEDIA_LOGD("SetCallback");
     listenerStub_->SetCallback(callback);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    EnableBufferRingsLocked();
     return MSERR_OK;
 }
+
+void AVCodecClient::EnableBufferRingsLocked()
+{
+    // the queue errors are reported through the OnError if the rings are used, so it is disabled by default.
+    if (requestRing_ != nullptr || codecProxy_ == nullptr ||
+        OHOS::system::GetIntParameter("sys.media.avcodec.ring", 0) == 0) {
+        return;
+    }
+
+    auto requestRing = AVShMemRing::Create(AVCODEC_RING_CAPACITY, "AVCodecRequestRing");
+    auto noticeRing = AVShMemRing::Create(AVCODEC_RING_CAPACITY, "AVCodecNoticeRing");
+    CHECK_AND_RETURN_LOG(requestRing != nullptr && noticeRing != nullptr, "create buffer rings failed");
+
+    int32_t ret = listenerStub_->SetNoticeRing(noticeRing);
+    CHECK_AND_RETURN_LOG(ret == MSERR_OK, "set notice ring failed");
+
+    ret = codecProxy_->SetBufferRings(requestRing, noticeRing);
+    if (ret != MSERR_OK) {
+        MEDIA_LOGW("set buffer rings failed, use the binder to exchange the buffers");
+        listenerStub_->StopNoticeRing();
+        return;
+    }
+    requestRing_ = requestRing;
+    MEDIA_LOGI("buffer rings enabled");
+}
+
+bool AVCodecClient::PushRequestLocked(const AVShMemRingItem &item)
+{
+    if (requestRing_ == nullptr) {
+        return false;
+    }
+    return requestRing_->Push(item);
+}
 } // namespace Media
 } // namespace OHOS
@@ -40,11 +40,13 @@ public:
     int32_t SetOutputSurface(sptr<Surface> surface) override;
     std::shared_ptr<AVSharedMemory> GetInputBuffer(uint32_t index) override;
     int32_t QueueInputBuffer(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag) override;
+    int32_t QueueInputBuffers(const std::vector<AVCodecInputRequest> &requests) override;
     std::shared_ptr<AVSharedMemory> GetOutputBuffer(uint32_t index) override;
     int32_t GetOutputFormat(Format &format) override;
     std::shared_ptr<AudioCaps> GetAudioCaps() override;
     std::shared_ptr<VideoCaps> GetVideoCaps() override;
     int32_t ReleaseOutputBuffer(uint32_t index, bool render) override;
+    int32_t ReleaseOutputBuffers(const std::vector<uint32_t> &indexes, bool render) override;
     int32_t SetParameter(const Format &format) override;
     int32_t SetCallback(const std::shared_ptr<AVCodecCallback> &callback) override;
     // AVCodecClient
@@ -52,10 +54,14 @@ public:
 
 private:
     int32_t CreateListenerObject();
+    void EnableBufferRingsLocked();
+    bool PushRequestLocked(const AVShMemRingItem &item);
 
     sptr<IStandardAVCodecService> codecProxy_ = nullptr;
     sptr<AVCodecListenerStub> listenerStub_ = nullptr;
     std::shared_ptr<AVCodecCallback> callback_ = nullptr;
+    // the queue and release requests are pushed to the ring if enabled, the binder is used when it is full.
+    std::shared_ptr<AVShMemRing> requestRing_ = nullptr;
     std::mutex mutex_;
 };
 } // namespace Media
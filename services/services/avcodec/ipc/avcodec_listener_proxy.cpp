@@ -14,12 +14,16 @@
  */
 
 #include "avcodec_listener_proxy.h"
+#include <algorithm>
+#include "i_standard_avcodec_service.h"
 #include "media_errors.h"
 #include "media_log.h"
 #include "media_parcel.h"
+#include "param_wrapper.h"
 
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "AVCodecListenerProxy"};
+    constexpr int32_t MAX_BATCH_WINDOW_US = 20000;
 }
 
 namespace OHOS {
@@ -104,43 +108,205 @@ void AVCodecListenerProxy::OnOutputBufferAvailable(uint32_t index, AVCodecBuffer
     }
 }
 
+void AVCodecListenerProxy::OnBuffersAvailable(const std::vector<AVCodecBufferNotice> &notices)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_ASYNC);
+    if (!data.WriteInterfaceToken(AVCodecListenerProxy::GetDescriptor())) {
+        MEDIA_LOGE("Failed to write descriptor");
+        return;
+    }
+    data.WriteUint32(static_cast<uint32_t>(notices.size()));
+    for (auto &notice : notices) {
+        data.WriteBool(notice.isInput);
+        data.WriteUint32(notice.index);
+        if (!notice.isInput) {
+            data.WriteInt64(notice.info.presentationTimeUs);
+            data.WriteInt32(notice.info.size);
+            data.WriteInt32(notice.info.offset);
+            data.WriteInt32(static_cast<int32_t>(notice.flag));
+        }
+    }
+    int error = Remote()->SendRequest(AVCodecListenerMsg::ON_BUFFERS_AVAILABLE, data, reply, option);
+    if (error != MSERR_OK) {
+        MEDIA_LOGE("OnBuffersAvailable failed, error: %{public}d", error);
+    }
+}
+
 AVCodecListenerCallback::AVCodecListenerCallback(const sptr<IStandardAVCodecListener> &listener)
     : listener_(listener)
 {
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances create", FAKE_POINTER(this));
+
+    if (OHOS::system::GetIntParameter("sys.media.avcodec.notify.batch", 1) == 0) {
+        return;
+    }
+    int32_t windowUs = OHOS::system::GetIntParameter("sys.media.avcodec.notify.window", 0);
+    batchWindowUs_ = static_cast<uint64_t>(std::clamp(windowUs, 0, MAX_BATCH_WINDOW_US));
+
+    taskQue_ = std::make_unique<TaskQueue>("AVCodecNotify");
+    if (taskQue_->Start() != MSERR_OK) {
+        MEDIA_LOGE("start notify task queue failed, fallback to notify one by one");
+        taskQue_ = nullptr;
+    }
 }
 
 AVCodecListenerCallback::~AVCodecListenerCallback()
 {
+    if (taskQue_ != nullptr) {
+        (void)taskQue_->Stop();
+    }
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances destroy", FAKE_POINTER(this));
 }
 
 void AVCodecListenerCallback::OnError(AVCodecErrorType errorType, int32_t errorCode)
 {
-    if (listener_ != nullptr) {
+    if (listener_ == nullptr) {
+        return;
+    }
+    if (taskQue_ == nullptr) {
         listener_->OnError(errorType, errorCode);
+        return;
     }
+    auto task = std::make_shared<TaskHandler<void>>([this, errorType, errorCode]() {
+        FlushBufferNotices();
+        listener_->OnError(errorType, errorCode);
+    });
+    (void)taskQue_->EnqueueTask(task);
 }
 
 void AVCodecListenerCallback::OnOutputFormatChanged(const Format &format)
 {
-    if (listener_ != nullptr) {
+    if (listener_ == nullptr) {
+        return;
+    }
+    if (taskQue_ == nullptr) {
         listener_->OnOutputFormatChanged(format);
+        return;
     }
+    auto task = std::make_shared<TaskHandler<void>>([this, format]() {
+        FlushBufferNotices();
+        listener_->OnOutputFormatChanged(format);
+    });
+    (void)taskQue_->EnqueueTask(task);
 }
 
 void AVCodecListenerCallback::OnInputBufferAvailable(uint32_t index)
 {
-    if (listener_ != nullptr) {
+    if (listener_ == nullptr) {
+        return;
+    }
+    if (taskQue_ == nullptr) {
         listener_->OnInputBufferAvailable(index);
+        return;
     }
+    AVCodecBufferNotice notice;
+    notice.isInput = true;
+    notice.index = index;
+    AddBufferNotice(notice, false);
 }
 
 void AVCodecListenerCallback::OnOutputBufferAvailable(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag)
 {
-    if (listener_ != nullptr) {
+    if (listener_ == nullptr) {
+        return;
+    }
+    if (taskQue_ == nullptr) {
         listener_->OnOutputBufferAvailable(index, info, flag);
+        return;
+    }
+    AVCodecBufferNotice notice;
+    notice.isInput = false;
+    notice.index = index;
+    notice.info = info;
+    notice.flag = flag;
+    // no more buffers will come after the eos, do not wait for the window
+    AddBufferNotice(notice, (flag & AVCODEC_BUFFER_FLAG_EOS) != 0);
+}
+
+int32_t AVCodecListenerCallback::SetNoticeRing(const std::shared_ptr<AVShMemRing> &ring)
+{
+    // the ring is single producer, only the notify task queue pushes to it.
+    CHECK_AND_RETURN_RET_LOG(taskQue_ != nullptr, MSERR_INVALID_OPERATION, "notify batch is disabled");
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    noticeRing_ = ring;
+    return MSERR_OK;
+}
+
+void AVCodecListenerCallback::AddBufferNotice(const AVCodecBufferNotice &notice, bool flushNow)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    notices_.push_back(notice);
+
+    uint64_t delayUs = batchWindowUs_;
+    if (flushNow || notices_.size() == MAX_BUFFER_NOTICE_NUM) {
+        delayUs = 0;
+    } else if (flushScheduled_) {
+        return;
+    }
+
+    // the notices arrived while the last transaction is on going are sent together even if no window is set.
+    flushScheduled_ = true;
+    auto task = std::make_shared<TaskHandler<void>>([this]() { FlushBufferNotices(); });
+    (void)taskQue_->EnqueueTask(task, false, delayUs);
+}
+
+void AVCodecListenerCallback::FlushBufferNotices()
+{
+    std::vector<AVCodecBufferNotice> notices;
+    std::shared_ptr<AVShMemRing> ring;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notices.swap(notices_);
+        flushScheduled_ = false;
+        ring = noticeRing_;
+    }
+
+    if (ring != nullptr) {
+        size_t pushed = PushToRing(*ring, notices);
+        if (pushed == notices.size()) {
+            return;
+        }
+        MEDIA_LOGW("notice ring is full, send %{public}zu notices through binder", notices.size() - pushed);
+        notices.erase(notices.begin(), notices.begin() + static_cast<ptrdiff_t>(pushed));
+    }
+
+    if (notices.size() == 1) {
+        auto &notice = notices.front();
+        if (notice.isInput) {
+            listener_->OnInputBufferAvailable(notice.index);
+        } else {
+            listener_->OnOutputBufferAvailable(notice.index, notice.info, notice.flag);
+        }
+        return;
+    }
+
+    for (size_t pos = 0; pos < notices.size(); pos += MAX_BUFFER_NOTICE_NUM) {
+        size_t end = std::min(notices.size(), pos + MAX_BUFFER_NOTICE_NUM);
+        std::vector<AVCodecBufferNotice> batch(notices.begin() + pos, notices.begin() + end);
+        listener_->OnBuffersAvailable(batch);
+    }
+}
+
+size_t AVCodecListenerCallback::PushToRing(AVShMemRing &ring, const std::vector<AVCodecBufferNotice> &notices)
+{
+    size_t pushed = 0;
+    for (auto &notice : notices) {
+        AVShMemRingItem item;
+        item.type = notice.isInput ? RING_INPUT_BUFFER_AVAILABLE : RING_OUTPUT_BUFFER_AVAILABLE;
+        item.index = notice.index;
+        item.pts = notice.info.presentationTimeUs;
+        item.size = notice.info.size;
+        item.offset = notice.info.offset;
+        item.flag = static_cast<uint32_t>(notice.flag);
+        if (!ring.Push(item)) {
+            break;
+        }
+        ++pushed;
     }
+    return pushed;
 }
 } // namespace Media
 } // namespace OHOS
@@ -16,8 +16,12 @@
 #ifndef AVCODEC_LISTENER_PROXY_H
 #define AVCODEC_LISTENER_PROXY_H
 
+#include <mutex>
+#include <vector>
 #include "i_standard_avcodec_listener.h"
+#include "avshmem_ring.h"
 #include "media_death_recipient.h"
+#include "task_queue.h"
 #include "nocopyable.h"
 
 namespace OHOS {
@@ -31,9 +35,23 @@ public:
     void OnOutputFormatChanged(const Format &format) override;
     void OnInputBufferAvailable(uint32_t index) override;
     void OnOutputBufferAvailable(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag) override;
+    int32_t SetNoticeRing(const std::shared_ptr<AVShMemRing> &ring);
 
 private:
+    void AddBufferNotice(const AVCodecBufferNotice &notice, bool flushNow);
+    void FlushBufferNotices();
+    static size_t PushToRing(AVShMemRing &ring, const std::vector<AVCodecBufferNotice> &notices);
+
     sptr<IStandardAVCodecListener> listener_ = nullptr;
+    // coalesce the buffer available notifications into one transaction, the error and format change
+    // notifications are also sent at the task queue to keep the order.
+    std::unique_ptr<TaskQueue> taskQue_;
+    uint64_t batchWindowUs_ = 0;
+    std::mutex mutex_;
+    std::vector<AVCodecBufferNotice> notices_;
+    bool flushScheduled_ = false;
+    // the notices are pushed to the ring if it is set, only the overflowed ones go through the binder.
+    std::shared_ptr<AVShMemRing> noticeRing_ = nullptr;
 };
 
 class AVCodecListenerProxy : public IRemoteProxy<IStandardAVCodecListener>, public NoCopyable {
@@ -45,6 +63,7 @@ public:
     void OnOutputFormatChanged(const Format &format) override;
     void OnInputBufferAvailable(uint32_t index) override;
     void OnOutputBufferAvailable(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag) override;
+    void OnBuffersAvailable(const std::vector<AVCodecBufferNotice> &notices) override;
 
 private:
     static inline BrokerDelegator<AVCodecListenerProxy> delegator_;
@@ -14,6 +14,7 @@
  */
 
 #include "avcodec_listener_stub.h"
+#include "i_standard_avcodec_service.h"
 #include "media_errors.h"
 #include "media_log.h"
 #include "media_parcel.h"
@@ -31,6 +32,7 @@ AVCodecListenerStub::AVCodecListenerStub()
 
 AVCodecListenerStub::~AVCodecListenerStub()
 {
+    StopNoticeRing();
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances destroy", FAKE_POINTER(this));
 }
 
@@ -43,6 +45,7 @@ int AVCodecListenerStub::OnRemoteRequest(uint32_t code, MessageParcel &data, Mes
         return MSERR_INVALID_OPERATION;
     }
 
+    DrainNoticeRing();
     switch (code) {
         case AVCodecListenerMsg::ON_ERROR: {
             int32_t errorType = data.ReadInt32();
@@ -71,6 +74,23 @@ int AVCodecListenerStub::OnRemoteRequest(uint32_t code, MessageParcel &data, Mes
             OnOutputBufferAvailable(index, info, flag);
             return MSERR_OK;
         }
+        case AVCodecListenerMsg::ON_BUFFERS_AVAILABLE: {
+            uint32_t count = data.ReadUint32();
+            CHECK_AND_RETURN_RET_LOG(count <= MAX_BUFFER_NOTICE_NUM, MSERR_INVALID_VAL, "invalid notice count");
+            std::vector<AVCodecBufferNotice> notices(count);
+            for (auto &notice : notices) {
+                notice.isInput = data.ReadBool();
+                notice.index = data.ReadUint32();
+                if (!notice.isInput) {
+                    notice.info.presentationTimeUs = data.ReadInt64();
+                    notice.info.size = data.ReadInt32();
+                    notice.info.offset = data.ReadInt32();
+                    notice.flag = static_cast<AVCodecBufferFlag>(data.ReadInt32());
+                }
+            }
+            OnBuffersAvailable(notices);
+            return MSERR_OK;
+        }
         default: {
             MEDIA_LOGE("default case, need check AVCodecListenerStub");
             return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
@@ -106,9 +126,111 @@ void AVCodecListenerStub::OnOutputBufferAvailable(uint32_t index, AVCodecBufferI
     }
 }
 
+void AVCodecListenerStub::OnBuffersAvailable(const std::vector<AVCodecBufferNotice> &notices)
+{
+    if (callback_ == nullptr) {
+        return;
+    }
+    for (auto &notice : notices) {
+        if (notice.isInput) {
+            callback_->OnInputBufferAvailable(notice.index);
+        } else {
+            callback_->OnOutputBufferAvailable(notice.index, notice.info, notice.flag);
+        }
+    }
+}
+
 void AVCodecListenerStub::SetCallback(const std::shared_ptr<AVCodecCallback> &callback)
 {
     callback_ = callback;
 }
+
+int32_t AVCodecListenerStub::SetNoticeRing(const std::shared_ptr<AVShMemRing> &ring)
+{
+    CHECK_AND_RETURN_RET_LOG(ring != nullptr, MSERR_INVALID_VAL, "ring is nullptr");
+    CHECK_AND_RETURN_RET_LOG(ringTask_ == nullptr, MSERR_INVALID_OPERATION, "notice ring is set already");
+
+    auto ringTask = std::make_unique<TaskQueue>("AVCodecNoticeRing");
+    int32_t ret = ringTask->Start();
+    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "start ring task queue failed");
+
+    {
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        noticeRing_ = ring;
+    }
+    ringStopped_ = false;
+    ringTask_ = std::move(ringTask);
+    auto task = std::make_shared<TaskHandler<void>>([this]() { ConsumeNoticeRing(); });
+    ret = ringTask_->EnqueueTask(task);
+    if (ret != MSERR_OK) {
+        MEDIA_LOGE("enqueue ring task failed");
+        StopNoticeRing();
+    }
+    return ret;
+}
+
+void AVCodecListenerStub::StopNoticeRing()
+{
+    std::shared_ptr<AVShMemRing> ring;
+    {
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        ring = noticeRing_;
+    }
+    ringStopped_ = true;
+    if (ring != nullptr) {
+        ring->Wakeup();
+    }
+    if (ringTask_ != nullptr) {
+        (void)ringTask_->Stop();
+        ringTask_ = nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    noticeRing_ = nullptr;
+}
+
+void AVCodecListenerStub::ConsumeNoticeRing()
+{
+    MEDIA_LOGI("notice ring consumer start");
+    while (!ringStopped_.load()) {
+        std::shared_ptr<AVShMemRing> ring;
+        {
+            std::lock_guard<std::mutex> lock(ringMutex_);
+            ring = noticeRing_;
+        }
+        CHECK_AND_BREAK_LOG(ring != nullptr, "notice ring is nullptr");
+        if (ring->Wait(-1) == MSERR_OK) {
+            DrainNoticeRing();
+        }
+    }
+    MEDIA_LOGI("notice ring consumer exit");
+}
+
+void AVCodecListenerStub::DrainNoticeRing()
+{
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    if (noticeRing_ == nullptr) {
+        return;
+    }
+
+    std::vector<AVShMemRingItem> items;
+    (void)noticeRing_->Pop(items, AVCODEC_RING_CAPACITY);
+    if (callback_ == nullptr) {
+        return;
+    }
+    for (auto &item : items) {
+        if (item.type == RING_INPUT_BUFFER_AVAILABLE) {
+            callback_->OnInputBufferAvailable(item.index);
+        } else if (item.type == RING_OUTPUT_BUFFER_AVAILABLE) {
+            AVCodecBufferInfo info;
+            info.presentationTimeUs = item.pts;
+            info.size = item.size;
+            info.offset = item.offset;
+            callback_->OnOutputBufferAvailable(item.index, info, static_cast<AVCodecBufferFlag>(item.flag));
+        } else {
+            MEDIA_LOGE("unknown ring notice type: %{public}u", item.type);
+        }
+    }
+}
 } // namespace Media
 } // namespace OHOS
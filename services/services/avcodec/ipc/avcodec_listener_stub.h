@@ -16,8 +16,12 @@
 #ifndef AVCODEC_LISTENER_STUB_H
 #define AVCODEC_LISTENER_STUB_H
 
+#include <atomic>
+#include <mutex>
 #include "i_standard_avcodec_listener.h"
 #include "avcodec_common.h"
+#include "avshmem_ring.h"
+#include "task_queue.h"
 
 namespace OHOS {
 namespace Media {
@@ -30,10 +34,21 @@ public:
     void OnOutputFormatChanged(const Format &format) override;
     void OnInputBufferAvailable(uint32_t index) override;
     void OnOutputBufferAvailable(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag) override;
+    void OnBuffersAvailable(const std::vector<AVCodecBufferNotice> &notices) override;
     void SetCallback(const std::shared_ptr<AVCodecCallback> &callback);
+    int32_t SetNoticeRing(const std::shared_ptr<AVShMemRing> &ring);
+    void StopNoticeRing();
 
 private:
+    void ConsumeNoticeRing();
+    void DrainNoticeRing();
+
     std::shared_ptr<AVCodecCallback> callback_ = nullptr;
+    // the notices in the ring are dispatched before any binder message, to keep the notify order.
+    std::shared_ptr<AVShMemRing> noticeRing_ = nullptr;
+    std::unique_ptr<TaskQueue> ringTask_;
+    std::atomic<bool> ringStopped_ = false;
+    std::mutex ringMutex_;
 };
 } // namespace Media
 } // namespace OHOS
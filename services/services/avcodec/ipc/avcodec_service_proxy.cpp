@@ -396,6 +396,34 @@ int32_t AVCodecServiceProxy::QueueInputBuffer(uint32_t index, AVCodecBufferInfo
     return reply.ReadInt32();
 }
 
+int32_t AVCodecServiceProxy::QueueInputBuffers(const std::vector<AVCodecInputRequest> &requests)
+{
+    CHECK_AND_RETURN_RET_LOG(requests.size() <= MAX_AVCODEC_BATCH_NUM, MSERR_INVALID_VAL, "too many buffers");
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if (!data.WriteInterfaceToken(AVCodecServiceProxy::GetDescriptor())) {
+        MEDIA_LOGE("Failed to write descriptor");
+        return MSERR_UNKNOWN;
+    }
+
+    data.WriteUint32(static_cast<uint32_t>(requests.size()));
+    for (auto &request : requests) {
+        data.WriteUint32(request.index);
+        data.WriteInt64(request.info.presentationTimeUs);
+        data.WriteInt32(request.info.size);
+        data.WriteInt32(request.info.offset);
+        data.WriteInt32(static_cast<int32_t>(request.flag));
+    }
+    int32_t ret = Remote()->SendRequest(QUEUE_INPUT_BUFFERS, data, reply, option);
+    if (ret != MSERR_OK) {
+        MEDIA_LOGE("QueueInputBuffers failed, error: %{public}d", ret);
+        return ret;
+    }
+    return reply.ReadInt32();
+}
+
 std::shared_ptr<AVSharedMemory> AVCodecServiceProxy::GetOutputBuffer(uint32_t index)
 {
     MessageParcel data;
@@ -478,6 +506,28 @@ int32_t AVCodecServiceProxy::ReleaseOutputBuffer(uint32_t index, bool render)
     return reply.ReadInt32();
 }
 
+int32_t AVCodecServiceProxy::ReleaseOutputBuffers(const std::vector<uint32_t> &indexes, bool render)
+{
+    CHECK_AND_RETURN_RET_LOG(indexes.size() <= MAX_AVCODEC_BATCH_NUM, MSERR_INVALID_VAL, "too many buffers");
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if (!data.WriteInterfaceToken(AVCodecServiceProxy::GetDescriptor())) {
+        MEDIA_LOGE("Failed to write descriptor");
+        return MSERR_UNKNOWN;
+    }
+
+    data.WriteUInt32Vector(indexes);
+    data.WriteBool(render);
+    int32_t ret = Remote()->SendRequest(RELEASE_OUTPUT_BUFFERS, data, reply, option);
+    if (ret != MSERR_OK) {
+        MEDIA_LOGE("ReleaseOutputBuffers failed, error: %{public}d", ret);
+        return ret;
+    }
+    return reply.ReadInt32();
+}
+
 int32_t AVCodecServiceProxy::SetParameter(const Format &format)
 {
     MessageParcel data;
@@ -498,6 +548,32 @@ int32_t AVCodecServiceProxy::SetParameter(const Format &format)
     return reply.ReadInt32();
 }
 
+int32_t AVCodecServiceProxy::SetBufferRings(const std::shared_ptr<AVShMemRing> &requestRing,
+    const std::shared_ptr<AVShMemRing> &noticeRing)
+{
+    CHECK_AND_RETURN_RET_LOG(requestRing != nullptr && noticeRing != nullptr, MSERR_INVALID_VAL, "invalid rings");
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if (!data.WriteInterfaceToken(AVCodecServiceProxy::GetDescriptor())) {
+        MEDIA_LOGE("Failed to write descriptor");
+        return MSERR_UNKNOWN;
+    }
+
+    for (auto &ring : { requestRing, noticeRing }) {
+        int32_t ret = WriteAVSharedMemoryToParcel(ring->GetMemory(), data);
+        CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "write ring memory failed");
+        CHECK_AND_RETURN_RET_LOG(data.WriteFileDescriptor(ring->GetEventFd()), MSERR_UNKNOWN, "write eventfd failed");
+    }
+    int32_t ret = Remote()->SendRequest(SET_BUFFER_RINGS, data, reply, option);
+    if (ret != MSERR_OK) {
+        MEDIA_LOGE("SetBufferRings failed, error: %{public}d", ret);
+        return ret;
+    }
+    return reply.ReadInt32();
+}
+
 int32_t AVCodecServiceProxy::DestroyStub()
 {
     inputBufferCache_ = nullptr;
@@ -39,13 +39,17 @@ public:
     int32_t SetOutputSurface(sptr<OHOS::Surface> surface) override;
     std::shared_ptr<AVSharedMemory> GetInputBuffer(uint32_t index) override;
     int32_t QueueInputBuffer(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag) override;
+    int32_t QueueInputBuffers(const std::vector<AVCodecInputRequest> &requests) override;
     std::shared_ptr<AVSharedMemory> GetOutputBuffer(uint32_t index) override;
     int32_t GetOutputFormat(Format &format) override;
     std::shared_ptr<AudioCaps> GetAudioCaps() override;
     std::shared_ptr<VideoCaps> GetVideoCaps() override;
     int32_t ReleaseOutputBuffer(uint32_t index, bool render) override;
+    int32_t ReleaseOutputBuffers(const std::vector<uint32_t> &indexes, bool render) override;
     int32_t SetParameter(const Format &format) override;
     int32_t DestroyStub() override;
+    int32_t SetBufferRings(const std::shared_ptr<AVShMemRing> &requestRing,
+        const std::shared_ptr<AVShMemRing> &noticeRing) override;
 
 private:
     static inline BrokerDelegator<AVCodecServiceProxy> delegator_;
@@ -95,6 +95,7 @@ AVCodecServiceStub::AVCodecServiceStub()
 
 AVCodecServiceStub::~AVCodecServiceStub()
 {
+    StopRequestRing();
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances destroy", FAKE_POINTER(this));
 }
 
@@ -123,11 +124,15 @@ int32_t AVCodecServiceStub::Init()
     recFuncs_[GET_VIDEO_CAPS] = &AVCodecServiceStub::GetVideoCaps;
     recFuncs_[SET_PARAMETER] = &AVCodecServiceStub::SetParameter;
     recFuncs_[DESTROY] = &AVCodecServiceStub::DestroyStub;
+    recFuncs_[QUEUE_INPUT_BUFFERS] = &AVCodecServiceStub::QueueInputBuffers;
+    recFuncs_[RELEASE_OUTPUT_BUFFERS] = &AVCodecServiceStub::ReleaseOutputBuffers;
+    recFuncs_[SET_BUFFER_RINGS] = &AVCodecServiceStub::SetBufferRings;
     return MSERR_OK;
 }
 
 int32_t AVCodecServiceStub::DestroyStub()
 {
+    StopRequestRing();
     codecServer_ = nullptr;
     outputBufferCache_ = nullptr;
     inputBufferCache_ = nullptr;
@@ -145,6 +150,7 @@ int AVCodecServiceStub::OnRemoteRequest(uint32_t code, MessageParcel &data, Mess
         return MSERR_INVALID_OPERATION;
     }
 
+    DrainRequestRing();
     auto itFunc = recFuncs_.find(code);
     if (itFunc != recFuncs_.end()) {
         auto memberFunc = itFunc->second;
@@ -168,11 +174,12 @@ int32_t AVCodecServiceStub::SetListenerObject(const sptr<IRemoteObject> &object)
     sptr<IStandardAVCodecListener> listener = iface_cast<IStandardAVCodecListener>(object);
     CHECK_AND_RETURN_RET_LOG(listener != nullptr, MSERR_NO_MEMORY, "failed to convert IStandardAVCodecListener");
 
-    std::shared_ptr<AVCodecCallback> callback = std::make_shared<AVCodecListenerCallback>(listener);
+    std::shared_ptr<AVCodecListenerCallback> callback = std::make_shared<AVCodecListenerCallback>(listener);
     CHECK_AND_RETURN_RET_LOG(callback != nullptr, MSERR_NO_MEMORY, "failed to new AVCodecListenerCallback");
 
     CHECK_AND_RETURN_RET_LOG(codecServer_ != nullptr, MSERR_NO_MEMORY, "avcodec server is nullptr");
     (void)codecServer_->SetCallback(callback);
+    listenerCallback_ = callback;
     return MSERR_OK;
 }
 
@@ -258,6 +265,12 @@ int32_t AVCodecServiceStub::QueueInputBuffer(uint32_t index, AVCodecBufferInfo i
     return codecServer_->QueueInputBuffer(index, info, flag);
 }
 
+int32_t AVCodecServiceStub::QueueInputBuffers(const std::vector<AVCodecInputRequest> &requests)
+{
+    CHECK_AND_RETURN_RET_LOG(codecServer_ != nullptr, MSERR_NO_MEMORY, "avcodec server is nullptr");
+    return codecServer_->QueueInputBuffers(requests);
+}
+
 std::shared_ptr<AVSharedMemory> AVCodecServiceStub::GetOutputBuffer(uint32_t index)
 {
     CHECK_AND_RETURN_RET_LOG(codecServer_ != nullptr, nullptr, "avcodec server is nullptr");
@@ -288,12 +301,129 @@ int32_t AVCodecServiceStub::ReleaseOutputBuffer(uint32_t index, bool render)
     return codecServer_->ReleaseOutputBuffer(index, render);
 }
 
+int32_t AVCodecServiceStub::ReleaseOutputBuffers(const std::vector<uint32_t> &indexes, bool render)
+{
+    CHECK_AND_RETURN_RET_LOG(codecServer_ != nullptr, MSERR_NO_MEMORY, "avcodec server is nullptr");
+    return codecServer_->ReleaseOutputBuffers(indexes, render);
+}
+
 int32_t AVCodecServiceStub::SetParameter(const Format &format)
 {
     CHECK_AND_RETURN_RET_LOG(codecServer_ != nullptr, MSERR_NO_MEMORY, "avcodec server is nullptr");
     return codecServer_->SetParameter(format);
 }
 
+int32_t AVCodecServiceStub::SetBufferRings(const std::shared_ptr<AVShMemRing> &requestRing,
+    const std::shared_ptr<AVShMemRing> &noticeRing)
+{
+    CHECK_AND_RETURN_RET_LOG(requestRing != nullptr && noticeRing != nullptr, MSERR_INVALID_VAL, "invalid rings");
+    CHECK_AND_RETURN_RET_LOG(listenerCallback_ != nullptr, MSERR_INVALID_OPERATION, "set listener object first");
+    CHECK_AND_RETURN_RET_LOG(ringTask_ == nullptr, MSERR_INVALID_OPERATION, "buffer rings are set already");
+
+    auto ringTask = std::make_unique<TaskQueue>("AVCodecRing");
+    int32_t ret = ringTask->Start();
+    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "start ring task queue failed");
+
+    {
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        requestRing_ = requestRing;
+    }
+    ringStopped_ = false;
+    ringTask_ = std::move(ringTask);
+    auto task = std::make_shared<TaskHandler<void>>([this]() { ConsumeRequestRing(); });
+    ret = ringTask_->EnqueueTask(task);
+    if (ret == MSERR_OK) {
+        ret = listenerCallback_->SetNoticeRing(noticeRing);
+    }
+    if (ret != MSERR_OK) {
+        MEDIA_LOGE("set buffer rings failed, ret = %{public}d", ret);
+        StopRequestRing();
+    }
+    return ret;
+}
+
+void AVCodecServiceStub::ConsumeRequestRing()
+{
+    MEDIA_LOGI("request ring consumer start");
+    while (!ringStopped_.load()) {
+        std::shared_ptr<AVShMemRing> ring;
+        {
+            std::lock_guard<std::mutex> lock(ringMutex_);
+            ring = requestRing_;
+        }
+        CHECK_AND_BREAK_LOG(ring != nullptr, "request ring is nullptr");
+        if (ring->Wait(-1) == MSERR_OK) {
+            DrainRequestRing();
+        }
+    }
+    MEDIA_LOGI("request ring consumer exit");
+}
+
+void AVCodecServiceStub::DrainRequestRing()
+{
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    if (requestRing_ == nullptr) {
+        return;
+    }
+
+    std::vector<AVShMemRingItem> items;
+    (void)requestRing_->Pop(items, AVCODEC_RING_CAPACITY);
+    for (auto &item : items) {
+        HandleRingRequest(item);
+    }
+}
+
+void AVCodecServiceStub::HandleRingRequest(const AVShMemRingItem &item)
+{
+    CHECK_AND_RETURN_LOG(codecServer_ != nullptr, "avcodec server is nullptr");
+
+    int32_t ret = MSERR_OK;
+    switch (item.type) {
+        case RING_QUEUE_INPUT_BUFFER: {
+            AVCodecBufferInfo info;
+            info.presentationTimeUs = item.pts;
+            info.size = item.size;
+            info.offset = item.offset;
+            ret = codecServer_->QueueInputBuffer(item.index, info, static_cast<AVCodecBufferFlag>(item.flag));
+            break;
+        }
+        case RING_RELEASE_OUTPUT_BUFFER:
+            ret = codecServer_->ReleaseOutputBuffer(item.index, item.flag != 0);
+            break;
+        default:
+            MEDIA_LOGE("unknown ring request type: %{public}u", item.type);
+            ret = MSERR_INVALID_VAL;
+            break;
+    }
+
+    // the client has returned for the ring request, report the failure asynchronously.
+    if (ret != MSERR_OK && listenerCallback_ != nullptr) {
+        MEDIA_LOGE("ring request type %{public}u failed, index: %{public}u, ret: %{public}d",
+            item.type, item.index, ret);
+        listenerCallback_->OnError(AVCODEC_ERROR_INTERNAL, ret);
+    }
+}
+
+void AVCodecServiceStub::StopRequestRing()
+{
+    std::shared_ptr<AVShMemRing> ring;
+    {
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        ring = requestRing_;
+    }
+    ringStopped_ = true;
+    if (ring != nullptr) {
+        ring->Wakeup();
+    }
+    if (ringTask_ != nullptr) {
+        (void)ringTask_->Stop();
+        ringTask_ = nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    requestRing_ = nullptr;
+}
+
 int32_t AVCodecServiceStub::DumpInfo(int32_t fd)
 {
     CHECK_AND_RETURN_RET_LOG(codecServer_ != nullptr, MSERR_NO_MEMORY, "codec server is nullptr");
@@ -416,6 +546,22 @@ int32_t AVCodecServiceStub::QueueInputBuffer(MessageParcel &data, MessageParcel
     return MSERR_OK;
 }
 
+int32_t AVCodecServiceStub::QueueInputBuffers(MessageParcel &data, MessageParcel &reply)
+{
+    uint32_t count = data.ReadUint32();
+    CHECK_AND_RETURN_RET_LOG(count <= MAX_AVCODEC_BATCH_NUM, MSERR_INVALID_VAL, "invalid buffer count");
+    std::vector<AVCodecInputRequest> requests(count);
+    for (auto &request : requests) {
+        request.index = data.ReadUint32();
+        request.info.presentationTimeUs = data.ReadInt64();
+        request.info.size = data.ReadInt32();
+        request.info.offset = data.ReadInt32();
+        request.flag = static_cast<AVCodecBufferFlag>(data.ReadInt32());
+    }
+    reply.WriteInt32(QueueInputBuffers(requests));
+    return MSERR_OK;
+}
+
 int32_t AVCodecServiceStub::GetOutputBuffer(MessageParcel &data, MessageParcel &reply)
 {
     CHECK_AND_RETURN_RET(outputBufferCache_ != nullptr, MSERR_INVALID_OPERATION);
@@ -456,6 +602,16 @@ int32_t AVCodecServiceStub::ReleaseOutputBuffer(MessageParcel &data, MessageParc
     return MSERR_OK;
 }
 
+int32_t AVCodecServiceStub::ReleaseOutputBuffers(MessageParcel &data, MessageParcel &reply)
+{
+    std::vector<uint32_t> indexes;
+    CHECK_AND_RETURN_RET_LOG(data.ReadUInt32Vector(&indexes), MSERR_INVALID_VAL, "read indexes failed");
+    CHECK_AND_RETURN_RET_LOG(indexes.size() <= MAX_AVCODEC_BATCH_NUM, MSERR_INVALID_VAL, "invalid buffer count");
+    bool render = data.ReadBool();
+    reply.WriteInt32(ReleaseOutputBuffers(indexes, render));
+    return MSERR_OK;
+}
+
 int32_t AVCodecServiceStub::SetParameter(MessageParcel &data, MessageParcel &reply)
 {
     Format format;
@@ -464,6 +620,18 @@ int32_t AVCodecServiceStub::SetParameter(MessageParcel &data, MessageParcel &rep
     return MSERR_OK;
 }
 
+int32_t AVCodecServiceStub::SetBufferRings(MessageParcel &data, MessageParcel &reply)
+{
+    std::shared_ptr<AVShMemRing> rings[2]; // the request ring and the notice ring
+    for (auto &ring : rings) {
+        auto memory = ReadAVSharedMemoryFromParcel(data);
+        int32_t eventFd = data.ReadFileDescriptor();
+        ring = AVShMemRing::Attach(memory, eventFd);
+    }
+    reply.WriteInt32(SetBufferRings(rings[0], rings[1]));
+    return MSERR_OK;
+}
+
 int32_t AVCodecServiceStub::DestroyStub(MessageParcel &data, MessageParcel &reply)
 {
     (void)data;
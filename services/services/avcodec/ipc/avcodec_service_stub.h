@@ -16,11 +16,14 @@
 #ifndef AVCODEC_SERVICE_STUB_H
 #define AVCODEC_SERVICE_STUB_H
 
+#include <atomic>
 #include <map>
 #include "i_standard_avcodec_listener.h"
 #include "i_standard_avcodec_service.h"
+#include "avcodec_listener_proxy.h"
 #include "avcodec_server.h"
 #include "media_death_recipient.h"
+#include "task_queue.h"
 #include "nocopyable.h"
 
 namespace OHOS {
@@ -45,13 +48,17 @@ public:
     int32_t SetOutputSurface(sptr<OHOS::Surface> surface) override;
     std::shared_ptr<AVSharedMemory> GetInputBuffer(uint32_t index) override;
     int32_t QueueInputBuffer(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag) override;
+    int32_t QueueInputBuffers(const std::vector<AVCodecInputRequest> &requests) override;
     std::shared_ptr<AVSharedMemory> GetOutputBuffer(uint32_t index) override;
     int32_t GetOutputFormat(Format &format) override;
     std::shared_ptr<AudioCaps> GetAudioCaps() override;
     std::shared_ptr<VideoCaps> GetVideoCaps() override;
     int32_t ReleaseOutputBuffer(uint32_t index, bool render) override;
+    int32_t ReleaseOutputBuffers(const std::vector<uint32_t> &indexes, bool render) override;
     int32_t SetParameter(const Format &format) override;
     int32_t DestroyStub() override;
+    int32_t SetBufferRings(const std::shared_ptr<AVShMemRing> &requestRing,
+        const std::shared_ptr<AVShMemRing> &noticeRing) override;
     int32_t DumpInfo(int32_t fd);
 
 private:
@@ -70,21 +77,35 @@ private:
     int32_t SetOutputSurface(MessageParcel &data, MessageParcel &reply);
     int32_t GetInputBuffer(MessageParcel &data, MessageParcel &reply);
     int32_t QueueInputBuffer(MessageParcel &data, MessageParcel &reply);
+    int32_t QueueInputBuffers(MessageParcel &data, MessageParcel &reply);
     int32_t GetOutputBuffer(MessageParcel &data, MessageParcel &reply);
     int32_t GetOutputFormat(MessageParcel &data, MessageParcel &reply);
     int32_t GetAudioCaps(MessageParcel &data, MessageParcel &reply);
     int32_t GetVideoCaps(MessageParcel &data, MessageParcel &reply);
     int32_t ReleaseOutputBuffer(MessageParcel &data, MessageParcel &reply);
+    int32_t ReleaseOutputBuffers(MessageParcel &data, MessageParcel &reply);
     int32_t SetParameter(MessageParcel &data, MessageParcel &reply);
     int32_t DestroyStub(MessageParcel &data, MessageParcel &reply);
+    int32_t SetBufferRings(MessageParcel &data, MessageParcel &reply);
+    void ConsumeRequestRing();
+    void DrainRequestRing();
+    void HandleRingRequest(const AVShMemRingItem &item);
+    void StopRequestRing();
 
     std::shared_ptr<IAVCodecService> codecServer_ = nullptr;
+    std::shared_ptr<AVCodecListenerCallback> listenerCallback_ = nullptr;
     std::map<uint32_t, AVCodecStubFunc> recFuncs_;
     std::mutex mutex_;
 
     class AVCodecBufferCache;
     std::unique_ptr<AVCodecBufferCache> inputBufferCache_;
     std::unique_ptr<AVCodecBufferCache> outputBufferCache_;
+
+    // the requests pushed to the ring are handled before any binder request, to keep the call order.
+    std::shared_ptr<AVShMemRing> requestRing_ = nullptr;
+    std::unique_ptr<TaskQueue> ringTask_;
+    std::atomic<bool> ringStopped_ = false;
+    std::mutex ringMutex_;
 };
 } // namespace Media
 } // namespace OHOS
@@ -16,6 +16,7 @@
 #ifndef I_STANDARD_AVCODEC_LISTENER_H
 #define I_STANDARD_AVCODEC_LISTENER_H
 
+#include <vector>
 #include "ipc_types.h"
 #include "iremote_broker.h"
 #include "iremote_proxy.h"
@@ -24,6 +25,19 @@
 
 namespace OHOS {
 namespace Media {
+/**
+ * The buffer available notification carried by the batched IPC, the info and flag are only
+ * meaningful for the output buffers.
+ */
+struct AVCodecBufferNotice {
+    bool isInput = false;
+    uint32_t index = 0;
+    AVCodecBufferInfo info;
+    AVCodecBufferFlag flag = AVCODEC_BUFFER_FLAG_NONE;
+};
+
+constexpr uint32_t MAX_BUFFER_NOTICE_NUM = 64;
+
 class IStandardAVCodecListener : public IRemoteBroker {
 public:
     virtual ~IStandardAVCodecListener() = default;
@@ -31,6 +45,7 @@ public:
     virtual void OnOutputFormatChanged(const Format &format) = 0;
     virtual void OnInputBufferAvailable(uint32_t index) = 0;
     virtual void OnOutputBufferAvailable(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag) = 0;
+    virtual void OnBuffersAvailable(const std::vector<AVCodecBufferNotice> &notices) = 0;
 
     /**
      * IPC code ID
@@ -39,7 +54,8 @@ public:
         ON_ERROR = 0,
         ON_OUTPUT_FORMAT_CHANGED,
         ON_INPUT_BUFFER_AVAILABLE,
-        ON_OUTPUT_BUFFER_AVAILABLE
+        ON_OUTPUT_BUFFER_AVAILABLE,
+        ON_BUFFERS_AVAILABLE
     };
 
     DECLARE_INTERFACE_DESCRIPTOR(u"IStandardAVCodecListener");
@@ -20,13 +20,29 @@
 #include "iremote_broker.h"
 #include "iremote_proxy.h"
 #include "iremote_stub.h"
+#include "i_avcodec_service.h"
 #include "avcodec_common.h"
 #include "avcodec_info.h"
 #include "avsharedmemory.h"
+#include "avshmem_ring.h"
 #include "surface.h"
 
 namespace OHOS {
 namespace Media {
+/**
+ * The type of the AVShMemRingItem exchanged through the buffer rings. The request ring carries the
+ * RING_QUEUE_INPUT_BUFFER and RING_RELEASE_OUTPUT_BUFFER (the flag is the render), the notice ring
+ * carries the buffer available notifications.
+ */
+enum AVCodecRingItemType : uint32_t {
+    RING_QUEUE_INPUT_BUFFER = 1,
+    RING_RELEASE_OUTPUT_BUFFER,
+    RING_INPUT_BUFFER_AVAILABLE,
+    RING_OUTPUT_BUFFER_AVAILABLE,
+};
+
+constexpr uint32_t AVCODEC_RING_CAPACITY = 256;
+
 class IStandardAVCodecService : public IRemoteBroker {
 public:
     virtual ~IStandardAVCodecService() = default;
@@ -44,13 +60,17 @@ public:
     virtual int32_t SetOutputSurface(sptr<OHOS::Surface> surface) = 0;
     virtual std::shared_ptr<AVSharedMemory> GetInputBuffer(uint32_t index) = 0;
     virtual int32_t QueueInputBuffer(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag) = 0;
+    virtual int32_t QueueInputBuffers(const std::vector<AVCodecInputRequest> &requests) = 0;
     virtual std::shared_ptr<AVSharedMemory> GetOutputBuffer(uint32_t index) = 0;
     virtual int32_t GetOutputFormat(Format &format) = 0;
     virtual std::shared_ptr<AudioCaps> GetAudioCaps() = 0;
     virtual std::shared_ptr<VideoCaps> GetVideoCaps() = 0;
     virtual int32_t ReleaseOutputBuffer(uint32_t index, bool render = false) = 0;
+    virtual int32_t ReleaseOutputBuffers(const std::vector<uint32_t> &indexes, bool render = false) = 0;
     virtual int32_t SetParameter(const Format &format) = 0;
     virtual int32_t DestroyStub() = 0;
+    virtual int32_t SetBufferRings(const std::shared_ptr<AVShMemRing> &requestRing,
+        const std::shared_ptr<AVShMemRing> &noticeRing) = 0;
 
     /**
      * IPC code ID
@@ -75,7 +95,10 @@ public:
         GET_VIDEO_CAPS,
         RELEASE_OUTPUT_BUFFER,
         SET_PARAMETER,
-        DESTROY
+        DESTROY,
+        QUEUE_INPUT_BUFFERS,
+        RELEASE_OUTPUT_BUFFERS,
+        SET_BUFFER_RINGS
     };
 
     DECLARE_INTERFACE_DESCRIPTOR(u"IStandardAVCodecService");
@@ -185,6 +185,21 @@ std::shared_ptr<AVSharedMemory> AVCodecServer::GetInputBuffer(uint32_t index)
 int32_t AVCodecServer::QueueInputBuffer(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag)
 {
     std::lock_guard<std::mutex> lock(mutex_);
+    return QueueInputBufferLocked(index, info, flag);
+}
+
+int32_t AVCodecServer::QueueInputBuffers(const std::vector<AVCodecInputRequest> &requests)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &request : requests) {
+        int32_t ret = QueueInputBufferLocked(request.index, request.info, request.flag);
+        CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "queue input buffer %{public}u failed", request.index);
+    }
+    return MSERR_OK;
+}
+
+int32_t AVCodecServer::QueueInputBufferLocked(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag)
+{
     CHECK_AND_RETURN_RET_LOG(status_ == AVCODEC_RUNNING, MSERR_INVALID_OPERATION, "invalid state");
     CHECK_AND_RETURN_RET_LOG(codecEngine_ != nullptr, MSERR_NO_MEMORY, "engine is nullptr");
     int32_t ret = codecEngine_->QueueInputBuffer(index, info, flag);
@@ -237,6 +252,19 @@ int32_t AVCodecServer::ReleaseOutputBuffer(uint32_t index, bool render)
     return codecEngine_->ReleaseOutputBuffer(index, render);
 }
 
+int32_t AVCodecServer::ReleaseOutputBuffers(const std::vector<uint32_t> &indexes, bool render)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(status_ == AVCODEC_RUNNING || status_ == AVCODEC_END_OF_STREAM,
+        MSERR_INVALID_OPERATION, "invalid state");
+    CHECK_AND_RETURN_RET_LOG(codecEngine_ != nullptr, MSERR_NO_MEMORY, "engine is nullptr");
+    for (auto index : indexes) {
+        int32_t ret = codecEngine_->ReleaseOutputBuffer(index, render);
+        CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "release output buffer %{public}u failed", index);
+    }
+    return MSERR_OK;
+}
+
 int32_t AVCodecServer::SetParameter(const Format &format)
 {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -51,11 +51,13 @@ public:
     int32_t SetOutputSurface(sptr<Surface> surface) override;
     std::shared_ptr<AVSharedMemory> GetInputBuffer(uint32_t index) override;
     int32_t QueueInputBuffer(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag) override;
+    int32_t QueueInputBuffers(const std::vector<AVCodecInputRequest> &requests) override;
     std::shared_ptr<AVSharedMemory> GetOutputBuffer(uint32_t index) override;
     int32_t GetOutputFormat(Format &format) override;
     std::shared_ptr<AudioCaps> GetAudioCaps() override;
     std::shared_ptr<VideoCaps> GetVideoCaps() override;
     int32_t ReleaseOutputBuffer(uint32_t index, bool render) override;
+    int32_t ReleaseOutputBuffers(const std::vector<uint32_t> &indexes, bool render) override;
     int32_t SetParameter(const Format &format) override;
     int32_t SetCallback(const std::shared_ptr<AVCodecCallback> &callback) override;
     int32_t DumpInfo(int32_t fd);
@@ -68,6 +70,7 @@ public:
 
 private:
     int32_t Init();
+    int32_t QueueInputBufferLocked(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag);
     const std::string &GetStatusDescription(OHOS::Media::AVCodecServer::AVCodecStatus status);
 
     AVCodecStatus status_ = AVCODEC_UNINITIALIZED;
@@ -96,6 +96,14 @@ std::shared_ptr<AVSharedMemory> AVMetadataHelperClient::FetchFrameAtTime(int64_t
     return avMetadataHelperProxy_->FetchFrameAtTime(timeUs, option, param);
 }
 
+std::vector<std::shared_ptr<AVSharedMemory>> AVMetadataHelperClient::FetchFramesAtTimes(
+    const std::vector<int64_t> &timesUs, int32_t option, const OutputConfiguration &param)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(avMetadataHelperProxy_ != nullptr, {}, "avmetadatahelper service does not exist.");
+    return avMetadataHelperProxy_->FetchFramesAtTimes(timesUs, option, param);
+}
+
 void AVMetadataHelperClient::Release()
 {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -35,6 +35,8 @@ public:
     std::shared_ptr<AVSharedMemory> FetchArtPicture() override;
     std::shared_ptr<AVSharedMemory> FetchFrameAtTime(int64_t timeUs,
         int32_t option, const OutputConfiguration &param) override;
+    std::vector<std::shared_ptr<AVSharedMemory>> FetchFramesAtTimes(const std::vector<int64_t> &timesUs,
+        int32_t option, const OutputConfiguration &param) override;
     void Release() override;
 
     // AVMetadataHelperClient
@@ -207,6 +207,43 @@ std::shared_ptr<AVSharedMemory> AVMetadataHelperServiceProxy::FetchFrameAtTime(i
     return ReadAVSharedMemoryFromParcel(reply);
 }
 
+std::vector<std::shared_ptr<AVSharedMemory>> AVMetadataHelperServiceProxy::FetchFramesAtTimes(
+    const std::vector<int64_t> &timesUs, int32_t option, const OutputConfiguration &param)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption opt;
+
+    if (!data.WriteInterfaceToken(AVMetadataHelperServiceProxy::GetDescriptor())) {
+        MEDIA_LOGE("Failed to write descriptor");
+        return {};
+    }
+
+    (void)data.WriteInt64Vector(timesUs);
+    (void)data.WriteInt32(option);
+    (void)data.WriteInt32(param.dstWidth);
+    (void)data.WriteInt32(param.dstHeight);
+    (void)data.WriteInt32(static_cast<int32_t>(param.colorFormat));
+
+    int error = Remote()->SendRequest(FETCH_FRAMES_AT_TIMES, data, reply, opt);
+    if (error != MSERR_OK) {
+        MEDIA_LOGE("FetchFramesAtTimes failed, error: %{public}d", error);
+        return {};
+    }
+
+    uint32_t count = reply.ReadUint32();
+    if (count != timesUs.size()) {
+        MEDIA_LOGE("FetchFramesAtTimes failed, frame number mismatch: %{public}u", count);
+        return {};
+    }
+
+    std::vector<std::shared_ptr<AVSharedMemory>> frames;
+    for (uint32_t i = 0; i < count; ++i) {
+        frames.push_back(reply.ReadBool() ? ReadAVSharedMemoryFromParcel(reply) : nullptr);
+    }
+    return frames;
+}
+
 void AVMetadataHelperServiceProxy::Release()
 {
     MessageParcel data;
@@ -57,6 +57,7 @@ int32_t AVMetadataHelperServiceStub::Init()
     avMetadataHelperFuncs_[RESOLVE_METADATA_MAP] = &AVMetadataHelperServiceStub::ResolveMetadataMap;
     avMetadataHelperFuncs_[FETCH_ART_PICTURE] = &AVMetadataHelperServiceStub::FetchArtPicture;
     avMetadataHelperFuncs_[FETCH_FRAME_AT_TIME] = &AVMetadataHelperServiceStub::FetchFrameAtTime;
+    avMetadataHelperFuncs_[FETCH_FRAMES_AT_TIMES] = &AVMetadataHelperServiceStub::FetchFramesAtTimes;
     avMetadataHelperFuncs_[RELEASE] = &AVMetadataHelperServiceStub::Release;
     avMetadataHelperFuncs_[DESTROY] = &AVMetadataHelperServiceStub::DestroyStub;
     return MSERR_OK;
@@ -133,6 +134,13 @@ std::shared_ptr<AVSharedMemory> AVMetadataHelperServiceStub::FetchFrameAtTime(in
     return avMetadateHelperServer_->FetchFrameAtTime(timeUs, option, param);
 }
 
+std::vector<std::shared_ptr<AVSharedMemory>> AVMetadataHelperServiceStub::FetchFramesAtTimes(
+    const std::vector<int64_t> &timesUs, int32_t option, const OutputConfiguration &param)
+{
+    CHECK_AND_RETURN_RET_LOG(avMetadateHelperServer_ != nullptr, {}, "avmetadatahelper server is nullptr");
+    return avMetadateHelperServer_->FetchFramesAtTimes(timesUs, option, param);
+}
+
 void AVMetadataHelperServiceStub::Release()
 {
     CHECK_AND_RETURN_LOG(avMetadateHelperServer_ != nullptr, "avmetadatahelper server is nullptr");
@@ -202,6 +210,29 @@ int32_t AVMetadataHelperServiceStub::FetchFrameAtTime(MessageParcel &data, Messa
     return WriteAVSharedMemoryToParcel(ashMem, reply);
 }
 
+int32_t AVMetadataHelperServiceStub::FetchFramesAtTimes(MessageParcel &data, MessageParcel &reply)
+{
+    std::vector<int64_t> timesUs;
+    CHECK_AND_RETURN_RET_LOG(data.ReadInt64Vector(&timesUs), MSERR_INVALID_VAL, "read times failed");
+    CHECK_AND_RETURN_RET_LOG(!timesUs.empty() && timesUs.size() <= static_cast<size_t>(MAX_FETCH_FRAMES_NUM),
+        MSERR_INVALID_VAL, "invalid frame number: %{public}zu", timesUs.size());
+    int32_t option = data.ReadInt32();
+    OutputConfiguration param = {data.ReadInt32(), data.ReadInt32(), static_cast<PixelFormat>(data.ReadInt32())};
+    auto ashMems = FetchFramesAtTimes(timesUs, option, param);
+    CHECK_AND_RETURN_RET_LOG(ashMems.size() == timesUs.size(), MSERR_INVALID_OPERATION, "fetch frames failed");
+
+    // all frames go back in one reply, a frame that can not be fetched is marked as absent.
+    (void)reply.WriteUint32(static_cast<uint32_t>(ashMems.size()));
+    for (auto &ashMem : ashMems) {
+        (void)reply.WriteBool(ashMem != nullptr);
+        if (ashMem != nullptr) {
+            int32_t ret = WriteAVSharedMemoryToParcel(ashMem, reply);
+            CHECK_AND_RETURN_RET(ret == MSERR_OK, ret);
+        }
+    }
+    return MSERR_OK;
+}
+
 int32_t AVMetadataHelperServiceStub::Release(MessageParcel &data, MessageParcel &reply)
 {
     Release();
@@ -77,6 +77,18 @@ public:
      */
     virtual std::shared_ptr<AVSharedMemory> FetchFrameAtTime(
         int64_t timeUs, int32_t option, const OutputConfiguration &param) = 0;
+
+    /**
+     * Fetch the representative video frames near the given timestamps in one call, see
+     * {@link FetchFrameAtTime}. This method must be called after the SetSource.
+     * @param timesUs The time positions in microseconds where the frames will be fetched.
+     * @param option the hint about how to fetch the frames, see {@link AVMetadataQueryOption}
+     * @param param the desired configuration of returned video frames, see {@link OutputConfiguration}.
+     * @return Returns the video frames in the same order as timesUs, an element is null if the
+     * frame at that position cannot be fetched. Returns an empty vector if no frame can be fetched.
+     */
+    virtual std::vector<std::shared_ptr<AVSharedMemory>> FetchFramesAtTimes(
+        const std::vector<int64_t> &timesUs, int32_t option, const OutputConfiguration &param) = 0;
 };
 } // namespace Media
 } // namespace OHOS
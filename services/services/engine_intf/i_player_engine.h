@@ -22,6 +22,7 @@
 #include <refbase.h>
 #include "player.h"
 #include "nocopyable.h"
+#include "media_errors.h"
 
 namespace OHOS {
 class Surface;
@@ -40,6 +41,11 @@ public:
 
     virtual int32_t SetSource(const std::string &url) = 0;
     virtual int32_t SetSource(const std::shared_ptr<IMediaDataSource> &dataSrc) = 0;
+    virtual int32_t SetNextSource(const std::string &url)
+    {
+        (void)url;
+        return MSERR_UNSUPPORT;
+    }
     virtual int32_t Play() = 0;
     virtual int32_t Prepare() = 0;
     virtual int32_t PrepareAsync() = 0;
@@ -60,6 +66,10 @@ public:
     virtual int32_t SetLooping(bool loop) = 0;
     virtual int32_t SetParameter(const Format &param) = 0;
     virtual int32_t SetObs(const std::weak_ptr<IPlayerEngineObs> &obs) = 0;
+    virtual void DumpInfo(std::string &dumpString)
+    {
+        (void)dumpString;
+    }
 };
 } // namespace Media
 } // namespace OHOS
@@ -14,16 +14,96 @@
  */
 
 #include "media_data_source_proxy.h"
+#include <mutex>
+#include <unordered_map>
 #include "media_log.h"
 #include "media_errors.h"
 #include "avsharedmemory_ipc.h"
 
 namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "MediaDataSourceProxy"};
+constexpr size_t MAX_CACHED_BUFFER_NUM = 32;
 }
 
 namespace OHOS {
 namespace Media {
+/**
+ * Each memory is shared to the remote only once and referred by its id later. The id is never
+ * reused, so the remote either finds the right memory or reports the miss, then the memory is
+ * shared again.
+ */
+class MediaDataSourceProxy::MediaDataBufferCache : public NoCopyable {
+public:
+    MediaDataBufferCache() = default;
+    ~MediaDataBufferCache() = default;
+
+    int32_t WriteToParcel(const std::shared_ptr<AVSharedMemory> &memory, bool forceUpdate, MessageParcel &parcel)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto iter = caches_.find(memory.get());
+        // the address may be reused by a new memory after the cached one is released.
+        if (iter != caches_.end() && iter->second.memory.lock() != memory) {
+            caches_.erase(iter);
+            iter = caches_.end();
+        }
+
+        if (iter != caches_.end() && !forceUpdate) {
+            parcel.WriteUint32(iter->second.id);
+            parcel.WriteUint8(CacheFlag::HIT_CACHE);
+            return MSERR_OK;
+        }
+
+        uint32_t id = 0;
+        if (iter == caches_.end()) {
+            ShrinkLocked();
+            id = nextId_++;
+            caches_.emplace(memory.get(), CacheItem { id, memory });
+            MEDIA_LOGI("add cached data source buffer, id: %{public}u", id);
+        } else {
+            id = iter->second.id;
+        }
+        parcel.WriteUint32(id);
+        parcel.WriteUint8(CacheFlag::UPDATE_CACHE);
+        return WriteAVSharedMemoryToParcel(memory, parcel);
+    }
+
+private:
+    void ShrinkLocked()
+    {
+        for (auto iter = caches_.begin(); iter != caches_.end();) {
+            if (iter->second.memory.expired()) {
+                iter = caches_.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+        if (caches_.size() < MAX_CACHED_BUFFER_NUM) {
+            return;
+        }
+        auto oldest = caches_.begin();
+        for (auto iter = caches_.begin(); iter != caches_.end(); ++iter) {
+            if (iter->second.id < oldest->second.id) {
+                oldest = iter;
+            }
+        }
+        caches_.erase(oldest);
+    }
+
+    enum CacheFlag : uint8_t {
+        HIT_CACHE = 1,
+        UPDATE_CACHE,
+    };
+
+    struct CacheItem {
+        uint32_t id;
+        std::weak_ptr<AVSharedMemory> memory;
+    };
+
+    std::mutex mutex_;
+    std::unordered_map<AVSharedMemory *, CacheItem> caches_;
+    uint32_t nextId_ = 0;
+};
+
 MediaDataCallback::MediaDataCallback(const sptr<IStandardMediaDataSource> &ipcProxy)
     : callbackProxy_(ipcProxy)
 {
@@ -54,7 +134,8 @@ int32_t MediaDataCallback::GetSize(int64_t &size)
 }
 
 MediaDataSourceProxy::MediaDataSourceProxy(const sptr<IRemoteObject> &impl)
-    : IRemoteProxy<IStandardMediaDataSource>(impl)
+    : IRemoteProxy<IStandardMediaDataSource>(impl),
+      bufferCache_(std::make_unique<MediaDataBufferCache>())
 {
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances create", FAKE_POINTER(this));
 }
@@ -66,45 +147,49 @@ MediaDataSourceProxy::~MediaDataSourceProxy()
 
 int32_t MediaDataSourceProxy::ReadAt(int64_t pos, uint32_t length, const std::shared_ptr<AVSharedMemory> &mem)
 {
-    MessageParcel data;
-    MessageParcel reply;
-    MessageOption option(MessageOption::TF_SYNC);
-
-    if (!data.WriteInterfaceToken(MediaDataSourceProxy::GetDescriptor())) {
-        MEDIA_LOGE("Failed to write descriptor");
-        return MSERR_UNKNOWN;
-    }
-
-    data.WriteInt64(pos);
-    data.WriteUint32(length);
-    CHECK_AND_RETURN_RET_LOG(WriteAVSharedMemoryToParcel(mem, data) == MSERR_OK, 0, "write parcel failed");
-    int error = Remote()->SendRequest(ListenerMsg::READ_AT_POS, data, reply, option);
-    if (error != MSERR_OK) {
-        MEDIA_LOGE("ReadAt failed, error: %{public}d", error);
-        return 0;
-    }
-    return reply.ReadInt32();
+    return SendReadRequest(ListenerMsg::READ_AT_POS, pos, length, mem);
 }
 
 int32_t MediaDataSourceProxy::ReadAt(uint32_t length, const std::shared_ptr<AVSharedMemory> &mem)
 {
-    MessageParcel data;
-    MessageParcel reply;
-    MessageOption option(MessageOption::TF_SYNC);
-
-    if (!data.WriteInterfaceToken(MediaDataSourceProxy::GetDescriptor())) {
-        MEDIA_LOGE("Failed to write descriptor");
-        return MSERR_UNKNOWN;
-    }
+    return SendReadRequest(ListenerMsg::READ_AT, 0, length, mem);
+}
 
-    data.WriteUint32(length);
-    CHECK_AND_RETURN_RET_LOG(WriteAVSharedMemoryToParcel(mem, data) == MSERR_OK, 0, "write parcel failed");
-    int error = Remote()->SendRequest(ListenerMsg::READ_AT, data, reply, option);
-    if (error != MSERR_OK) {
-        MEDIA_LOGE("ReadAt failed, error: %{public}d", error);
-        return 0;
+int32_t MediaDataSourceProxy::SendReadRequest(uint32_t code, int64_t pos, uint32_t length,
+    const std::shared_ptr<AVSharedMemory> &mem)
+{
+    CHECK_AND_RETURN_RET_LOG(mem != nullptr, 0, "mem is nullptr");
+
+    // resend the memory once if the remote reports the cache miss.
+    bool forceUpdate = false;
+    for (int32_t i = 0; i < 2; i++) {
+        MessageParcel data;
+        MessageParcel reply;
+        MessageOption option(MessageOption::TF_SYNC);
+
+        if (!data.WriteInterfaceToken(MediaDataSourceProxy::GetDescriptor())) {
+            MEDIA_LOGE("Failed to write descriptor");
+            return MSERR_UNKNOWN;
+        }
+
+        if (code == ListenerMsg::READ_AT_POS) {
+            data.WriteInt64(pos);
+        }
+        data.WriteUint32(length);
+        CHECK_AND_RETURN_RET_LOG(bufferCache_->WriteToParcel(mem, forceUpdate, data) == MSERR_OK, 0,
+            "write parcel failed");
+        int error = Remote()->SendRequest(code, data, reply, option);
+        if (error != MSERR_OK) {
+            MEDIA_LOGE("ReadAt failed, error: %{public}d", error);
+            return 0;
+        }
+        if (reply.ReadInt32() == MSERR_OK) {
+            return reply.ReadInt32();
+        }
+        MEDIA_LOGW("remote buffer cache miss, resend the memory");
+        forceUpdate = true;
     }
-    return reply.ReadInt32();
+    return 0;
 }
 
 int32_t MediaDataSourceProxy::GetSize(int64_t &size)
@@ -45,7 +45,11 @@ public:
     int32_t GetSize(int64_t &size) override;
 
 private:
+    int32_t SendReadRequest(uint32_t code, int64_t pos, uint32_t length, const std::shared_ptr<AVSharedMemory> &mem);
+
     static inline BrokerDelegator<MediaDataSourceProxy> delegator_;
+    class MediaDataBufferCache;
+    std::unique_ptr<MediaDataBufferCache> bufferCache_;
 };
 } // namespace Media
 } // namespace OHOS
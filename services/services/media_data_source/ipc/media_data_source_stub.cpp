@@ -14,6 +14,8 @@
  */
 
 #include "media_data_source_stub.h"
+#include <map>
+#include <mutex>
 #include "media_log.h"
 #include "media_errors.h"
 #include "media_data_source.h"
@@ -21,12 +23,57 @@
 
 namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "MediaDataSourceStub"};
+constexpr size_t MAX_CACHED_BUFFER_NUM = 32;
 }
 
 namespace OHOS {
 namespace Media {
+class MediaDataSourceStub::MediaDataBufferCache : public NoCopyable {
+public:
+    MediaDataBufferCache() = default;
+    ~MediaDataBufferCache() = default;
+
+    int32_t ReadFromParcel(MessageParcel &parcel, std::shared_ptr<AVSharedMemory> &memory)
+    {
+        uint32_t id = parcel.ReadUint32();
+        CacheFlag flag = static_cast<CacheFlag>(parcel.ReadUint8());
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto iter = caches_.find(id);
+        if (flag == CacheFlag::HIT_CACHE) {
+            CHECK_AND_RETURN_RET_LOG(iter != caches_.end(), MSERR_INVALID_VAL,
+                "mark hit cache, but can not find the cache, id: %{public}u", id);
+            memory = iter->second;
+            return MSERR_OK;
+        }
+
+        CHECK_AND_RETURN_RET_LOG(flag == CacheFlag::UPDATE_CACHE, MSERR_INVALID_VAL,
+            "invalid cache flag: %{public}hhu", flag);
+        memory = ReadAVSharedMemoryFromParcel(parcel);
+        CHECK_AND_RETURN_RET(memory != nullptr, MSERR_INVALID_VAL);
+        if (iter != caches_.end()) {
+            iter->second = memory;
+            return MSERR_OK;
+        }
+        // the ids increase, the smallest one is the oldest.
+        if (caches_.size() >= MAX_CACHED_BUFFER_NUM) {
+            caches_.erase(caches_.begin());
+        }
+        caches_.emplace(id, memory);
+        return MSERR_OK;
+    }
+
+private:
+    enum CacheFlag : uint8_t {
+        HIT_CACHE = 1,
+        UPDATE_CACHE,
+    };
+
+    std::mutex mutex_;
+    std::map<uint32_t, std::shared_ptr<AVSharedMemory>> caches_;
+};
+
 MediaDataSourceStub::MediaDataSourceStub(const std::shared_ptr<IMediaDataSource> &dataSrc)
-    : dataSrc_(dataSrc)
+    : dataSrc_(dataSrc), bufferCache_(std::make_unique<MediaDataBufferCache>())
 {
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances create", FAKE_POINTER(this));
 }
@@ -48,17 +95,19 @@ int MediaDataSourceStub::OnRemoteRequest(uint32_t code, MessageParcel &data, Mes
     switch (code) {
         case ListenerMsg::READ_AT: {
             uint32_t length = data.ReadUint32();
-            std::shared_ptr<AVSharedMemory> mem = ReadAVSharedMemoryFromParcel(data);
-            int32_t realLen = ReadAt(length, mem);
-            reply.WriteInt32(realLen);
+            std::shared_ptr<AVSharedMemory> mem = nullptr;
+            int32_t ret = bufferCache_->ReadFromParcel(data, mem);
+            reply.WriteInt32(ret);
+            reply.WriteInt32(ret == MSERR_OK ? ReadAt(length, mem) : 0);
             return MSERR_OK;
         }
         case ListenerMsg::READ_AT_POS: {
             int64_t pos = data.ReadInt64();
             uint32_t length = data.ReadUint32();
-            std::shared_ptr<AVSharedMemory> mem = ReadAVSharedMemoryFromParcel(data);
-            int32_t realLen = ReadAt(pos, length, mem);
-            reply.WriteInt32(realLen);
+            std::shared_ptr<AVSharedMemory> mem = nullptr;
+            int32_t ret = bufferCache_->ReadFromParcel(data, mem);
+            reply.WriteInt32(ret);
+            reply.WriteInt32(ret == MSERR_OK ? ReadAt(pos, length, mem) : 0);
             return MSERR_OK;
         }
         case ListenerMsg::GET_SIZE: {
@@ -34,6 +34,8 @@ public:
 
 private:
     std::shared_ptr<IMediaDataSource> dataSrc_ = nullptr;
+    class MediaDataBufferCache;
+    std::unique_ptr<MediaDataBufferCache> bufferCache_;
 };
 } // namespace Media
 } // namespace OHOS
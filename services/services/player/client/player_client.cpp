@@ -64,9 +64,23 @@ int32_t PlayerClient::CreateListenerObject()
     return playerProxy_->SetListenerObject(object);
 }
 
+void PlayerClient::InvalidateClock()
+{
+    // the position is got from the server until the new clock anchor published, the server adopts
+    // the new epoch with the next request, so a failed request never leaves the two sides apart.
+    if (listenerStub_ == nullptr) {
+        return;
+    }
+    uint32_t epoch = listenerStub_->InvalidateClock();
+    if (playerProxy_ != nullptr) {
+        playerProxy_->SetClockEpoch(epoch);
+    }
+}
+
 void PlayerClient::MediaServerDied()
 {
     std::lock_guard<std::mutex> lock(mutex_);
+    InvalidateClock();
     playerProxy_ = nullptr;
     listenerStub_ = nullptr;
     if (callback_ != nullptr) {
@@ -78,6 +92,7 @@ int32_t PlayerClient::SetSource(const std::string &url)
 {
     std::lock_guard<std::mutex> lock(mutex_);
     CHECK_AND_RETURN_RET_LOG(playerProxy_ != nullptr, MSERR_NO_MEMORY, "player service does not exist..");
+    InvalidateClock();
     return playerProxy_->SetSource(url);
 }
 
@@ -92,6 +107,7 @@ int32_t PlayerClient::SetSource(const std::shared_ptr<IMediaDataSource> &dataSrc
 
     sptr<IRemoteObject> object = dataSrcStub_->AsObject();
     CHECK_AND_RETURN_RET_LOG(object != nullptr, MSERR_NO_MEMORY, "listener object is nullptr..");
+    InvalidateClock();
     return playerProxy_->SetSource(object);
 }
 
@@ -99,13 +115,29 @@ int32_t PlayerClient::SetSource(int32_t fd, int64_t offset, int64_t size)
 {
     std::lock_guard<std::mutex> lock(mutex_);
     CHECK_AND_RETURN_RET_LOG(playerProxy_ != nullptr, MSERR_NO_MEMORY, "player service does not exist..");
+    InvalidateClock();
     return playerProxy_->SetSource(fd, offset, size);
 }
 
+int32_t PlayerClient::SetNextSource(const std::string &url)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(playerProxy_ != nullptr, MSERR_NO_MEMORY, "player service does not exist..");
+    return playerProxy_->SetNextSource(url);
+}
+
+int32_t PlayerClient::SetNextSource(int32_t fd, int64_t offset, int64_t size)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN_RET_LOG(playerProxy_ != nullptr, MSERR_NO_MEMORY, "player service does not exist..");
+    return playerProxy_->SetNextSource(fd, offset, size);
+}
+
 int32_t PlayerClient::Play()
 {
     std::lock_guard<std::mutex> lock(mutex_);
     CHECK_AND_RETURN_RET_LOG(playerProxy_ != nullptr, MSERR_NO_MEMORY, "player service does not exist..");
+    InvalidateClock();
     return playerProxy_->Play();
 }
 
@@ -113,6 +145,7 @@ int32_t PlayerClient::Prepare()
 {
     std::lock_guard<std::mutex> lock(mutex_);
     CHECK_AND_RETURN_RET_LOG(playerProxy_ != nullptr, MSERR_NO_MEMORY, "player service does not exist..");
+    InvalidateClock();
     return playerProxy_->Prepare();
 }
 
@@ -120,6 +153,7 @@ int32_t PlayerClient::PrepareAsync()
 {
     std::lock_guard<std::mutex> lock(mutex_);
     CHECK_AND_RETURN_RET_LOG(playerProxy_ != nullptr, MSERR_NO_MEMORY, "player service does not exist..");
+    InvalidateClock();
     return playerProxy_->PrepareAsync();
 }
 
@@ -127,6 +161,7 @@ int32_t PlayerClient::Pause()
 {
     std::lock_guard<std::mutex> lock(mutex_);
     CHECK_AND_RETURN_RET_LOG(playerProxy_ != nullptr, MSERR_NO_MEMORY, "player service does not exist..");
+    InvalidateClock();
     return playerProxy_->Pause();
 }
 
@@ -134,6 +169,7 @@ int32_t PlayerClient::Stop()
 {
     std::lock_guard<std::mutex> lock(mutex_);
     CHECK_AND_RETURN_RET_LOG(playerProxy_ != nullptr, MSERR_NO_MEMORY, "player service does not exist..");
+    InvalidateClock();
     return playerProxy_->Stop();
 }
 
@@ -142,12 +178,14 @@ int32_t PlayerClient::Reset()
     std::lock_guard<std::mutex> lock(mutex_);
     dataSrcStub_ = nullptr;
     CHECK_AND_RETURN_RET_LOG(playerProxy_ != nullptr, MSERR_NO_MEMORY, "player service does not exist..");
+    InvalidateClock();
     return playerProxy_->Reset();
 }
 
 int32_t PlayerClient::Release()
 {
     std::lock_guard<std::mutex> lock(mutex_);
+    InvalidateClock();
     callback_ = nullptr;
     listenerStub_ = nullptr;
     dataSrcStub_ = nullptr;
@@ -167,12 +205,16 @@ int32_t PlayerClient::Seek(int32_t mSeconds, PlayerSeekMode mode)
 {
     std::lock_guard<std::mutex> lock(mutex_);
     CHECK_AND_RETURN_RET_LOG(playerProxy_ != nullptr, MSERR_NO_MEMORY, "player service does not exist..");
+    InvalidateClock();
     return playerProxy_->Seek(mSeconds, mode);
 }
 
 int32_t PlayerClient::GetCurrentTime(int32_t &currentTime)
 {
     std::lock_guard<std::mutex> lock(mutex_);
+    if (listenerStub_ != nullptr && listenerStub_->GetCurrentTime(currentTime)) {
+        return MSERR_OK;
+    }
     CHECK_AND_RETURN_RET_LOG(playerProxy_ != nullptr, MSERR_NO_MEMORY, "player service does not exist..");
     return playerProxy_->GetCurrentTime(currentTime);
 }
@@ -209,6 +251,7 @@ int32_t PlayerClient::SetPlaybackSpeed(PlaybackRateMode mode)
 {
     std::lock_guard<std::mutex> lock(mutex_);
     CHECK_AND_RETURN_RET_LOG(playerProxy_ != nullptr, MSERR_NO_MEMORY, "player service does not exist..");
+    InvalidateClock();
     return playerProxy_->SetPlaybackSpeed(mode);
 }
 
@@ -259,7 +302,23 @@ int32_t PlayerClient::SetParameter(const Format &param)
 {
     std::lock_guard<std::mutex> lock(mutex_);
     CHECK_AND_RETURN_RET_LOG(playerProxy_ != nullptr, MSERR_NO_MEMORY, "player service does not exist..");
-    return playerProxy_->SetParameter(param);
+    if (!param.ContainKey(PlayerKeys::PLAYER_POSITION_UPDATE_INTERVAL)) {
+        return playerProxy_->SetParameter(param);
+    }
+
+    // the position updates are generated at the client side
+    int32_t intervalMs = 0;
+    CHECK_AND_RETURN_RET_LOG(param.GetIntValue(PlayerKeys::PLAYER_POSITION_UPDATE_INTERVAL, intervalMs),
+        MSERR_INVALID_VAL, "invalid position update interval");
+    CHECK_AND_RETURN_RET_LOG(listenerStub_ != nullptr, MSERR_NO_MEMORY, "listenerStub_ is nullptr..");
+    listenerStub_->SetPositionUpdateInterval(intervalMs);
+
+    Format remoteParam = param;
+    remoteParam.RemoveKey(PlayerKeys::PLAYER_POSITION_UPDATE_INTERVAL);
+    if (remoteParam.Empty()) {
+        return MSERR_OK;
+    }
+    return playerProxy_->SetParameter(remoteParam);
 }
 
 int32_t PlayerClient::SetPlayerCallback(const std::shared_ptr<PlayerCallback> &callback)
@@ -16,6 +16,7 @@
 #ifndef I_STANDARD_PLAYER_LISTENER_H
 #define I_STANDARD_PLAYER_LISTENER_H
 
+#include <chrono>
 #include "ipc_types.h"
 #include "iremote_broker.h"
 #include "iremote_proxy.h"
@@ -24,15 +25,50 @@
 
 namespace OHOS {
 namespace Media {
+/**
+ * The playback clock published to the client when the state, the rate or the position jumps, the
+ * client extrapolates the current position from it instead of the position update of each tick.
+ */
+struct PlayerClockAnchor {
+    // the media time at the clockUs, in ms
+    int32_t mediaTimeMs = 0;
+    // the monotonic clock when the anchor is taken, in us
+    int64_t clockUs = 0;
+    float rate = 1.0f;
+    bool running = false;
+    // the client queries the server if the anchor is invalid
+    bool valid = false;
+    // bumped by the client on each call that moves the position, the rate or the state and sent with
+    // the call, the server adopts it and the client drops the anchors taken before its last such call.
+    uint32_t epoch = 0;
+
+    static int64_t GetClockUs()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    int32_t GetMediaTimeMs(int64_t nowUs) const
+    {
+        if (!running || nowUs <= clockUs) {
+            return mediaTimeMs;
+        }
+        constexpr double usPerMs = 1000.0;
+        return mediaTimeMs + static_cast<int32_t>(static_cast<double>(nowUs - clockUs) * rate / usPerMs);
+    }
+};
+
 class IStandardPlayerListener : public IRemoteBroker {
 public:
     virtual ~IStandardPlayerListener() = default;
     virtual void OnError(PlayerErrorType errorType, int32_t errorCode) = 0;
     virtual void OnInfo(PlayerOnInfoType type, int32_t extra, const Format &infoBody) = 0;
+    virtual void OnClockAnchor(const PlayerClockAnchor &anchor) = 0;
 
     enum PlayerListenerMsg {
         ON_ERROR = 0,
         ON_INFO,
+        ON_CLOCK_ANCHOR,
     };
 
     DECLARE_INTERFACE_DESCRIPTOR(u"IStandardPlayerListener");
@@ -31,6 +31,8 @@ public:
     virtual int32_t SetSource(const std::string &url) = 0;
     virtual int32_t SetSource(const sptr<IRemoteObject> &object) = 0;
     virtual int32_t SetSource(int32_t fd, int64_t offset, int64_t size) = 0;
+    virtual int32_t SetNextSource(const std::string &url) = 0;
+    virtual int32_t SetNextSource(int32_t fd, int64_t offset, int64_t size) = 0;
     virtual int32_t Play() = 0;
     virtual int32_t Prepare() = 0;
     virtual int32_t PrepareAsync() = 0;
@@ -55,6 +57,14 @@ public:
     virtual int32_t SetParameter(const Format &param) = 0;
     virtual int32_t DestroyStub() = 0;
     virtual int32_t SetPlayerCallback() = 0;
+    /**
+     * Set the clock epoch sent with the calls that the client invalidates its clock for, the server
+     * adopts it for the clock anchors published after the call, see PlayerClockAnchor::epoch.
+     */
+    virtual void SetClockEpoch(uint32_t epoch)
+    {
+        (void)epoch;
+    }
 
     /**
      * IPC code ID
@@ -87,7 +97,9 @@ public:
         GET_VIDEO_TRACK_INFO,
         GET_AUDIO_TRACK_INFO,
         GET_VIDEO_WIDTH,
-        GET_VIDEO_HEIGHT
+        GET_VIDEO_HEIGHT,
+        SET_NEXT_SOURCE,
+        SET_NEXT_FD_SOURCE
     };
 
     DECLARE_INTERFACE_DESCRIPTOR(u"IStandardPlayerService");
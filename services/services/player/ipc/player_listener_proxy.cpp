@@ -14,12 +14,16 @@
  */
 
 #include "player_listener_proxy.h"
+#include <cstdlib>
 #include "media_log.h"
 #include "media_errors.h"
 #include "media_parcel.h"
 
 namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "PlayerListenerProxy"};
+// republish the anchor if the position drifts from the extrapolated one more than this
+constexpr int32_t DRIFT_TOLERANCE_MS = 100;
+constexpr float DEFAULT_RATE = 1.0f;
 }
 
 namespace OHOS {
@@ -77,6 +81,28 @@ void PlayerListenerProxy::OnInfo(PlayerOnInfoType type, int32_t extra, const For
     }
 }
 
+void PlayerListenerProxy::OnClockAnchor(const PlayerClockAnchor &anchor)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_ASYNC);
+
+    if (!data.WriteInterfaceToken(PlayerListenerProxy::GetDescriptor())) {
+        MEDIA_LOGE("Failed to write descriptor");
+        return;
+    }
+    data.WriteInt32(anchor.mediaTimeMs);
+    data.WriteInt64(anchor.clockUs);
+    data.WriteFloat(anchor.rate);
+    data.WriteBool(anchor.running);
+    data.WriteBool(anchor.valid);
+    data.WriteUint32(anchor.epoch);
+    int error = Remote()->SendRequest(PlayerListenerMsg::ON_CLOCK_ANCHOR, data, reply, option);
+    if (error != MSERR_OK) {
+        MEDIA_LOGE("on clock anchor failed, error: %{public}d", error);
+    }
+}
+
 PlayerListenerCallback::PlayerListenerCallback(const sptr<IStandardPlayerListener> &listener) : listener_(listener)
 {
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances create", FAKE_POINTER(this));
@@ -84,6 +110,8 @@ PlayerListenerCallback::PlayerListenerCallback(const sptr<IStandardPlayerListene
 
 PlayerListenerCallback::~PlayerListenerCallback()
 {
+    MEDIA_LOGI("position updates: %{public}" PRIu64 ", clock anchors sent: %{public}" PRIu64 "",
+        positionUpdateCount_, anchorCount_);
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances destroy", FAKE_POINTER(this));
 }
 
@@ -97,9 +125,116 @@ void PlayerListenerCallback::OnError(PlayerErrorType errorType, int32_t errorCod
 
 void PlayerListenerCallback::OnInfo(PlayerOnInfoType type, int32_t extra, const Format &infoBody)
 {
-    if (listener_ != nullptr) {
+    CHECK_AND_RETURN(listener_ != nullptr);
+    // the position updates are extrapolated at the client, only the anchor changes are sent.
+    if (type != INFO_TYPE_POSITION_UPDATE) {
         listener_->OnInfo(type, extra, infoBody);
     }
+
+    PlayerClockAnchor anchor;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!UpdateClockLocked(type, extra, infoBody)) {
+            return;
+        }
+        anchor = anchor_;
+        anchorCount_++;
+    }
+    listener_->OnClockAnchor(anchor);
+}
+
+void PlayerListenerCallback::SetClockEpoch(uint32_t epoch)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    anchor_.epoch = epoch;
+}
+
+bool PlayerListenerCallback::UpdateClockLocked(PlayerOnInfoType type, int32_t extra, const Format &infoBody)
+{
+    int64_t nowUs = PlayerClockAnchor::GetClockUs();
+    switch (type) {
+        case INFO_TYPE_POSITION_UPDATE:
+            positionUpdateCount_++;
+            return OnPositionUpdatedLocked(extra, nowUs);
+        case INFO_TYPE_STATE_CHANGE: {
+            int32_t position = GetPositionLocked(nowUs);
+            state_ = static_cast<PlayerStates>(extra);
+            if (state_ == PLAYER_STOPPED || state_ == PLAYER_IDLE || state_ == PLAYER_INITIALIZED) {
+                // the engine restores the default rate, the server sets the rate again after prepared.
+                position = 0;
+                anchor_.rate = DEFAULT_RATE;
+                buffering_ = false;
+            }
+            ResetAnchorLocked(position, nowUs);
+            return true;
+        }
+        case INFO_TYPE_SEEKDONE:
+            ResetAnchorLocked(extra, nowUs);
+            return true;
+        case INFO_TYPE_SPEEDDONE: {
+            int32_t position = GetPositionLocked(nowUs);
+            // the rate actually applied by the engine, absent if the rate is not changed.
+            double rate = DEFAULT_RATE;
+            if (infoBody.GetDoubleValue(PlayerKeys::PLAYER_PLAYBACK_RATE, rate)) {
+                anchor_.rate = static_cast<float>(rate);
+            }
+            ResetAnchorLocked(position, nowUs);
+            return true;
+        }
+        case INFO_TYPE_BUFFERING_UPDATE:
+            return OnBufferingUpdatedLocked(infoBody, nowUs);
+        case INFO_TYPE_NEXT_SOURCE_START:
+            // the position restarts from the beginning of the next source.
+            ResetAnchorLocked(0, nowUs);
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool PlayerListenerCallback::OnBufferingUpdatedLocked(const Format &infoBody, int64_t nowUs)
+{
+    // the video is frozen while buffering, stop the clock until the buffering ends.
+    bool buffering = buffering_;
+    if (infoBody.ContainKey(PlayerKeys::PLAYER_BUFFERING_START)) {
+        buffering = true;
+    } else if (infoBody.ContainKey(PlayerKeys::PLAYER_BUFFERING_END)) {
+        buffering = false;
+    }
+    if (buffering == buffering_) {
+        return false;
+    }
+
+    int32_t position = GetPositionLocked(nowUs);
+    buffering_ = buffering;
+    ResetAnchorLocked(position, nowUs);
+    return true;
+}
+
+bool PlayerListenerCallback::OnPositionUpdatedLocked(int32_t position, int64_t nowUs)
+{
+    lastPosition_ = position;
+    if (state_ != PLAYER_STARTED ||
+        (anchor_.valid && std::abs(anchor_.GetMediaTimeMs(nowUs) - position) <= DRIFT_TOLERANCE_MS)) {
+        return false;
+    }
+    ResetAnchorLocked(position, nowUs);
+    return true;
+}
+
+int32_t PlayerListenerCallback::GetPositionLocked(int64_t nowUs) const
+{
+    return anchor_.valid ? anchor_.GetMediaTimeMs(nowUs) : lastPosition_;
+}
+
+void PlayerListenerCallback::ResetAnchorLocked(int32_t mediaTimeMs, int64_t nowUs)
+{
+    anchor_.mediaTimeMs = mediaTimeMs;
+    anchor_.clockUs = nowUs;
+    anchor_.running = state_ == PLAYER_STARTED && !buffering_;
+    // the position at the other states is decided by the engine, such as the duration at the complete.
+    anchor_.valid = state_ == PLAYER_STARTED || state_ == PLAYER_PAUSED;
+    lastPosition_ = mediaTimeMs;
 }
 } // namespace Media
 } // namespace OHOS
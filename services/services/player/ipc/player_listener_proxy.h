@@ -16,6 +16,7 @@
 #ifndef PLAYER_LISTENER_PROXY_H
 #define PLAYER_LISTENER_PROXY_H
 
+#include <mutex>
 #include "i_standard_player_listener.h"
 #include "media_death_recipient.h"
 #include "player_server.h"
@@ -30,9 +31,24 @@ public:
 
     void OnError(PlayerErrorType errorType, int32_t errorCode) override;
     void OnInfo(PlayerOnInfoType type, int32_t extra, const Format &infoBody = {}) override;
+    // the epoch sent by the client with the calls that it drops its clock for, see PlayerClockAnchor::epoch
+    void SetClockEpoch(uint32_t epoch);
 
 private:
+    bool UpdateClockLocked(PlayerOnInfoType type, int32_t extra, const Format &infoBody);
+    bool OnBufferingUpdatedLocked(const Format &infoBody, int64_t nowUs);
+    bool OnPositionUpdatedLocked(int32_t position, int64_t nowUs);
+    int32_t GetPositionLocked(int64_t nowUs) const;
+    void ResetAnchorLocked(int32_t mediaTimeMs, int64_t nowUs);
+
     sptr<IStandardPlayerListener> listener_ = nullptr;
+    std::mutex mutex_;
+    PlayerStates state_ = PLAYER_IDLE;
+    PlayerClockAnchor anchor_;
+    bool buffering_ = false;
+    int32_t lastPosition_ = 0;
+    uint64_t positionUpdateCount_ = 0;
+    uint64_t anchorCount_ = 0;
 };
 
 class PlayerListenerProxy : public IRemoteProxy<IStandardPlayerListener>, public NoCopyable {
@@ -42,6 +58,7 @@ public:
 
     void OnError(PlayerErrorType errorType, int32_t errorCode) override;
     void OnInfo(PlayerOnInfoType type, int32_t extra, const Format &infoBody = {}) override;
+    void OnClockAnchor(const PlayerClockAnchor &anchor) override;
 
 private:
     static inline BrokerDelegator<PlayerListenerProxy> delegator_;
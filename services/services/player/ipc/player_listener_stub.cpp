@@ -14,23 +14,32 @@
  */
 
 #include "player_listener_stub.h"
+#include <algorithm>
 #include "media_log.h"
 #include "media_errors.h"
 #include "media_parcel.h"
 
 namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "PlayerListenerStub"};
+// same as the default position update interval of the engine
+constexpr int32_t DEFAULT_POSITION_UPDATE_INTERVAL_MS = 100;
+constexpr int32_t MAX_POSITION_UPDATE_INTERVAL_MS = 10000;
+constexpr uint64_t US_PER_MS = 1000;
 }
 
 namespace OHOS {
 namespace Media {
 PlayerListenerStub::PlayerListenerStub()
+    : positionUpdateIntervalMs_(DEFAULT_POSITION_UPDATE_INTERVAL_MS)
 {
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances create", FAKE_POINTER(this));
 }
 
 PlayerListenerStub::~PlayerListenerStub()
 {
+    if (clockTask_ != nullptr) {
+        (void)clockTask_->Stop();
+    }
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances destroy", FAKE_POINTER(this));
 }
 
@@ -66,6 +75,17 @@ int PlayerListenerStub::OnRemoteRequest(uint32_t code, MessageParcel &data, Mess
             OnInfo(static_cast<PlayerOnInfoType>(type), extra, format);
             return MSERR_OK;
         }
+        case PlayerListenerMsg::ON_CLOCK_ANCHOR: {
+            PlayerClockAnchor anchor;
+            anchor.mediaTimeMs = data.ReadInt32();
+            anchor.clockUs = data.ReadInt64();
+            anchor.rate = data.ReadFloat();
+            anchor.running = data.ReadBool();
+            anchor.valid = data.ReadBool() && anchor.rate > 0.0f;
+            anchor.epoch = data.ReadUint32();
+            OnClockAnchor(anchor);
+            return MSERR_OK;
+        }
         default: {
             MEDIA_LOGE("default case, need check PlayerListenerStub");
             return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
@@ -89,9 +109,94 @@ void PlayerListenerStub::OnInfo(PlayerOnInfoType type, int32_t extra, const Form
     }
 }
 
+void PlayerListenerStub::OnClockAnchor(const PlayerClockAnchor &anchor)
+{
+    MEDIA_LOGD("0x%{public}06" PRIXPTR " clock anchor: %{public}d ms, rate: %{public}f, running: %{public}d, "
+        "valid: %{public}d", FAKE_POINTER(this), anchor.mediaTimeMs, anchor.rate, anchor.running, anchor.valid);
+    std::unique_lock<std::mutex> lock(clockMutex_);
+    // the anchor is sent oneway, the one taken before the last InvalidateClock may arrive after it.
+    if (static_cast<int32_t>(anchor.epoch - clockEpoch_) < 0) {
+        MEDIA_LOGD("drop the stale clock anchor, epoch: %{public}u, current: %{public}u",
+            anchor.epoch, clockEpoch_);
+        return;
+    }
+    anchor_ = anchor;
+    SchedulePositionTickLocked();
+}
+
 void PlayerListenerStub::SetPlayerCallback(const std::weak_ptr<PlayerCallback> &callback)
 {
+    std::unique_lock<std::mutex> lock(clockMutex_);
     callback_ = callback;
+    SchedulePositionTickLocked();
+}
+
+bool PlayerListenerStub::GetCurrentTime(int32_t &currentTime)
+{
+    std::unique_lock<std::mutex> lock(clockMutex_);
+    if (!anchor_.valid) {
+        return false;
+    }
+    currentTime = anchor_.GetMediaTimeMs(PlayerClockAnchor::GetClockUs());
+    return true;
+}
+
+uint32_t PlayerListenerStub::InvalidateClock()
+{
+    std::unique_lock<std::mutex> lock(clockMutex_);
+    anchor_.valid = false;
+    return ++clockEpoch_;
+}
+
+void PlayerListenerStub::SetPositionUpdateInterval(int32_t intervalMs)
+{
+    std::unique_lock<std::mutex> lock(clockMutex_);
+    positionUpdateIntervalMs_ = std::clamp(intervalMs, 0, MAX_POSITION_UPDATE_INTERVAL_MS);
+    MEDIA_LOGI("position update interval: %{public}d ms", positionUpdateIntervalMs_);
+    SchedulePositionTickLocked();
+}
+
+bool PlayerListenerStub::NeedPositionTickLocked() const
+{
+    return anchor_.valid && anchor_.running && positionUpdateIntervalMs_ > 0 && !callback_.expired();
+}
+
+void PlayerListenerStub::SchedulePositionTickLocked()
+{
+    if (tickScheduled_ || !NeedPositionTickLocked()) {
+        return;
+    }
+
+    if (clockTask_ == nullptr) {
+        auto clockTask = std::make_unique<TaskQueue>("PlayerClock");
+        CHECK_AND_RETURN_LOG(clockTask->Start() == MSERR_OK, "start clock task queue failed");
+        clockTask_ = std::move(clockTask);
+    }
+
+    auto task = std::make_shared<TaskHandler<void>>([this]() { OnPositionTick(); });
+    uint64_t delayUs = static_cast<uint64_t>(positionUpdateIntervalMs_) * US_PER_MS;
+    CHECK_AND_RETURN_LOG(clockTask_->EnqueueTask(task, false, delayUs) == MSERR_OK, "enqueue clock task failed");
+    tickScheduled_ = true;
+}
+
+void PlayerListenerStub::OnPositionTick()
+{
+    std::shared_ptr<PlayerCallback> cb;
+    int32_t position = 0;
+    {
+        std::unique_lock<std::mutex> lock(clockMutex_);
+        tickScheduled_ = false;
+        if (!NeedPositionTickLocked()) {
+            return;
+        }
+        cb = callback_.lock();
+        position = anchor_.GetMediaTimeMs(PlayerClockAnchor::GetClockUs());
+        SchedulePositionTickLocked();
+    }
+
+    if (cb != nullptr) {
+        cb->OnInfo(INFO_TYPE_POSITION_UPDATE, position, {});
+    }
 }
 } // namespace Media
 } // namespace OHOS
@@ -16,9 +16,11 @@
 #ifndef PLAYER_LISTENER_STUB_H
 #define PLAYER_LISTENER_STUB_H
 
+#include <mutex>
 #include "i_standard_player_listener.h"
 #include "player.h"
 #include "format.h"
+#include "task_queue.h"
 
 namespace OHOS {
 namespace Media {
@@ -30,12 +32,36 @@ public:
     int OnRemoteRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option) override;
     void OnError(PlayerErrorType errorType, int32_t errorCode) override;
     void OnInfo(PlayerOnInfoType type, int32_t extra, const Format &infoBody = {}) override;
+    void OnClockAnchor(const PlayerClockAnchor &anchor) override;
 
     // PlayerListenerStub
     void SetPlayerCallback(const std::weak_ptr<PlayerCallback> &callback);
+    /**
+     * Get the position extrapolated from the last clock anchor, return false if the anchor
+     * is invalid, then the position should be got from the server.
+     */
+    bool GetCurrentTime(int32_t &currentTime);
+    /**
+     * Drop the clock anchor until the server publishes the new one, return the new clock epoch that
+     * is sent with the next call, the server adopts it for the anchors published after the call.
+     */
+    uint32_t InvalidateClock();
+    // the interval of the extrapolated position updates, 0 means disable the position updates
+    void SetPositionUpdateInterval(int32_t intervalMs);
 
 private:
+    bool NeedPositionTickLocked() const;
+    void SchedulePositionTickLocked();
+    void OnPositionTick();
+
     std::weak_ptr<PlayerCallback> callback_;
+    std::mutex clockMutex_;
+    PlayerClockAnchor anchor_;
+    uint32_t clockEpoch_ = 0;
+    int32_t positionUpdateIntervalMs_;
+    bool tickScheduled_ = false;
+    // keep it the last member, it is stopped before the other members destroyed
+    std::unique_ptr<TaskQueue> clockTask_;
 };
 } // namespace Media
 } // namespace OHOS
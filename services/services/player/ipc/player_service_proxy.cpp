@@ -68,6 +68,7 @@ int32_t PlayerServiceProxy::SetSource(const std::string &url)
         return MSERR_UNKNOWN;
     }
 
+    data.WriteUint32(clockEpoch_);
     data.WriteString(url);
     int error = Remote()->SendRequest(SET_SOURCE, data, reply, option);
     if (error != MSERR_OK) {
@@ -88,6 +89,7 @@ int32_t PlayerServiceProxy::SetSource(const sptr<IRemoteObject> &object)
         return MSERR_UNKNOWN;
     }
 
+    data.WriteUint32(clockEpoch_);
     (void)data.WriteRemoteObject(object);
     int error = Remote()->SendRequest(SET_MEDIA_DATA_SRC_OBJ, data, reply, option);
     if (error != MSERR_OK) {
@@ -109,6 +111,7 @@ int32_t PlayerServiceProxy::SetSource(int32_t fd, int64_t offset, int64_t size)
         return MSERR_UNKNOWN;
     }
 
+    data.WriteUint32(clockEpoch_);
     (void)data.WriteFileDescriptor(fd);
     (void)data.WriteInt64(offset);
     (void)data.WriteInt64(size);
@@ -120,6 +123,48 @@ int32_t PlayerServiceProxy::SetSource(int32_t fd, int64_t offset, int64_t size)
     return reply.ReadInt32();
 }
 
+int32_t PlayerServiceProxy::SetNextSource(const std::string &url)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if (!data.WriteInterfaceToken(PlayerServiceProxy::GetDescriptor())) {
+        MEDIA_LOGE("Failed to write descriptor");
+        return MSERR_UNKNOWN;
+    }
+
+    data.WriteString(url);
+    int error = Remote()->SendRequest(SET_NEXT_SOURCE, data, reply, option);
+    if (error != MSERR_OK) {
+        MEDIA_LOGE("Set next Source failed, error: %{public}d", error);
+        return error;
+    }
+    return reply.ReadInt32();
+}
+
+int32_t PlayerServiceProxy::SetNextSource(int32_t fd, int64_t offset, int64_t size)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if (!data.WriteInterfaceToken(PlayerServiceProxy::GetDescriptor())) {
+        MEDIA_LOGE("Failed to write descriptor");
+        return MSERR_UNKNOWN;
+    }
+
+    (void)data.WriteFileDescriptor(fd);
+    (void)data.WriteInt64(offset);
+    (void)data.WriteInt64(size);
+    int error = Remote()->SendRequest(SET_NEXT_FD_SOURCE, data, reply, option);
+    if (error != MSERR_OK) {
+        MEDIA_LOGE("Set next fd Source failed, error: %{public}d", error);
+        return error;
+    }
+    return reply.ReadInt32();
+}
+
 int32_t PlayerServiceProxy::Play()
 {
     MessageParcel data;
@@ -131,6 +176,7 @@ int32_t PlayerServiceProxy::Play()
         return MSERR_UNKNOWN;
     }
 
+    data.WriteUint32(clockEpoch_);
     int error = Remote()->SendRequest(PLAY, data, reply, option);
     if (error != MSERR_OK) {
         MEDIA_LOGE("Play failed, error: %{public}d", error);
@@ -150,6 +196,7 @@ int32_t PlayerServiceProxy::Prepare()
         return MSERR_UNKNOWN;
     }
 
+    data.WriteUint32(clockEpoch_);
     int error = Remote()->SendRequest(PREPARE, data, reply, option);
     if (error != MSERR_OK) {
         MEDIA_LOGE("Prepare failed, error: %{public}d", error);
@@ -169,6 +216,7 @@ int32_t PlayerServiceProxy::PrepareAsync()
         return MSERR_UNKNOWN;
     }
 
+    data.WriteUint32(clockEpoch_);
     int error = Remote()->SendRequest(PREPAREASYNC, data, reply, option);
     if (error != MSERR_OK) {
         MEDIA_LOGE("PrepareAsync failed, error: %{public}d", error);
@@ -188,6 +236,7 @@ int32_t PlayerServiceProxy::Pause()
         return MSERR_UNKNOWN;
     }
 
+    data.WriteUint32(clockEpoch_);
     int error = Remote()->SendRequest(PAUSE, data, reply, option);
     if (error != MSERR_OK) {
         MEDIA_LOGE("Pause failed, error: %{public}d", error);
@@ -207,6 +256,7 @@ int32_t PlayerServiceProxy::Stop()
         return MSERR_UNKNOWN;
     }
 
+    data.WriteUint32(clockEpoch_);
     int error = Remote()->SendRequest(STOP, data, reply, option);
     if (error != MSERR_OK) {
         MEDIA_LOGE("Stop failed, error: %{public}d", error);
@@ -226,6 +276,7 @@ int32_t PlayerServiceProxy::Reset()
         return MSERR_UNKNOWN;
     }
 
+    data.WriteUint32(clockEpoch_);
     int error = Remote()->SendRequest(RESET, data, reply, option);
     if (error != MSERR_OK) {
         MEDIA_LOGE("Reset failed, error: %{public}d", error);
@@ -245,6 +296,7 @@ int32_t PlayerServiceProxy::Release()
         return MSERR_UNKNOWN;
     }
 
+    data.WriteUint32(clockEpoch_);
     int error = Remote()->SendRequest(RELEASE, data, reply, option);
     if (error != MSERR_OK) {
         MEDIA_LOGE("Release failed, error: %{public}d", error);
@@ -285,6 +337,7 @@ int32_t PlayerServiceProxy::Seek(int32_t mSeconds, PlayerSeekMode mode)
         return MSERR_UNKNOWN;
     }
 
+    data.WriteUint32(clockEpoch_);
     data.WriteInt32(mSeconds);
     data.WriteInt32(mode);
     int error = Remote()->SendRequest(SEEK, data, reply, option);
@@ -435,6 +488,7 @@ int32_t PlayerServiceProxy::SetPlaybackSpeed(PlaybackRateMode mode)
         return MSERR_UNKNOWN;
     }
 
+    data.WriteUint32(clockEpoch_);
     data.WriteInt32(mode);
     int error = Remote()->SendRequest(SET_PLAYERBACK_SPEED, data, reply, option);
     if (error != MSERR_OK) {
@@ -615,5 +669,10 @@ int32_t PlayerServiceProxy::SetPlayerCallback()
     }
     return reply.ReadInt32();
 }
+
+void PlayerServiceProxy::SetClockEpoch(uint32_t epoch)
+{
+    clockEpoch_ = epoch;
+}
 } // namespace Media
 } // namespace OHOS
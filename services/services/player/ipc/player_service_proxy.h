@@ -29,6 +29,8 @@ public:
     int32_t SetSource(const std::string &url) override;
     int32_t SetSource(const sptr<IRemoteObject> &object) override;
     int32_t SetSource(int32_t fd, int64_t offset, int64_t size) override;
+    int32_t SetNextSource(const std::string &url) override;
+    int32_t SetNextSource(int32_t fd, int64_t offset, int64_t size) override;
     int32_t Play() override;
     int32_t Prepare() override;
     int32_t PrepareAsync() override;
@@ -53,9 +55,11 @@ public:
     int32_t SetParameter(const Format &param) override;
     int32_t DestroyStub() override;
     int32_t SetPlayerCallback() override;
+    void SetClockEpoch(uint32_t epoch) override;
 
 private:
     static inline BrokerDelegator<PlayerServiceProxy> delegator_;
+    uint32_t clockEpoch_ = 0;
 };
 } // namespace Media
 } // namespace OHOS
@@ -14,8 +14,8 @@
  */
 
 #include "player_service_stub.h"
+#include <set>
 #include <unistd.h>
-#include "player_listener_proxy.h"
 #include "media_data_source_proxy.h"
 #include "media_server_manager.h"
 #include "media_log.h"
@@ -24,6 +24,21 @@
 
 namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "PlayerServiceStub"};
+// the calls that carry the client's clock epoch, keep it the same as the PlayerServiceProxy.
+const std::set<uint32_t> CLOCK_EPOCH_CODES = {
+    OHOS::Media::IStandardPlayerService::SET_SOURCE,
+    OHOS::Media::IStandardPlayerService::SET_MEDIA_DATA_SRC_OBJ,
+    OHOS::Media::IStandardPlayerService::SET_FD_SOURCE,
+    OHOS::Media::IStandardPlayerService::PLAY,
+    OHOS::Media::IStandardPlayerService::PREPARE,
+    OHOS::Media::IStandardPlayerService::PREPAREASYNC,
+    OHOS::Media::IStandardPlayerService::PAUSE,
+    OHOS::Media::IStandardPlayerService::STOP,
+    OHOS::Media::IStandardPlayerService::RESET,
+    OHOS::Media::IStandardPlayerService::RELEASE,
+    OHOS::Media::IStandardPlayerService::SEEK,
+    OHOS::Media::IStandardPlayerService::SET_PLAYERBACK_SPEED,
+};
 }
 
 namespace OHOS {
@@ -81,6 +96,8 @@ int32_t PlayerServiceStub::Init()
     playerFuncs_[GET_AUDIO_TRACK_INFO] = &PlayerServiceStub::GetAudioTrackInfo;
     playerFuncs_[GET_VIDEO_WIDTH] = &PlayerServiceStub::GetVideoWidth;
     playerFuncs_[GET_VIDEO_HEIGHT] = &PlayerServiceStub::GetVideoHeight;
+    playerFuncs_[SET_NEXT_SOURCE] = &PlayerServiceStub::SetNextSource;
+    playerFuncs_[SET_NEXT_FD_SOURCE] = &PlayerServiceStub::SetNextFdSource;
     return MSERR_OK;
 }
 
@@ -104,6 +121,11 @@ int PlayerServiceStub::OnRemoteRequest(uint32_t code, MessageParcel &data, Messa
         return MSERR_INVALID_OPERATION;
     }
 
+    // adopt the client's epoch before the call, the anchors taken from now on are not dropped by the client.
+    if (CLOCK_EPOCH_CODES.count(code) != 0) {
+        SetClockEpoch(data.ReadUint32());
+    }
+
     auto itFunc = playerFuncs_.find(code);
     if (itFunc != playerFuncs_.end()) {
         auto memberFunc = itFunc->second;
@@ -127,7 +149,7 @@ int32_t PlayerServiceStub::SetListenerObject(const sptr<IRemoteObject> &object)
     sptr<IStandardPlayerListener> listener = iface_cast<IStandardPlayerListener>(object);
     CHECK_AND_RETURN_RET_LOG(listener != nullptr, MSERR_NO_MEMORY, "failed to convert IStandardPlayerListener");
 
-    std::shared_ptr<PlayerCallback> callback = std::make_shared<PlayerListenerCallback>(listener);
+    auto callback = std::make_shared<PlayerListenerCallback>(listener);
     CHECK_AND_RETURN_RET_LOG(callback != nullptr, MSERR_NO_MEMORY, "failed to new PlayerListenerCallback");
 
     playerCallback_ = callback;
@@ -160,6 +182,18 @@ int32_t PlayerServiceStub::SetSource(int32_t fd, int64_t offset, int64_t size)
     return playerServer_->SetSource(fd, offset, size);
 }
 
+int32_t PlayerServiceStub::SetNextSource(const std::string &url)
+{
+    CHECK_AND_RETURN_RET_LOG(playerServer_ != nullptr, MSERR_NO_MEMORY, "player server is nullptr");
+    return playerServer_->SetNextSource(url);
+}
+
+int32_t PlayerServiceStub::SetNextSource(int32_t fd, int64_t offset, int64_t size)
+{
+    CHECK_AND_RETURN_RET_LOG(playerServer_ != nullptr, MSERR_NO_MEMORY, "player server is nullptr");
+    return playerServer_->SetNextSource(fd, offset, size);
+}
+
 int32_t PlayerServiceStub::Play()
 {
     CHECK_AND_RETURN_RET_LOG(playerServer_ != nullptr, MSERR_NO_MEMORY, "player server is nullptr");
@@ -300,6 +334,13 @@ int32_t PlayerServiceStub::SetPlayerCallback()
     return playerServer_->SetPlayerCallback(playerCallback_);
 }
 
+void PlayerServiceStub::SetClockEpoch(uint32_t epoch)
+{
+    if (playerCallback_ != nullptr) {
+        playerCallback_->SetClockEpoch(epoch);
+    }
+}
+
 int32_t PlayerServiceStub::DumpInfo(int32_t fd)
 {
     CHECK_AND_RETURN_RET_LOG(playerServer_ != nullptr, MSERR_NO_MEMORY, "player server is nullptr");
@@ -337,6 +378,23 @@ int32_t PlayerServiceStub::SetFdSource(MessageParcel &data, MessageParcel &reply
     return MSERR_OK;
 }
 
+int32_t PlayerServiceStub::SetNextSource(MessageParcel &data, MessageParcel &reply)
+{
+    std::string url = data.ReadString();
+    reply.WriteInt32(SetNextSource(url));
+    return MSERR_OK;
+}
+
+int32_t PlayerServiceStub::SetNextFdSource(MessageParcel &data, MessageParcel &reply)
+{
+    int32_t fd = data.ReadFileDescriptor();
+    int64_t offset = data.ReadInt64();
+    int64_t size = data.ReadInt64();
+    reply.WriteInt32(SetNextSource(fd, offset, size));
+    (void)::close(fd);
+    return MSERR_OK;
+}
+
 int32_t PlayerServiceStub::Play(MessageParcel &data, MessageParcel &reply)
 {
     reply.WriteInt32(Play());
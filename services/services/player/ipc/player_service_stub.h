@@ -18,7 +18,7 @@
 
 #include <map>
 #include "i_standard_player_service.h"
-#include "i_standard_player_listener.h"
+#include "player_listener_proxy.h"
 #include "media_death_recipient.h"
 #include "player_server.h"
 
@@ -34,6 +34,8 @@ public:
     int32_t SetSource(const std::string &url) override;
     int32_t SetSource(const sptr<IRemoteObject> &object) override;
     int32_t SetSource(int32_t fd, int64_t offset, int64_t size) override;
+    int32_t SetNextSource(const std::string &url) override;
+    int32_t SetNextSource(int32_t fd, int64_t offset, int64_t size) override;
     int32_t Play() override;
     int32_t Prepare() override;
     int32_t PrepareAsync() override;
@@ -58,6 +60,7 @@ public:
     int32_t SetParameter(const Format &param) override;
     int32_t DestroyStub() override;
     int32_t SetPlayerCallback() override;
+    void SetClockEpoch(uint32_t epoch) override;
     int32_t DumpInfo(int32_t fd);
 
 private:
@@ -67,6 +70,8 @@ private:
     int32_t SetSource(MessageParcel &data, MessageParcel &reply);
     int32_t SetMediaDataSource(MessageParcel &data, MessageParcel &reply);
     int32_t SetFdSource(MessageParcel &data, MessageParcel &reply);
+    int32_t SetNextSource(MessageParcel &data, MessageParcel &reply);
+    int32_t SetNextFdSource(MessageParcel &data, MessageParcel &reply);
     int32_t Play(MessageParcel &data, MessageParcel &reply);
     int32_t Prepare(MessageParcel &data, MessageParcel &reply);
     int32_t PrepareAsync(MessageParcel &data, MessageParcel &reply);
@@ -93,7 +98,7 @@ private:
     int32_t SetPlayerCallback(MessageParcel &data, MessageParcel &reply);
 
     std::mutex mutex_;
-    std::shared_ptr<PlayerCallback> playerCallback_ = nullptr;
+    std::shared_ptr<PlayerListenerCallback> playerCallback_ = nullptr;
     std::shared_ptr<IPlayerService> playerServer_ = nullptr;
     using PlayerStubFunc = int32_t(PlayerServiceStub::*)(MessageParcel &data, MessageParcel &reply);
     std::map<uint32_t, PlayerStubFunc> playerFuncs_;
@@ -114,11 +114,53 @@ int32_t PlayerServer::SetSource(int32_t fd, int64_t offset, int64_t size)
     CHECK_AND_RETURN_RET_LOG(uriHelper->AccessCheck(UriHelper::URI_READ), MSERR_INVALID_VAL, "Failed to read the fd");
     int32_t ret = InitPlayEngine(uriHelper->FormattedUri());
     CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, MSERR_INVALID_OPERATION, "SetSource Failed!");
-    uriHelper_ = std::move(uriHelper);
+    {
+        std::lock_guard<std::mutex> uriLock(uriMutex_);
+        uriHelper_ = std::move(uriHelper);
+    }
     config_.url = "file descriptor source";
     return ret;
 }
 
+int32_t PlayerServer::SetNextSource(const std::string &url)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    MediaTrace trace("PlayerServer::SetNextSource");
+    MEDIA_LOGW("KPI-TRACE: PlayerServer SetNextSource in(url)");
+    int32_t ret = SetNextEngineSource(url);
+    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "SetNextSource Failed!");
+    std::lock_guard<std::mutex> uriLock(uriMutex_);
+    nextUriHelper_ = nullptr;
+    return ret;
+}
+
+int32_t PlayerServer::SetNextSource(int32_t fd, int64_t offset, int64_t size)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    MediaTrace trace("PlayerServer::SetNextSource");
+    MEDIA_LOGW("KPI-TRACE: PlayerServer SetNextSource in(fd)");
+    auto uriHelper = std::make_unique<UriHelper>(fd, offset, size);
+    CHECK_AND_RETURN_RET_LOG(uriHelper->AccessCheck(UriHelper::URI_READ), MSERR_INVALID_VAL, "Failed to read the fd");
+    int32_t ret = SetNextEngineSource(uriHelper->FormattedUri());
+    CHECK_AND_RETURN_RET_LOG(ret == MSERR_OK, ret, "SetNextSource Failed!");
+    // the fd is kept until the next source starts playing, or replaced by another next source
+    std::lock_guard<std::mutex> uriLock(uriMutex_);
+    nextUriHelper_ = std::move(uriHelper);
+    return ret;
+}
+
+int32_t PlayerServer::SetNextEngineSource(const std::string &url)
+{
+    if (status_ != PLAYER_PREPARED && status_ != PLAYER_STARTED && status_ != PLAYER_PAUSED) {
+        MEDIA_LOGE("current state is: %{public}s, not support SetNextSource", GetStatusDescription(status_).c_str());
+        return MSERR_INVALID_OPERATION;
+    }
+    CHECK_AND_RETURN_RET_LOG(dataSrc_ == nullptr, MSERR_INVALID_OPERATION,
+        "SetNextSource is not supported for the media data source");
+    CHECK_AND_RETURN_RET_LOG(playerEngine_ != nullptr, MSERR_NO_MEMORY, "playerEngine_ is nullptr");
+    return playerEngine_->SetNextSource(url);
+}
+
 int32_t PlayerServer::InitPlayEngine(const std::string &url)
 {
     if (status_ != PLAYER_IDLE) {
@@ -315,7 +357,11 @@ int32_t PlayerServer::OnReset()
     playerEngine_ = nullptr;
     dataSrc_ = nullptr;
     config_.looping = false;
-    uriHelper_ = nullptr;
+    {
+        std::lock_guard<std::mutex> uriLock(uriMutex_);
+        uriHelper_ = nullptr;
+        nextUriHelper_ = nullptr;
+    }
     lastErrMsg_.clear();
     Format format;
     OnInfo(INFO_TYPE_STATE_CHANGE, PLAYER_IDLE, format);
@@ -688,6 +734,7 @@ int32_t PlayerServer::DumpInfo(int32_t fd)
     int32_t currentTime;
     CHECK_AND_RETURN_RET(GetCurrentTime(currentTime) == MSERR_OK, MSERR_INVALID_OPERATION);
     dumpString += "PlayerServer current time is: " + std::to_string(currentTime) + "\n";
+    playerEngine_->DumpInfo(dumpString);
     write(fd, dumpString.c_str(), dumpString.size());
 
     return MSERR_OK;
@@ -723,6 +770,10 @@ void PlayerServer::OnInfo(PlayerOnInfoType type, int32_t extra, const Format &in
         MEDIA_LOGI("Callback State change, currentState is %{public}s", GetStatusDescription(status_).c_str());
     } else if (type == INFO_TYPE_SEEKDONE) {
         MediaTrace::TraceEnd("Player::Seek", SEEK_TASK_ID);
+    } else if (type == INFO_TYPE_NEXT_SOURCE_START) {
+        // the previous source is finished, release its fd. the next source set by url leaves nullptr here.
+        std::lock_guard<std::mutex> uriLock(uriMutex_);
+        uriHelper_ = std::move(nextUriHelper_);
     }
 
     if (playerCb_ != nullptr) {
@@ -33,6 +33,8 @@ public:
     int32_t SetSource(const std::string &url) override;
     int32_t SetSource(const std::shared_ptr<IMediaDataSource> &dataSrc) override;
     int32_t SetSource(int32_t fd, int64_t offset, int64_t size) override;
+    int32_t SetNextSource(const std::string &url) override;
+    int32_t SetNextSource(int32_t fd, int64_t offset, int64_t size) override;
     int32_t Play() override;
     int32_t Prepare() override;
     int32_t PrepareAsync() override;
@@ -67,6 +69,7 @@ private:
     bool IsValidSeekMode(PlayerSeekMode mode);
     int32_t OnReset();
     int32_t InitPlayEngine(const std::string &url);
+    int32_t SetNextEngineSource(const std::string &url);
     int32_t OnPrepare(bool async);
     void FormatToString(std::string &dumpString, std::vector<Format> &videoTrack);
     const std::string &GetStatusDescription(int32_t status);
@@ -80,7 +83,9 @@ private:
     TimeMonitor startTimeMonitor_;
     TimeMonitor stopTimeMonitor_;
     std::shared_ptr<IMediaDataSource> dataSrc_ = nullptr;
+    std::mutex uriMutex_;
     std::unique_ptr<UriHelper> uriHelper_;
+    std::unique_ptr<UriHelper> nextUriHelper_;
     struct ConfigInfo {
         bool looping = false;
         float leftVolume = 1.0f; // audiotrack volume range [0, 1]
@@ -24,45 +24,54 @@ namespace OHOS {
 namespace Media {
 bool MediaParcel::Marshalling(MessageParcel &parcel, const Format &format)
 {
-    auto dataMap = format.GetFormatMap();
-    (void)parcel.WriteUint32(dataMap.size());
-    for (auto it = dataMap.begin(); it != dataMap.end(); ++it) {
-        (void)parcel.WriteString(it->first);
-        (void)parcel.WriteUint32(it->second.type);
-        switch (it->second.type) {
+    (void)parcel.WriteUint32(static_cast<uint32_t>(format.Size()));
+    return format.ForEachEntry([&parcel](uint32_t keyId, const std::string_view &key, const FormatData &data) {
+        // the well-known key is written as its id only.
+        (void)parcel.WriteUint32(keyId);
+        if (keyId == 0) {
+            (void)parcel.WriteString(std::string(key));
+        }
+        (void)parcel.WriteUint32(data.type);
+        switch (data.type) {
             case FORMAT_TYPE_INT32:
-                (void)parcel.WriteInt32(it->second.val.int32Val);
+                (void)parcel.WriteInt32(data.val.int32Val);
                 break;
             case FORMAT_TYPE_INT64:
-                (void)parcel.WriteInt64(it->second.val.int64Val);
+                (void)parcel.WriteInt64(data.val.int64Val);
                 break;
             case FORMAT_TYPE_FLOAT:
-                (void)parcel.WriteFloat(it->second.val.floatVal);
+                (void)parcel.WriteFloat(data.val.floatVal);
                 break;
             case FORMAT_TYPE_DOUBLE:
-                (void)parcel.WriteDouble(it->second.val.doubleVal);
+                (void)parcel.WriteDouble(data.val.doubleVal);
                 break;
             case FORMAT_TYPE_STRING:
-                (void)parcel.WriteString(it->second.stringVal);
+                (void)parcel.WriteString(data.stringVal);
                 break;
             case FORMAT_TYPE_ADDR:
-                (void)parcel.WriteInt32(static_cast<int32_t>(it->second.size));
-                (void)parcel.WriteBuffer(reinterpret_cast<const void *>(it->second.addr), it->second.size);
+                (void)parcel.WriteInt32(static_cast<int32_t>(data.size));
+                (void)parcel.WriteBuffer(reinterpret_cast<const void *>(data.addr), data.size);
                 break;
             default:
-                MEDIA_LOGE("fail to Marshalling Key: %{public}s", it->first.c_str());
+                MEDIA_LOGE("fail to Marshalling Key: %{public}s", std::string(key).c_str());
                 return false;
         }
-        MEDIA_LOGD("success to Marshalling Key: %{public}s", it->first.c_str());
-    }
-    return true;
+        return true;
+    });
 }
 
 bool MediaParcel::Unmarshalling(MessageParcel &parcel, Format &format)
 {
     uint32_t size = parcel.ReadUint32();
     for (uint32_t index = 0; index < size; index++) {
-        std::string key = parcel.ReadString();
+        std::string key;
+        uint32_t keyId = parcel.ReadUint32();
+        if (keyId == 0) {
+            key = parcel.ReadString();
+        } else {
+            key = Format::GetKeyName(keyId);
+            CHECK_AND_RETURN_RET_LOG(!key.empty(), false, "invalid key id %{public}u", keyId);
+        }
         uint32_t valType = parcel.ReadUint32();
         switch (valType) {
             case FORMAT_TYPE_INT32:
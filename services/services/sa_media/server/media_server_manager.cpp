@@ -22,6 +22,8 @@
 #include "avmuxer_service_stub.h"
 #include "media_log.h"
 #include "media_errors.h"
+#include "time_perf.h"
+#include "media_trace_recorder.h"
 
 namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "MediaServerManager"};
@@ -91,9 +93,35 @@ int32_t MediaServerManager::Dump(int32_t fd, const std::vector<std::u16string> &
         return OHOS::INVALID_OPERATION;
     }
 
+    if (argSets.find(u"perf") != argSets.end()) {
+        dumpString += "------------------TimePerf------------------\n";
+        TimePerf::Inst().DumpInfo(dumpString);
+        write(fd, dumpString.c_str(), dumpString.size());
+        dumpString.clear();
+    }
+
+    DumpTraceRecorder(fd, argSets);
+
     return OHOS::NO_ERROR;
 }
 
+void MediaServerManager::DumpTraceRecorder(int32_t fd, const std::unordered_set<std::u16string> &argSets)
+{
+    auto &recorder = MediaTraceRecorder::Inst();
+    if (argSets.find(u"trace_start") != argSets.end()) {
+        recorder.Clear();
+        recorder.SetEnabled(true);
+    }
+    if (argSets.find(u"trace_stop") != argSets.end()) {
+        recorder.SetEnabled(false);
+    }
+    if (argSets.find(u"trace") != argSets.end()) {
+        std::string dumpString = "------------------MediaTrace------------------\n";
+        write(fd, dumpString.c_str(), dumpString.size());
+        recorder.ExportChromeTrace(fd);
+    }
+}
+
 MediaServerManager::MediaServerManager()
 {
     MEDIA_LOGD("0x%{public}06" PRIXPTR " Instances create", FAKE_POINTER(this));
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <functional>
+#include <unordered_set>
 #include "iremote_object.h"
 #include "ipc_skeleton.h"
 #include "recorder_service_stub.h"
@@ -62,6 +63,7 @@ private:
     sptr<IRemoteObject> CreateAVCodecListStubObject();
     sptr<IRemoteObject> CreateAVCodecStubObject();
     sptr<IRemoteObject> CreateAVMuxerStubObject();
+    void DumpTraceRecorder(int32_t fd, const std::unordered_set<std::u16string> &argSets);
     std::map<sptr<IRemoteObject>, pid_t> recorderStubMap_;
     std::map<sptr<IRemoteObject>, pid_t> playerStubMap_;
     std::map<sptr<IRemoteObject>, pid_t> avMetadataHelperStubMap_;
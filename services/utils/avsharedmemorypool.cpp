@@ -17,14 +17,125 @@
 #include "avsharedmemorybase.h"
 #include "media_log.h"
 #include "media_errors.h"
+#include "scope_guard.h"
 
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "AVShMemPool"};
     constexpr int32_t MAX_MEM_SIZE = 100 * 1024 * 1024;
+    constexpr uint32_t MAX_LOCK_FREE_MEM_CNT = 1024;
+    constexpr uint32_t BITS_PER_WORD = 32;
+
+    uint32_t GetSizeClass(int32_t size)
+    {
+        if (size <= 1) {
+            return 0;
+        }
+        return BITS_PER_WORD - 1 - static_cast<uint32_t>(__builtin_clz(static_cast<uint32_t>(size)));
+    }
 }
 
 namespace OHOS {
 namespace Media {
+/**
+ * Bounded multi-producer multi-consumer lock-free queue for the idle memory blocks of the fixed size pool.
+ * The capacity is not less than the maxMemCnt, so the push will never fail. The memory blocks left in the
+ * queue are freed when the queue is destroyed, which happens after the pool is reseted and all the busy
+ * memory blocks acquired from this queue are released.
+ */
+class AVSharedMemoryPool::IdleQueue : public NoCopyable {
+public:
+    IdleQueue(uint32_t maxMemCnt, int32_t memSize, const MemoryAvailableNotifier &notifier)
+        : memSize_(memSize), notifier_(notifier)
+    {
+        size_t capacity = 1;
+        while (capacity < maxMemCnt) {
+            capacity <<= 1;
+        }
+        cells_ = std::make_unique<Cell[]>(capacity);
+        for (size_t i = 0; i < capacity; ++i) {
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+        }
+        mask_ = capacity - 1;
+    }
+
+    ~IdleQueue()
+    {
+        AVSharedMemory *memory = nullptr;
+        while ((memory = Pop()) != nullptr) {
+            delete memory;
+        }
+    }
+
+    bool Push(AVSharedMemory *memory)
+    {
+        Cell *cell = nullptr;
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->memory = memory;
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    AVSharedMemory *Pop()
+    {
+        Cell *cell = nullptr;
+        size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return nullptr;
+            } else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        AVSharedMemory *memory = cell->memory;
+        cell->seq.store(pos + mask_ + 1, std::memory_order_release);
+        return memory;
+    }
+
+    int32_t GetMemSize() const
+    {
+        return memSize_;
+    }
+
+    const MemoryAvailableNotifier &GetNotifier() const
+    {
+        return notifier_;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> seq = 0;
+        AVSharedMemory *memory = nullptr;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> enqueuePos_ = 0;
+    alignas(64) std::atomic<size_t> dequeuePos_ = 0;
+    const int32_t memSize_;
+    const MemoryAvailableNotifier notifier_;
+};
+
 AVSharedMemoryPool::AVSharedMemoryPool(const std::string &name) : name_(name)
 {
     MEDIA_LOGD("enter ctor, 0x%{public}06" PRIXPTR ", name: %{public}s", FAKE_POINTER(this), name_.c_str());
@@ -53,6 +164,13 @@ int32_t AVSharedMemoryPool::Init(const InitializeOption &option)
                "maxMemCnt = %{public}u, enableFixedSize = %{public}d",
                name_.c_str(), option_.preAllocMemCnt, option_.memSize, option_.maxMemCnt,
                option_.enableFixedSize);
+
+    std::shared_ptr<IdleQueue> idleQueue = nullptr;
+    if (option_.enableFixedSize && option_.maxMemCnt <= MAX_LOCK_FREE_MEM_CNT) {
+        idleQueue = std::make_shared<IdleQueue>(option_.maxMemCnt, option_.memSize, option.notifier);
+        CHECK_AND_RETURN_RET_LOG(idleQueue != nullptr, MSERR_NO_MEMORY, "create idle queue failed");
+    }
+
     bool ret = true;
     for (uint32_t i = 0; i < option_.preAllocMemCnt; ++i) {
         auto memory = AllocMemory(option_.memSize);
@@ -61,19 +179,22 @@ int32_t AVSharedMemoryPool::Init(const InitializeOption &option)
             ret = false;
             break;
         }
-        idleList_.push_back(memory);
+        if (idleQueue != nullptr) {
+            (void)idleQueue->Push(memory);
+        } else {
+            PushIdleMemory(memory);
+        }
     }
-    
+
     if (!ret) {
-        for (auto iter = idleList_.begin(); iter != idleList_.end(); ++iter) {
-            delete *iter;
-            *iter = nullptr;
-        }
+        ClearIdleMemory();
         return MSERR_NO_MEMORY;
     }
 
+    totalCnt_ = option_.preAllocMemCnt;
     inited_ = true;
     notifier_ = option.notifier;
+    std::atomic_store(&idleQueue_, idleQueue);
     return MSERR_OK;
 }
 
@@ -91,68 +212,141 @@ AVSharedMemory *AVSharedMemoryPool::AllocMemory(int32_t size)
     return memory;
 }
 
-void AVSharedMemoryPool::ReleaseMemory(AVSharedMemory *memory)
+void AVSharedMemoryPool::PushIdleMemory(AVSharedMemory *memory)
 {
-    CHECK_AND_RETURN_LOG(memory != nullptr, "memory is nullptr");
-    std::unique_lock<std::mutex> lock(mutex_);
+    uint32_t sizeClass = GetSizeClass(memory->GetSize());
+    idleLists_[sizeClass].push_back(memory);
+    idleMask_ |= (1u << sizeClass);
+}
 
-    for (auto iter = busyList_.begin(); iter != busyList_.end(); ++iter) {
-        if (*iter != memory) {
+AVSharedMemory *AVSharedMemoryPool::PopIdleMemory(int32_t size)
+{
+    uint32_t sizeClass = GetSizeClass(size);
+    auto &sameClassList = idleLists_[sizeClass];
+    for (auto iter = sameClassList.begin(); iter != sameClassList.end(); ++iter) {
+        if ((*iter)->GetSize() < size) {
             continue;
         }
+        AVSharedMemory *memory = *iter;
+        *iter = sameClassList.back();
+        sameClassList.pop_back();
+        if (sameClassList.empty()) {
+            idleMask_ &= ~(1u << sizeClass);
+        }
+        return memory;
+    }
 
-        busyList_.erase(iter);
-        idleList_.push_back(memory);
-        cond_.notify_all();
-        MEDIA_LOGD("0x%{public}06" PRIXPTR " released back to pool %{public}s",
-                    FAKE_POINTER(memory), name_.c_str());
+    // all memory blocks in the larger size classes can satisfy the acquired size.
+    uint32_t largerMask = (sizeClass + 1 < SIZE_CLASS_CNT) ? (idleMask_ & ~((2u << sizeClass) - 1)) : 0;
+    if (largerMask == 0) {
+        return nullptr;
+    }
 
-        auto notifier = notifier_;
-        lock.unlock();
-        if (notifier_ != nullptr) {
-            notifier_();
+    uint32_t largerClass = static_cast<uint32_t>(__builtin_ctz(largerMask));
+    AVSharedMemory *memory = idleLists_[largerClass].back();
+    idleLists_[largerClass].pop_back();
+    if (idleLists_[largerClass].empty()) {
+        idleMask_ &= ~(1u << largerClass);
+    }
+    return memory;
+}
+
+AVSharedMemory *AVSharedMemoryPool::PopSmallestIdleMemory()
+{
+    if (idleMask_ == 0) {
+        return nullptr;
+    }
+
+    uint32_t sizeClass = static_cast<uint32_t>(__builtin_ctz(idleMask_));
+    auto &idleList = idleLists_[sizeClass];
+    auto minSizeIter = idleList.begin();
+    for (auto iter = idleList.begin(); iter != idleList.end(); ++iter) {
+        if ((*iter)->GetSize() < (*minSizeIter)->GetSize()) {
+            minSizeIter = iter;
         }
-        return;
     }
 
-    MEDIA_LOGE("0x%{public}06" PRIXPTR " is no longer managed by this pool", FAKE_POINTER(memory));
-    delete memory;
+    AVSharedMemory *memory = *minSizeIter;
+    *minSizeIter = idleList.back();
+    idleList.pop_back();
+    if (idleList.empty()) {
+        idleMask_ &= ~(1u << sizeClass);
+    }
+    return memory;
 }
 
-bool AVSharedMemoryPool::DoAcquireMemory(int32_t size, AVSharedMemory **outMemory)
+void AVSharedMemoryPool::ClearIdleMemory()
+{
+    for (auto &idleList : idleLists_) {
+        for (auto &memory : idleList) {
+            delete memory;
+            memory = nullptr;
+        }
+        idleList.clear();
+    }
+    idleMask_ = 0;
+}
+
+void AVSharedMemoryPool::ReleaseMemory(AVSharedMemory *memory, uint32_t generation)
 {
-    MEDIA_LOGD("busylist size %{public}zu, idlelist size %{public}zu", busyList_.size(), idleList_.size());
+    CHECK_AND_RETURN_LOG(memory != nullptr, "memory is nullptr");
+    std::unique_lock<std::mutex> lock(mutex_);
 
-    AVSharedMemory *result = nullptr;
-    std::list<AVSharedMemory *>::iterator minSizeIdleMem = idleList_.end();
-    int32_t minIdleSize = std::numeric_limits<int32_t>::max();
+    if (generation != generation_) {
+        MEDIA_LOGE("0x%{public}06" PRIXPTR " is no longer managed by this pool", FAKE_POINTER(memory));
+        delete memory;
+        return;
+    }
 
-    for (auto iter = idleList_.begin(); iter != idleList_.end(); ++iter) {
-        if ((*iter)->GetSize() >= size) {
-            result = *iter;
-            idleList_.erase(iter);
-            break;
-        }
+    PushIdleMemory(memory);
+    cond_.notify_all();
+    MEDIA_LOGD("0x%{public}06" PRIXPTR " released back to pool %{public}s",
+                FAKE_POINTER(memory), name_.c_str());
 
-        if ((*iter)->GetSize() < minIdleSize) {
-            minIdleSize = (*iter)->GetSize();
-            minSizeIdleMem = iter;
-        }
+    auto notifier = notifier_;
+    lock.unlock();
+    if (notifier != nullptr) {
+        notifier();
     }
+}
 
-    if (result == nullptr) {
-        auto totalCnt = busyList_.size() + idleList_.size();
-        if (totalCnt < option_.maxMemCnt) {
-            result = AllocMemory(size);
-            CHECK_AND_RETURN_RET(result != nullptr, false);
-        }
+void AVSharedMemoryPool::NotifyMemoryAvailable(const std::shared_ptr<IdleQueue> &idleQueue)
+{
+    if (std::atomic_load(&idleQueue_) != idleQueue) {
+        return;
+    }
+
+    // pairs with the fence in AcquireMemory, either the waiter sees the pushed memory or we see the waiter.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiterCnt_.load() > 0) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.notify_one();
+    }
+
+    if (idleQueue->GetNotifier() != nullptr) {
+        idleQueue->GetNotifier()();
+    }
+}
+
+bool AVSharedMemoryPool::DoAcquireMemory(int32_t size, AVSharedMemory **outMemory)
+{
+    MEDIA_LOGD("total count %{public}u, max count %{public}u", totalCnt_, option_.maxMemCnt);
 
-        if (!option_.enableFixedSize && minSizeIdleMem != idleList_.end()) {
-            delete *minSizeIdleMem;
-            *minSizeIdleMem = nullptr;
-            idleList_.erase(minSizeIdleMem);
+    AVSharedMemory *result = (idleQueue_ != nullptr) ? idleQueue_->Pop() : PopIdleMemory(size);
+    if (result == nullptr) {
+        if (totalCnt_ < option_.maxMemCnt) {
             result = AllocMemory(size);
             CHECK_AND_RETURN_RET(result != nullptr, false);
+            totalCnt_++;
+        } else if (!option_.enableFixedSize) {
+            AVSharedMemory *minSizeIdleMem = PopSmallestIdleMemory();
+            if (minSizeIdleMem != nullptr) {
+                delete minSizeIdleMem;
+                totalCnt_--;
+                result = AllocMemory(size);
+                CHECK_AND_RETURN_RET(result != nullptr, false);
+                totalCnt_++;
+            }
         }
     }
 
@@ -183,11 +377,49 @@ bool AVSharedMemoryPool::CheckSize(int32_t size)
     return true;
 }
 
+std::shared_ptr<AVSharedMemory> AVSharedMemoryPool::WrapMemory(AVSharedMemory *memory,
+    const std::shared_ptr<IdleQueue> &idleQueue)
+{
+    if (idleQueue != nullptr) {
+        return std::shared_ptr<AVSharedMemory>(memory, [weakPool = weak_from_this(), idleQueue](AVSharedMemory *mem) {
+            if (!idleQueue->Push(mem)) {
+                delete mem;
+                return;
+            }
+            std::shared_ptr<AVSharedMemoryPool> pool = weakPool.lock();
+            if (pool != nullptr) {
+                pool->NotifyMemoryAvailable(idleQueue);
+            }
+        });
+    }
+
+    return std::shared_ptr<AVSharedMemory>(memory,
+        [weakPool = weak_from_this(), generation = generation_](AVSharedMemory *mem) {
+        std::shared_ptr<AVSharedMemoryPool> pool = weakPool.lock();
+        if (pool != nullptr) {
+            pool->ReleaseMemory(mem, generation);
+        } else {
+            MEDIA_LOGI("release memory 0x%{public}06" PRIXPTR ", but the pool is destroyed", FAKE_POINTER(mem));
+            delete mem;
+        }
+    });
+}
+
 std::shared_ptr<AVSharedMemory> AVSharedMemoryPool::AcquireMemory(int32_t size, bool blocking)
 {
     MEDIA_LOGD("acquire memory for size: %{public}d from pool %{public}s, blocking: %{public}d",
                size, name_.c_str(), blocking);
 
+    // fast path for the fixed size pool, no need to take the lock if there is an idle memory.
+    std::shared_ptr<IdleQueue> idleQueue = std::atomic_load(&idleQueue_);
+    if (idleQueue != nullptr && size <= idleQueue->GetMemSize() && (size > 0 || size == -1)) {
+        AVSharedMemory *memory = idleQueue->Pop();
+        if (memory != nullptr) {
+            MEDIA_LOGD("0x%{public}06" PRIXPTR " acquired from pool", FAKE_POINTER(memory));
+            return WrapMemory(memory, idleQueue);
+        }
+    }
+
     std::unique_lock<std::mutex> lock(mutex_);
     if (!CheckSize(size)) {
         MEDIA_LOGE("invalid size: %{public}d", size);
@@ -198,6 +430,10 @@ std::shared_ptr<AVSharedMemory> AVSharedMemoryPool::AcquireMemory(int32_t size,
         size = option_.memSize;
     }
 
+    waiterCnt_.fetch_add(1);
+    ON_SCOPE_EXIT(0) { waiterCnt_.fetch_sub(1); };
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
     AVSharedMemory *memory = nullptr;
     do {
         if (!DoAcquireMemory(size, &memory) || memory != nullptr) {
@@ -216,20 +452,8 @@ std::shared_ptr<AVSharedMemory> AVSharedMemoryPool::AcquireMemory(int32_t size,
         return nullptr;
     }
 
-    busyList_.push_back(memory);
-
-    auto result = std::shared_ptr<AVSharedMemory>(memory, [weakPool = weak_from_this()](AVSharedMemory *memory) {
-        std::shared_ptr<AVSharedMemoryPool> pool = weakPool.lock();
-        if (pool != nullptr) {
-            pool->ReleaseMemory(memory);
-        } else {
-            MEDIA_LOGI("release memory 0x%{public}06" PRIXPTR ", but the pool is destroyed", FAKE_POINTER(memory));
-            delete memory;
-        }
-    });
-
     MEDIA_LOGD("0x%{public}06" PRIXPTR " acquired from pool", FAKE_POINTER(memory));
-    return result;
+    return WrapMemory(memory, idleQueue_);
 }
 
 void AVSharedMemoryPool::SetNonBlocking(bool enable)
@@ -247,16 +471,21 @@ void AVSharedMemoryPool::Reset()
     MEDIA_LOGD("Reset");
 
     std::unique_lock<std::mutex> lock(mutex_);
-    for (auto &memory : idleList_) {
-        delete memory;
-        memory = nullptr;
+    ClearIdleMemory();
+    if (idleQueue_ != nullptr) {
+        AVSharedMemory *memory = nullptr;
+        while ((memory = idleQueue_->Pop()) != nullptr) {
+            delete memory;
+        }
+        std::atomic_store(&idleQueue_, std::shared_ptr<IdleQueue>(nullptr));
     }
-    idleList_.clear();
+    generation_++;
+    totalCnt_ = 0;
     inited_ = false;
     forceNonBlocking_ = false;
     notifier_ = nullptr;
     cond_.notify_all();
-    // for busylist, the memory will be released when the refcount of shared_ptr is zero.
+    // for busy memory, it will be released when the refcount of shared_ptr is zero.
 }
 } // namespace Media
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
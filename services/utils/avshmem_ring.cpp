@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "avshmem_ring.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <fcntl.h>
+#include <new>
+#include <string>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include "avsharedmemorybase.h"
+#include "media_errors.h"
+#include "media_log.h"
+
+namespace {
+    constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "AVShMemRing"};
+    constexpr uint32_t RING_MAGIC = 0x52494E47; // "RING"
+    constexpr uint32_t MAX_RING_CAPACITY = 4096;
+    constexpr size_t CACHE_LINE_SIZE = 64;
+    constexpr char EVENTFD_LINK[] = "anon_inode:[eventfd]";
+
+    bool IsEventFd(int32_t fd)
+    {
+        std::string path = "/proc/self/fd/" + std::to_string(fd);
+        char link[sizeof(EVENTFD_LINK)] = {0};
+        ssize_t len = readlink(path.c_str(), link, sizeof(link));
+        return len == static_cast<ssize_t>(sizeof(EVENTFD_LINK) - 1) &&
+            std::string(link, static_cast<size_t>(len)) == EVENTFD_LINK;
+    }
+}
+
+namespace OHOS {
+namespace Media {
+// head is only written by the producer and tail is only written by the consumer, keep them at
+// different cache lines.
+struct AVShMemRing::RingHeader {
+    uint32_t magic;
+    uint32_t capacity;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> head;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> tail;
+    std::atomic<uint32_t> waiting;
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "the atomic in shared memory must be lock free");
+
+size_t AVShMemRing::GetMemSize(uint32_t capacity)
+{
+    return sizeof(AVShMemRing::RingHeader) + static_cast<size_t>(capacity) * sizeof(AVShMemRingItem);
+}
+
+std::shared_ptr<AVShMemRing> AVShMemRing::Create(uint32_t capacity, const std::string &name)
+{
+    CHECK_AND_RETURN_RET_LOG(capacity > 0 && capacity <= MAX_RING_CAPACITY, nullptr,
+        "invalid capacity %{public}u", capacity);
+    uint32_t realCapacity = 1;
+    while (realCapacity < capacity) {
+        realCapacity <<= 1;
+    }
+
+    auto memory = AVSharedMemoryBase::CreateFromLocal(static_cast<int32_t>(GetMemSize(realCapacity)),
+        AVSharedMemory::FLAGS_READ_WRITE, name);
+    CHECK_AND_RETURN_RET_LOG(memory != nullptr && memory->GetBase() != nullptr, nullptr, "create memory failed");
+
+    int32_t eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    CHECK_AND_RETURN_RET_LOG(eventFd >= 0, nullptr, "create eventfd failed, errno: %{public}d", errno);
+
+    RingHeader *header = new (memory->GetBase()) RingHeader();
+    header->magic = RING_MAGIC;
+    header->capacity = realCapacity;
+    header->head.store(0);
+    header->tail.store(0);
+    header->waiting.store(0);
+
+    std::shared_ptr<AVShMemRing> ring(new (std::nothrow) AVShMemRing(memory, eventFd, realCapacity));
+    if (ring == nullptr) {
+        (void)close(eventFd);
+        MEDIA_LOGE("new ring failed");
+    }
+    return ring;
+}
+
+std::shared_ptr<AVShMemRing> AVShMemRing::Attach(const std::shared_ptr<AVSharedMemory> &memory, int32_t eventFd)
+{
+    if (memory == nullptr || memory->GetBase() == nullptr || eventFd < 0 ||
+        static_cast<size_t>(memory->GetSize()) < sizeof(RingHeader)) {
+        MEDIA_LOGE("invalid ring memory or eventfd");
+        if (eventFd >= 0) {
+            (void)close(eventFd);
+        }
+        return nullptr;
+    }
+
+    // the header is written by the remote, check it before trust the capacity.
+    RingHeader *header = reinterpret_cast<RingHeader *>(memory->GetBase());
+    uint32_t capacity = header->capacity;
+    bool valid = header->magic == RING_MAGIC && capacity > 0 && capacity <= MAX_RING_CAPACITY &&
+        (capacity & (capacity - 1)) == 0 && static_cast<size_t>(memory->GetSize()) >= GetMemSize(capacity);
+    if (!valid) {
+        MEDIA_LOGE("invalid ring header");
+        (void)close(eventFd);
+        return nullptr;
+    }
+
+    // the fd is passed by the remote too, a pipe or socket here would block the consumer in read.
+    // O_NONBLOCK lives in the file description shared with the remote, so set it again.
+    int32_t flags = fcntl(eventFd, F_GETFL);
+    if (!IsEventFd(eventFd) || flags < 0 || fcntl(eventFd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        MEDIA_LOGE("invalid eventfd, errno: %{public}d", errno);
+        (void)close(eventFd);
+        return nullptr;
+    }
+
+    std::shared_ptr<AVShMemRing> ring(new (std::nothrow) AVShMemRing(memory, eventFd, capacity));
+    if (ring == nullptr) {
+        (void)close(eventFd);
+        MEDIA_LOGE("new ring failed");
+    }
+    return ring;
+}
+
+AVShMemRing::AVShMemRing(const std::shared_ptr<AVSharedMemory> &memory, int32_t eventFd, uint32_t capacity)
+    : memory_(memory), eventFd_(eventFd), capacity_(capacity)
+{
+    header_ = reinterpret_cast<RingHeader *>(memory_->GetBase());
+    items_ = reinterpret_cast<AVShMemRingItem *>(memory_->GetBase() + sizeof(RingHeader));
+    MEDIA_LOGD("enter ctor, instance: 0x%{public}06" PRIXPTR ", capacity = %{public}u", FAKE_POINTER(this), capacity);
+}
+
+AVShMemRing::~AVShMemRing()
+{
+    MEDIA_LOGD("enter dtor, instance: 0x%{public}06" PRIXPTR "", FAKE_POINTER(this));
+    if (eventFd_ >= 0) {
+        (void)close(eventFd_);
+        eventFd_ = -1;
+    }
+}
+
+bool AVShMemRing::IsEmpty() const
+{
+    return header_->head.load() == header_->tail.load();
+}
+
+bool AVShMemRing::Push(const AVShMemRingItem &item)
+{
+    uint32_t head = header_->head.load(std::memory_order_relaxed);
+    uint32_t tail = header_->tail.load(std::memory_order_acquire);
+    if (head - tail >= capacity_) {
+        return false;
+    }
+
+    items_[head & (capacity_ - 1)] = item;
+    // the sequential consistent store pairs with the waiting flag at the consumer side, so the
+    // consumer either sees the item or is notified.
+    header_->head.store(head + 1);
+    if (header_->waiting.load() != 0) {
+        uint64_t value = 1;
+        (void)write(eventFd_, &value, sizeof(value));
+    }
+    return true;
+}
+
+size_t AVShMemRing::Pop(std::vector<AVShMemRingItem> &items, size_t maxCount)
+{
+    uint32_t tail = header_->tail.load(std::memory_order_relaxed);
+    uint32_t head = header_->head.load(std::memory_order_acquire);
+    uint32_t available = head - tail;
+    if (available > capacity_) {
+        MEDIA_LOGE("ring corrupted, head: %{public}u, tail: %{public}u", head, tail);
+        return 0;
+    }
+
+    size_t count = std::min(static_cast<size_t>(available), maxCount);
+    for (size_t i = 0; i < count; ++i) {
+        items.push_back(items_[(tail + i) & (capacity_ - 1)]);
+    }
+    header_->tail.store(tail + static_cast<uint32_t>(count), std::memory_order_release);
+    return count;
+}
+
+int32_t AVShMemRing::Wait(int32_t timeoutMs)
+{
+    if (!IsEmpty()) {
+        return MSERR_OK;
+    }
+
+    header_->waiting.store(1);
+    if (IsEmpty()) {
+        struct pollfd pfd = { eventFd_, POLLIN, 0 };
+        (void)poll(&pfd, 1, timeoutMs);
+        uint64_t value = 0;
+        (void)read(eventFd_, &value, sizeof(value));
+    }
+    header_->waiting.store(0);
+
+    return IsEmpty() ? MSERR_UNKNOWN : MSERR_OK;
+}
+
+void AVShMemRing::Wakeup()
+{
+    uint64_t value = 1;
+    (void)write(eventFd_, &value, sizeof(value));
+}
+} // namespace Media
+} // namespace OHOS
@@ -14,75 +14,138 @@
  */
 
 #include "format.h"
+#include <algorithm>
+#include <mutex>
 #include "securec.h"
+#include "media_description.h"
 #include "media_log.h"
 #include "media_errors.h"
 
 namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "Format"};
+using MediaDescriptionKey = OHOS::Media::MediaDescriptionKey;
+// the id of the key is its index + 1, only append the new key to the end.
+constexpr std::string_view WELL_KNOWN_KEYS[] = {
+    MediaDescriptionKey::MD_KEY_TRACK_INDEX,
+    MediaDescriptionKey::MD_KEY_TRACK_TYPE,
+    MediaDescriptionKey::MD_KEY_CODEC_MIME,
+    MediaDescriptionKey::MD_KEY_DURATION,
+    MediaDescriptionKey::MD_KEY_BITRATE,
+    MediaDescriptionKey::MD_KEY_MAX_INPUT_SIZE,
+    MediaDescriptionKey::MD_KEY_WIDTH,
+    MediaDescriptionKey::MD_KEY_HEIGHT,
+    MediaDescriptionKey::MD_KEY_PIXEL_FORMAT,
+    MediaDescriptionKey::MD_KEY_FRAME_RATE,
+    MediaDescriptionKey::MD_KEY_CAPTURE_RATE,
+    MediaDescriptionKey::MD_KEY_I_FRAME_INTERVAL,
+    MediaDescriptionKey::MD_KEY_REQUEST_I_FRAME,
+    MediaDescriptionKey::MD_KEY_CHANNEL_COUNT,
+    MediaDescriptionKey::MD_KEY_SAMPLE_RATE,
+    MediaDescriptionKey::MD_KEY_TRACK_COUNT,
+    MediaDescriptionKey::MD_KEY_CONTAINER_FORMAT,
+};
+constexpr uint32_t WELL_KNOWN_KEY_NUM = sizeof(WELL_KNOWN_KEYS) / sizeof(WELL_KNOWN_KEYS[0]);
 }
 
 namespace OHOS {
 namespace Media {
-void CopyFormatDataMap(const Format::FormatDataMap &from, Format::FormatDataMap &to)
+namespace {
+struct FormatEntry {
+    uint32_t keyId = 0;
+    std::string customKey; // only used if the key is not interned
+    FormatData data;
+
+    std::string_view Key() const
+    {
+        return keyId != 0 ? WELL_KNOWN_KEYS[keyId - 1] : std::string_view(customKey);
+    }
+};
+}
+
+static uint8_t *CopyAddr(const uint8_t *addr, size_t size)
 {
-    for (auto it = to.begin(); it != to.end(); ++it) {
-        if (it->second.type == FORMAT_TYPE_ADDR && it->second.addr != nullptr) {
-            free(it->second.addr);
-            it->second.addr = nullptr;
-        }
+    uint8_t *copy = reinterpret_cast<uint8_t *>(malloc(size));
+    CHECK_AND_RETURN_RET_LOG(copy != nullptr, nullptr, "malloc addr failed");
+
+    errno_t err = memcpy_s(reinterpret_cast<void *>(copy), size, reinterpret_cast<const void *>(addr), size);
+    if (err != EOK) {
+        MEDIA_LOGE("memcpy addr failed");
+        free(copy);
+        return nullptr;
     }
+    return copy;
+}
 
-    to = from;
+// the entries are kept sorted by the key, the addr of the entries is owned by the storage.
+struct Format::FormatStorage {
+    FormatStorage() = default;
+    ~FormatStorage()
+    {
+        for (auto &entry : entries) {
+            if (entry.data.type == FORMAT_TYPE_ADDR && entry.data.addr != nullptr) {
+                free(entry.data.addr);
+                entry.data.addr = nullptr;
+            }
+        }
+    }
 
-    for (auto it = to.begin(); it != to.end();) {
-        if (it->second.type != FORMAT_TYPE_ADDR || it->second.addr == nullptr) {
+    FormatStorage(const FormatStorage &rhs) : entries(rhs.entries)
+    {
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (it->data.type != FORMAT_TYPE_ADDR || it->data.addr == nullptr) {
+                ++it;
+                continue;
+            }
+            it->data.addr = CopyAddr(it->data.addr, it->data.size);
+            if (it->data.addr == nullptr) {
+                MEDIA_LOGE("copy addr failed. Key: %{public}s", std::string(it->Key()).c_str());
+                it = entries.erase(it);
+                continue;
+            }
             ++it;
-            continue;
         }
+    }
 
-        it->second.addr = reinterpret_cast<uint8_t *>(malloc(it->second.size));
-        if (it->second.addr == nullptr) {
-            MEDIA_LOGE("malloc addr failed. Key: %{public}s", it->first.c_str());
-            it = to.erase(it);
-            continue;
-        }
+    FormatStorage &operator=(const FormatStorage &) = delete;
 
-        errno_t err = memcpy_s(reinterpret_cast<void *>(it->second.addr),
-            it->second.size, reinterpret_cast<const void *>(from.at(it->first).addr), it->second.size);
-        if (err != EOK) {
-            MEDIA_LOGE("memcpy addr failed. Key: %{public}s", it->first.c_str());
-            free(it->second.addr);
-            it->second.addr = nullptr;
-            it = to.erase(it);
-            continue;
-        }
-        ++it;
+    std::vector<FormatEntry>::iterator LowerBound(const std::string_view &key)
+    {
+        return std::lower_bound(entries.begin(), entries.end(), key,
+            [](const FormatEntry &entry, const std::string_view &target) { return entry.Key() < target; });
     }
-}
 
-Format::~Format()
+    std::vector<FormatEntry> entries;
+    std::mutex mapMutex;
+    std::unique_ptr<FormatDataMap> mapCache;
+};
+
+uint32_t Format::GetKeyId(const std::string_view &key)
 {
-    for (auto it = formatMap_.begin(); it != formatMap_.end(); ++it) {
-        if (it->second.type == FORMAT_TYPE_ADDR && it->second.addr != nullptr) {
-            free(it->second.addr);
-            it->second.addr = nullptr;
+    for (uint32_t index = 0; index < WELL_KNOWN_KEY_NUM; index++) {
+        if (WELL_KNOWN_KEYS[index] == key) {
+            return index + 1;
         }
     }
+    return 0;
 }
 
-Format::Format(const Format &rhs)
+std::string_view Format::GetKeyName(uint32_t keyId)
 {
-    if (&rhs == this) {
-        return;
+    if (keyId == 0 || keyId > WELL_KNOWN_KEY_NUM) {
+        return std::string_view();
     }
+    return WELL_KNOWN_KEYS[keyId - 1];
+}
 
-    CopyFormatDataMap(rhs.formatMap_, formatMap_);
+Format::~Format() = default;
+
+Format::Format(const Format &rhs) : storage_(rhs.storage_)
+{
 }
 
 Format::Format(Format &&rhs) noexcept
 {
-    std::swap(formatMap_, rhs.formatMap_);
+    std::swap(storage_, rhs.storage_);
 }
 
 Format &Format::operator=(const Format &rhs)
@@ -91,7 +154,7 @@ Format &Format::operator=(const Format &rhs)
         return *this;
     }
 
-    CopyFormatDataMap(rhs.formatMap_, this->formatMap_);
+    storage_ = rhs.storage_;
     return *this;
 }
 
@@ -101,17 +164,83 @@ Format &Format::operator=(Format &&rhs) noexcept
         return *this;
     }
 
-    std::swap(this->formatMap_, rhs.formatMap_);
+    std::swap(this->storage_, rhs.storage_);
     return *this;
 }
 
+Format::FormatStorage &Format::MutableStorage()
+{
+    if (storage_ == nullptr) {
+        storage_ = std::make_shared<FormatStorage>();
+    } else if (storage_.use_count() > 1) {
+        storage_ = std::make_shared<FormatStorage>(*storage_);
+    } else {
+        std::lock_guard<std::mutex> lock(storage_->mapMutex);
+        storage_->mapCache = nullptr;
+    }
+    return *storage_;
+}
+
+const FormatData *Format::FindData(const std::string_view &key) const
+{
+    if (storage_ == nullptr) {
+        return nullptr;
+    }
+
+    auto iter = storage_->LowerBound(key);
+    if (iter == storage_->entries.end() || iter->Key() != key) {
+        return nullptr;
+    }
+    return &iter->data;
+}
+
+bool Format::InsertData(const std::string_view &key, FormatData &data)
+{
+    if (FindData(key) != nullptr) {
+        return false;
+    }
+
+    FormatStorage &storage = MutableStorage();
+    FormatEntry entry;
+    entry.keyId = GetKeyId(key);
+    if (entry.keyId == 0) {
+        entry.customKey = key;
+    }
+    entry.data = std::move(data);
+    (void)storage.entries.insert(storage.LowerBound(key), std::move(entry));
+    return true;
+}
+
+size_t Format::Size() const
+{
+    return storage_ == nullptr ? 0 : storage_->entries.size();
+}
+
+bool Format::Empty() const
+{
+    return Size() == 0;
+}
+
+bool Format::ForEachEntry(const EntryVisitor &visitor) const
+{
+    if (storage_ == nullptr) {
+        return true;
+    }
+
+    for (const auto &entry : storage_->entries) {
+        if (!visitor(entry.keyId, entry.Key(), entry.data)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool Format::PutIntValue(const std::string_view &key, int32_t value)
 {
     FormatData data;
     data.type = FORMAT_TYPE_INT32;
     data.val.int32Val = value;
-    auto ret = formatMap_.insert(std::make_pair(key, data));
-    return ret.second;
+    return InsertData(key, data);
 }
 
 bool Format::PutLongValue(const std::string_view &key, int64_t value)
@@ -119,8 +248,7 @@ bool Format::PutLongValue(const std::string_view &key, int64_t value)
     FormatData data;
     data.type = FORMAT_TYPE_INT64;
     data.val.int64Val = value;
-    auto ret = formatMap_.insert(std::make_pair(key, data));
-    return ret.second;
+    return InsertData(key, data);
 }
 
 bool Format::PutFloatValue(const std::string_view &key, float value)
@@ -128,8 +256,7 @@ bool Format::PutFloatValue(const std::string_view &key, float value)
     FormatData data;
     data.type = FORMAT_TYPE_FLOAT;
     data.val.floatVal = value;
-    auto ret = formatMap_.insert(std::make_pair(key, data));
-    return ret.second;
+    return InsertData(key, data);
 }
 
 bool Format::PutDoubleValue(const std::string_view &key, double value)
@@ -137,8 +264,7 @@ bool Format::PutDoubleValue(const std::string_view &key, double value)
     FormatData data;
     data.type = FORMAT_TYPE_DOUBLE;
     data.val.doubleVal = value;
-    auto ret = formatMap_.insert(std::make_pair(key, data));
-    return ret.second;
+    return InsertData(key, data);
 }
 
 bool Format::PutStringValue(const std::string_view &key, const std::string_view &value)
@@ -146,62 +272,61 @@ bool Format::PutStringValue(const std::string_view &key, const std::string_view
     FormatData data;
     data.type = FORMAT_TYPE_STRING;
     data.stringVal = value;
-    auto ret = formatMap_.insert(std::make_pair(key, data));
-    return ret.second;
+    return InsertData(key, data);
 }
 
 bool Format::GetStringValue(const std::string_view &key, std::string &value) const
 {
-    auto iter = formatMap_.find(key);
-    if (iter == formatMap_.end() || iter->second.type != FORMAT_TYPE_STRING) {
+    const FormatData *data = FindData(key);
+    if (data == nullptr || data->type != FORMAT_TYPE_STRING) {
         MEDIA_LOGE("Format::GetFormat failed. Key: %{public}s", key.data());
         return false;
     }
-    value = iter->second.stringVal;
+    value = data->stringVal;
     return true;
 }
 
 bool Format::GetIntValue(const std::string_view &key, int32_t &value) const
 {
-    auto iter = formatMap_.find(key);
-    if (iter == formatMap_.end() || iter->second.type != FORMAT_TYPE_INT32) {
+    const FormatData *data = FindData(key);
+    if (data == nullptr || data->type != FORMAT_TYPE_INT32) {
         MEDIA_LOGE("Format::GetFormat failed. Key: %{public}s", key.data());
         return false;
     }
-    value = iter->second.val.int32Val;
+    value = data->val.int32Val;
     return true;
 }
 
 bool Format::GetLongValue(const std::string_view &key, int64_t &value) const
 {
-    auto iter = formatMap_.find(key);
-    if (iter == formatMap_.end() || iter->second.type != FORMAT_TYPE_INT64) {
+    const FormatData *data = FindData(key);
+    if (data == nullptr || data->type != FORMAT_TYPE_INT64) {
         MEDIA_LOGE("Format::GetFormat failed. Key: %{public}s", key.data());
         return false;
     }
-    value = iter->second.val.int64Val;
+    value = data->val.int64Val;
     return true;
 }
 
 bool Format::GetFloatValue(const std::string_view &key, float &value) const
 {
-    auto iter = formatMap_.find(key);
-    if (iter == formatMap_.end() || iter->second.type != FORMAT_TYPE_FLOAT) {
+    const FormatData *data = FindData(key);
+    if (data == nullptr || data->type != FORMAT_TYPE_FLOAT) {
         MEDIA_LOGE("Format::GetFormat failed. Key: %{public}s", key.data());
         return false;
     }
-    value = iter->second.val.floatVal;
+    value = data->val.floatVal;
     return true;
 }
 
 bool Format::GetDoubleValue(const std::string_view &key, double &value) const
 {
-    auto iter = formatMap_.find(key);
-    if (iter == formatMap_.end() || iter->second.type != FORMAT_TYPE_DOUBLE) {
+    const FormatData *data = FindData(key);
+    if (data == nullptr || data->type != FORMAT_TYPE_DOUBLE) {
         MEDIA_LOGE("Format::GetFormat failed. Key: %{public}s", key.data());
         return false;
     }
-    value = iter->second.val.doubleVal;
+    value = data->val.doubleVal;
     return true;
 }
 
@@ -220,102 +345,112 @@ bool Format::PutBuffer(const std::string_view &key, const uint8_t *addr, size_t
 
     FormatData data;
     data.type = FORMAT_TYPE_ADDR;
-    data.addr = reinterpret_cast<uint8_t *>(malloc(size));
+    data.addr = CopyAddr(addr, size);
     if (data.addr == nullptr) {
-        MEDIA_LOGE("malloc addr failed. Key: %{public}s", key.data());
-        return false;
-    }
-
-    errno_t err = memcpy_s(reinterpret_cast<void *>(data.addr), size, reinterpret_cast<const void *>(addr), size);
-    if (err != EOK) {
-        MEDIA_LOGE("PutBuffer memcpy addr failed. Key: %{public}s", key.data());
-        free(data.addr);
+        MEDIA_LOGE("PutBuffer copy addr failed. Key: %{public}s", key.data());
         return false;
     }
 
     RemoveKey(key);
 
     data.size = size;
-    auto ret = formatMap_.insert(std::make_pair(key, data));
-    return ret.second;
+    if (!InsertData(key, data)) {
+        free(data.addr);
+        return false;
+    }
+    return true;
 }
 
 bool Format::GetBuffer(const std::string_view &key, uint8_t **addr, size_t &size) const
 {
-    auto iter = formatMap_.find(key);
-    if (iter == formatMap_.end() || iter->second.type != FORMAT_TYPE_ADDR) {
+    const FormatData *data = FindData(key);
+    if (data == nullptr || data->type != FORMAT_TYPE_ADDR) {
         MEDIA_LOGE("Format::GetBuffer failed. Key: %{public}s", key.data());
         return false;
     }
-    *addr = iter->second.addr;
-    size = iter->second.size;
+    *addr = data->addr;
+    size = data->size;
     return true;
 }
 
 bool Format::ContainKey(const std::string_view &key) const
 {
-    auto iter = formatMap_.find(key);
-    if (iter != formatMap_.end()) {
-        return true;
-    }
-
-    return false;
+    return FindData(key) != nullptr;
 }
 
 FormatDataType Format::GetValueType(const std::string_view &key) const
 {
-    auto iter = formatMap_.find(key);
-    if (iter == formatMap_.end()) {
+    const FormatData *data = FindData(key);
+    if (data == nullptr) {
         return FORMAT_TYPE_NONE;
     }
 
-    return iter->second.type;
+    return data->type;
 }
 
 void Format::RemoveKey(const std::string_view &key)
 {
-    auto iter = formatMap_.find(key);
-    if (iter != formatMap_.end()) {
-        if (iter->second.type == FORMAT_TYPE_ADDR && iter->second.addr != nullptr) {
-            free(iter->second.addr);
-            iter->second.addr = nullptr;
-        }
-        formatMap_.erase(iter);
+    if (FindData(key) == nullptr) {
+        return;
+    }
+
+    FormatStorage &storage = MutableStorage();
+    auto iter = storage.LowerBound(key);
+    CHECK_AND_RETURN(iter != storage.entries.end() && iter->Key() == key);
+    if (iter->data.type == FORMAT_TYPE_ADDR && iter->data.addr != nullptr) {
+        free(iter->data.addr);
+        iter->data.addr = nullptr;
     }
+    (void)storage.entries.erase(iter);
 }
 
 const Format::FormatDataMap &Format::GetFormatMap() const
 {
-    return formatMap_;
+    static const FormatDataMap emptyMap;
+    if (storage_ == nullptr) {
+        return emptyMap;
+    }
+
+    // the addr in the map refers to the storage, it is not owned by the map.
+    std::lock_guard<std::mutex> lock(storage_->mapMutex);
+    if (storage_->mapCache == nullptr) {
+        storage_->mapCache = std::make_unique<FormatDataMap>();
+        for (const auto &entry : storage_->entries) {
+            (void)storage_->mapCache->emplace(entry.Key(), entry.data);
+        }
+    }
+    return *storage_->mapCache;
 }
 
 std::string Format::Stringify() const
 {
     std::string outString;
-    for (auto iter = formatMap_.begin(); iter != formatMap_.end(); iter++) {
-        switch (GetValueType(iter->first)) {
+    (void)ForEachEntry([&outString](uint32_t keyId, const std::string_view &key, const FormatData &data) {
+        (void)keyId;
+        switch (data.type) {
             case FORMAT_TYPE_INT32:
-                outString += iter->first + " = " + std::to_string(iter->second.val.int32Val) + "\n";
+                outString.append(key).append(" = ").append(std::to_string(data.val.int32Val)).append("\n");
                 break;
             case FORMAT_TYPE_INT64:
-                outString += iter->first + " = " + std::to_string(iter->second.val.int64Val) + "\n";
+                outString.append(key).append(" = ").append(std::to_string(data.val.int64Val)).append("\n");
                 break;
             case FORMAT_TYPE_FLOAT:
-                outString += iter->first + " = " + std::to_string(iter->second.val.floatVal) + "\n";
+                outString.append(key).append(" = ").append(std::to_string(data.val.floatVal)).append("\n");
                 break;
             case FORMAT_TYPE_DOUBLE:
-                outString += iter->first + " = " + std::to_string(iter->second.val.doubleVal) + "\n";
+                outString.append(key).append(" = ").append(std::to_string(data.val.doubleVal)).append("\n");
                 break;
             case FORMAT_TYPE_STRING:
-                outString += iter->first + " = " + iter->second.stringVal + "\n";
+                outString.append(key).append(" = ").append(data.stringVal).append("\n");
                 break;
             case FORMAT_TYPE_ADDR:
                 break;
             default:
-                MEDIA_LOGE("Format::Stringify failed. Key: %{public}s", iter->first.c_str());
+                MEDIA_LOGE("Format::Stringify failed. Key: %{public}s", std::string(key).c_str());
         }
-    }
+        return true;
+    });
     return outString;
 }
 } // namespace Media
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
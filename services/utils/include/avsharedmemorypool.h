@@ -16,11 +16,13 @@
 #ifndef AVSHAREDMEMORYPOOL_H
 #define AVSHAREDMEMORYPOOL_H
 
+#include <array>
+#include <atomic>
 #include <condition_variable>
 #include <functional>
-#include <list>
 #include <memory>
 #include <mutex>
+#include <vector>
 #include "nocopyable.h"
 #include "avsharedmemorybase.h"
 
@@ -40,6 +42,11 @@ namespace Media {
  *                  satisfy the acqiured size and reallocate a new memory block with the acquired size.
  * @notifier: the callback will be called to notify there are any available memory. It will be useful for
  *            non-blocking memory acquisition.
+ *
+ * The idle memory blocks are bucketed by size class, and a released memory block goes back to the pool
+ * without searching for it, so both acquire and release are O(1). If the enableFixedSize is configured,
+ * the idle memory blocks are kept in a lock-free queue instead, and the acquire and release will not take
+ * the pool lock unless a new memory block needs to be allocated or there are waiters to wake up.
  */
 class __attribute__((visibility("default"))) AVSharedMemoryPool
     : public std::enable_shared_from_this<AVSharedMemoryPool>, public NoCopyable {
@@ -90,14 +97,29 @@ public:
     }
 
 private:
+    class IdleQueue;
+    static constexpr uint32_t SIZE_CLASS_CNT = 32;
+
     bool DoAcquireMemory(int32_t size, AVSharedMemory **outMemory);
     AVSharedMemory *AllocMemory(int32_t size);
-    void ReleaseMemory(AVSharedMemory *memory);
+    void ReleaseMemory(AVSharedMemory *memory, uint32_t generation);
+    void NotifyMemoryAvailable(const std::shared_ptr<IdleQueue> &idleQueue);
+    std::shared_ptr<AVSharedMemory> WrapMemory(AVSharedMemory *memory, const std::shared_ptr<IdleQueue> &idleQueue);
     bool CheckSize(int32_t size);
+    void PushIdleMemory(AVSharedMemory *memory);
+    AVSharedMemory *PopIdleMemory(int32_t size);
+    AVSharedMemory *PopSmallestIdleMemory();
+    void ClearIdleMemory();
 
     InitializeOption option_ {};
-    std::list<AVSharedMemory *> idleList_;
-    std::list<AVSharedMemory *> busyList_;
+    // the idle memory blocks whose size is in [2^n, 2^(n+1)) are kept in idleLists_[n]
+    std::array<std::vector<AVSharedMemory *>, SIZE_CLASS_CNT> idleLists_;
+    uint32_t idleMask_ = 0;
+    // only valid if the enableFixedSize is configured, replaces the idleLists_
+    std::shared_ptr<IdleQueue> idleQueue_;
+    uint32_t totalCnt_ = 0;
+    uint32_t generation_ = 0;
+    std::atomic<uint32_t> waiterCnt_ = 0;
     std::mutex mutex_;
     std::condition_variable cond_;
     bool inited_ = false;
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AVSHMEM_RING_H
+#define AVSHMEM_RING_H
+
+#include <string>
+#include <vector>
+#include "nocopyable.h"
+#include "avsharedmemory.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * @brief The fixed size item carried by the AVShMemRing.
+ */
+struct AVShMemRingItem {
+    uint32_t type = 0;
+    uint32_t index = 0;
+    int64_t pts = 0;
+    int32_t size = 0;
+    int32_t offset = 0;
+    uint32_t flag = 0;
+    uint32_t reserved = 0;
+};
+
+/**
+ * @brief Single producer single consumer ring buffer placed in the shared memory, which can be
+ * used across processes. The consumer is waked up through an eventfd only when it is waiting,
+ * so the producer does not need a syscall for each item when the consumer is busy.
+ */
+class __attribute__((visibility("default"))) AVShMemRing : public NoCopyable {
+public:
+    /**
+     * @brief Create a new ring in the local process.
+     *
+     * @param capacity the max item count, rounded up to the power of 2.
+     * @param name the debug string
+     * @return the ring if success, otherwise nullptr.
+     */
+    static std::shared_ptr<AVShMemRing> Create(uint32_t capacity, const std::string &name);
+
+    /**
+     * @brief Attach to the ring created by the remote process. The ownership of the eventFd is
+     * transferred to the ring. Anything other than an eventfd is rejected.
+     *
+     * @param memory the shared memory of the ring, refer to {@GetMemory}
+     * @param eventFd the eventfd of the ring, refer to {@GetEventFd}
+     * @return the ring if success, otherwise nullptr.
+     */
+    static std::shared_ptr<AVShMemRing> Attach(const std::shared_ptr<AVSharedMemory> &memory, int32_t eventFd);
+
+    ~AVShMemRing();
+
+    /**
+     * @brief Push the item at the producer side.
+     * @return false if the ring is full.
+     */
+    bool Push(const AVShMemRingItem &item);
+
+    /**
+     * @brief Pop at most maxCount items at the consumer side, the items are appended to the end.
+     * @return the count of popped items.
+     */
+    size_t Pop(std::vector<AVShMemRingItem> &items, size_t maxCount);
+
+    /**
+     * @brief Wait at the consumer side until there are items to pop, or the timeout, or the
+     * Wakeup is called.
+     *
+     * @param timeoutMs the timeout, -1 means wait forever.
+     * @return MSERR_OK if there are items to pop, otherwise the errcode.
+     */
+    int32_t Wait(int32_t timeoutMs);
+
+    /**
+     * @brief Wake up the consumer blocked at the Wait.
+     */
+    void Wakeup();
+
+    std::shared_ptr<AVSharedMemory> GetMemory() const
+    {
+        return memory_;
+    }
+
+    int32_t GetEventFd() const
+    {
+        return eventFd_;
+    }
+
+private:
+    struct RingHeader;
+    AVShMemRing(const std::shared_ptr<AVSharedMemory> &memory, int32_t eventFd, uint32_t capacity);
+    static size_t GetMemSize(uint32_t capacity);
+    bool IsEmpty() const;
+
+    std::shared_ptr<AVSharedMemory> memory_;
+    int32_t eventFd_ = -1;
+    uint32_t capacity_ = 0;
+    RingHeader *header_ = nullptr;
+    AVShMemRingItem *items_ = nullptr;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // AVSHMEM_RING_H
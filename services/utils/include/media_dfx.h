@@ -37,14 +37,24 @@ private:
 __attribute__((visibility("default"))) void BehaviorEventWrite(std::string status, std::string moudle);
 __attribute__((visibility("default"))) void FaultEventWrite(std::string msg, std::string moudle);
 
+/**
+ * The trace is forwarded to the bytrace, and also recorded by the MediaTraceRecorder if it is
+ * enabled. Prefer the const char * overloads with the string literals, which are recorded without
+ * any copy.
+ */
 class __attribute__((visibility("default"))) MediaTrace : public NoCopyable {
 public:
     explicit MediaTrace(const std::string &funcName);
+    explicit MediaTrace(const char *funcName);
     static void TraceBegin(const std::string &funcName, int32_t taskId);
+    static void TraceBegin(const char *funcName, int32_t taskId);
     static void TraceEnd(const std::string &funcName, int32_t taskId);
+    static void TraceEnd(const char *funcName, int32_t taskId);
+    static void CounterTrace(const char *varName, int64_t value);
     ~MediaTrace();
 private:
     bool isSync_ = false;
+    const char *recordName_ = nullptr;
 };
 } // namespace Media
 } // namespace OHOS
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MEDIA_TRACE_RECORDER_H
+#define MEDIA_TRACE_RECORDER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace Media {
+enum TraceEventType : uint32_t {
+    TRACE_EVENT_BEGIN,
+    TRACE_EVENT_END,
+    TRACE_EVENT_ASYNC_BEGIN,
+    TRACE_EVENT_ASYNC_END,
+    TRACE_EVENT_COUNTER,
+};
+
+/**
+ * Record the trace events into the per-thread binary ring buffers in the process, the oldest
+ * events are overwritten when the ring is full. The names must be static strings or interned
+ * by {@InternName}, only their addresses are recorded. The rings can be exported to the Chrome
+ * trace json, which can be opened by the chrome://tracing or the Perfetto UI.
+ */
+class __attribute__((visibility("default"))) MediaTraceRecorder : public NoCopyable {
+public:
+    static MediaTraceRecorder &Inst()
+    {
+        static MediaTraceRecorder inst;
+        return inst;
+    }
+
+    bool IsEnabled() const
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    void SetEnabled(bool enabled);
+    const char *InternName(const std::string &name);
+    void Record(TraceEventType type, const char *name, int64_t value);
+    void ExportChromeTrace(int32_t fd);
+    void Clear();
+
+private:
+    MediaTraceRecorder();
+    ~MediaTraceRecorder();
+
+    struct ThreadRing;
+    ThreadRing *GetThreadRing();
+
+    std::atomic<bool> enabled_ = false;
+    std::mutex mutex_;
+    // the ring of the exited thread is kept for the export, and reused by the next new thread.
+    std::vector<std::unique_ptr<ThreadRing>> rings_;
+    std::mutex nameMutex_;
+    std::unordered_set<std::string> names_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // MEDIA_TRACE_RECORDER_H
@@ -20,8 +20,8 @@
 #include <condition_variable>
 #include <mutex>
 #include <functional>
-#include <list>
 #include <string>
+#include <vector>
 #include <optional>
 #include <type_traits>
 #include "media_errors.h"
@@ -61,6 +61,12 @@ namespace Media {
  * } else {
  *     MEDIA_LOGI("handler2 not executed");
  * }
+ *
+ * Example 3:
+ * The tasks of a queue with more than one worker may be executed concurrently and out of order,
+ * only use it for independent tasks.
+ * TaskQueue taskQ("your_task_queue_name", 2);
+ * taskQ.Start();
  */
 
 class TaskQueue;
@@ -213,7 +219,8 @@ private:
 
 class __attribute__((visibility("default"))) TaskQueue : public NoCopyable {
 public:
-    explicit TaskQueue(const std::string &name) : name_(name) {}
+    explicit TaskQueue(const std::string &name, uint32_t workerNum = 1)
+        : name_(name), workerNum_(workerNum == 0 ? 1 : workerNum) {}
     ~TaskQueue();
 
     int32_t Start();
@@ -227,16 +234,31 @@ private:
     struct TaskHandlerItem {
         std::shared_ptr<ITaskHandler> task_ { nullptr };
         uint64_t executeTimeNs_ { 0ULL };
+        // keep the tasks with the same execute time in the enqueue order
+        uint64_t seq_ { 0ULL };
+    };
+    struct TaskHandlerItemCmp {
+        bool operator()(const TaskHandlerItem &lhs, const TaskHandlerItem &rhs) const
+        {
+            if (lhs.executeTimeNs_ != rhs.executeTimeNs_) {
+                return lhs.executeTimeNs_ > rhs.executeTimeNs_;
+            }
+            return lhs.seq_ > rhs.seq_;
+        }
     };
     void TaskProcessor();
     void CancelNotExecutedTaskLocked();
+    bool IsTaskThread() const;
 
     bool isExit_ = true;
-    std::unique_ptr<std::thread> thread_;
-    std::list<TaskHandlerItem> taskList_;
+    std::vector<std::unique_ptr<std::thread>> threads_;
+    // min-heap ordered by the execute time
+    std::vector<TaskHandlerItem> taskHeap_;
+    uint64_t taskSeq_ = 0;
     std::mutex mutex_;
     std::condition_variable cond_;
     std::string name_;
+    uint32_t workerNum_;
 };
 } // namespace Media
 } // namespace OHOS
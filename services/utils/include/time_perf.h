@@ -16,10 +16,13 @@
 #ifndef TIME_PERF_H
 #define TIME_PERF_H
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <string_view>
-#include <sys/time.h>
 #include <unordered_map>
-#include <mutex>
+#include <vector>
 #include "nocopyable.h"
 
 namespace OHOS {
@@ -37,6 +40,10 @@ namespace Media {
     TimePerf::Inst().DumpObjectRecord(reinterpret_cast<uintptr_t>(obj)); \
     TimePerf::Inst().CleanObjectRecord(reinterpret_cast<uintptr_t>(obj))
 
+/**
+ * The cost time is recorded into the log-linear histograms owned by the recording thread, so the
+ * threads never contend with each other. The histograms are merged when they are dumped.
+ */
 class __attribute__((visibility("default"))) TimePerf {
 public:
     static TimePerf &Inst()
@@ -45,46 +52,67 @@ public:
         return inst;
     }
 
+    static int64_t GetCurrentUs();
+
     void StartPerfRecord(uintptr_t obj, std::string_view tag);
     void StopPerfRecord(uintptr_t obj, std::string_view tag);
+    void RecordPerf(uintptr_t obj, std::string_view tag, int64_t costUs);
     void DumpObjectRecord(uintptr_t obj);
     void CleanObjectRecord(uintptr_t obj);
     void DumpAllRecord();
     void CleanAllRecord();
+    void DumpInfo(std::string &dumpString);
 
 private:
-    TimePerf() = default;
-    ~TimePerf() = default;
-
-    void TimeVal2USec(const struct timeval &time, int64_t &usec);
-
-    struct PerfRecord {
-        int64_t currStart; // microsecond
-        int64_t currStop;  // microsecond
-        int64_t peakTime;
-        int64_t firstTime;
-        int64_t avgTime;
-        int64_t count;
+    TimePerf();
+    ~TimePerf();
+
+    struct PerfKey {
+        uintptr_t obj;
+        std::string_view tag;
+        bool operator==(const PerfKey &rhs) const
+        {
+            return obj == rhs.obj && tag == rhs.tag;
+        }
     };
 
-    using TagRecords = std::unordered_map<std::string_view, PerfRecord>;
-    std::unordered_map<uintptr_t, TagRecords> objPerfRecords_;
+    struct PerfKeyHash {
+        size_t operator()(const PerfKey &key) const
+        {
+            return std::hash<uintptr_t>()(key.obj) ^ std::hash<std::string_view>()(key.tag);
+        }
+    };
+
+    struct PerfHistogram;
+    struct PerfSummary;
+    struct ThreadRecords;
+    using Histograms = std::unordered_map<PerfKey, std::unique_ptr<PerfHistogram>, PerfKeyHash>;
+
+    static ThreadRecords &GetThreadRecords();
+    static void PurgeCleanedRecords(ThreadRecords &records);
+    void RegisterThread(ThreadRecords *records);
+    void RetireThread(ThreadRecords *records);
+    std::vector<std::pair<PerfKey, PerfSummary>> CollectRecords(uintptr_t obj, bool allObj);
+
     std::mutex mutex_;
+    std::vector<ThreadRecords *> threadRecords_;
+    Histograms retiredRecords_; // merged from the exited threads
+    std::unordered_map<uintptr_t, std::unordered_map<std::string_view, int64_t>> asyncStarts_;
 };
 
 struct __attribute__((visibility("default"))) AutoPerf : public NoCopyable {
-    AutoPerf(uintptr_t obj, std::string_view tag) : obj_(obj), tag_(tag)
+    AutoPerf(uintptr_t obj, std::string_view tag) : obj_(obj), tag_(tag), start_(TimePerf::GetCurrentUs())
     {
-        TimePerf::Inst().StartPerfRecord(obj, tag);
     }
 
     ~AutoPerf()
     {
-        TimePerf::Inst().StopPerfRecord(obj_, tag_);
+        TimePerf::Inst().RecordPerf(obj_, tag_, TimePerf::GetCurrentUs() - start_);
     }
 
     uintptr_t obj_;
     std::string_view tag_;
+    int64_t start_;
 };
 } // namespace Media
 } // namespace OHOS
@@ -19,6 +19,7 @@
 #include "media_log.h"
 #include "media_errors.h"
 #include "bytrace.h"
+#include "media_trace_recorder.h"
 
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "MediaDFX"};
@@ -78,16 +79,58 @@ MediaTrace::MediaTrace(const std::string &funcName)
 {
     StartTrace(BYTRACE_TAG_ZMEDIA, funcName);
     isSync_ = true;
+    auto &recorder = MediaTraceRecorder::Inst();
+    if (recorder.IsEnabled()) {
+        recordName_ = recorder.InternName(funcName);
+        recorder.Record(TRACE_EVENT_BEGIN, recordName_, 0);
+    }
+}
+
+MediaTrace::MediaTrace(const char *funcName)
+{
+    StartTrace(BYTRACE_TAG_ZMEDIA, funcName);
+    isSync_ = true;
+    auto &recorder = MediaTraceRecorder::Inst();
+    if (recorder.IsEnabled()) {
+        recordName_ = funcName;
+        recorder.Record(TRACE_EVENT_BEGIN, recordName_, 0);
+    }
 }
 
 void MediaTrace::TraceBegin(const std::string &funcName, int32_t taskId)
 {
     StartAsyncTrace(BYTRACE_TAG_ZMEDIA, funcName, taskId);
+    auto &recorder = MediaTraceRecorder::Inst();
+    if (recorder.IsEnabled()) {
+        recorder.Record(TRACE_EVENT_ASYNC_BEGIN, recorder.InternName(funcName), taskId);
+    }
+}
+
+void MediaTrace::TraceBegin(const char *funcName, int32_t taskId)
+{
+    StartAsyncTrace(BYTRACE_TAG_ZMEDIA, funcName, taskId);
+    MediaTraceRecorder::Inst().Record(TRACE_EVENT_ASYNC_BEGIN, funcName, taskId);
 }
 
 void MediaTrace::TraceEnd(const std::string &funcName, int32_t taskId)
 {
     FinishAsyncTrace(BYTRACE_TAG_ZMEDIA, funcName, taskId);
+    auto &recorder = MediaTraceRecorder::Inst();
+    if (recorder.IsEnabled()) {
+        recorder.Record(TRACE_EVENT_ASYNC_END, recorder.InternName(funcName), taskId);
+    }
+}
+
+void MediaTrace::TraceEnd(const char *funcName, int32_t taskId)
+{
+    FinishAsyncTrace(BYTRACE_TAG_ZMEDIA, funcName, taskId);
+    MediaTraceRecorder::Inst().Record(TRACE_EVENT_ASYNC_END, funcName, taskId);
+}
+
+void MediaTrace::CounterTrace(const char *varName, int64_t value)
+{
+    CountTrace(BYTRACE_TAG_ZMEDIA, varName, value);
+    MediaTraceRecorder::Inst().Record(TRACE_EVENT_COUNTER, varName, value);
 }
 
 MediaTrace::~MediaTrace()
@@ -95,6 +138,9 @@ MediaTrace::~MediaTrace()
     if (isSync_) {
         FinishTrace(BYTRACE_TAG_ZMEDIA);
     }
+    if (recordName_ != nullptr) {
+        MediaTraceRecorder::Inst().Record(TRACE_EVENT_END, recordName_, 0);
+    }
 }
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "media_trace_recorder.h"
+#include <algorithm>
+#include <ctime>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "securec.h"
+#include "media_log.h"
+
+namespace {
+    constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "MediaTraceRecorder"};
+    constexpr uint64_t RING_CAPACITY = 4096; // must be the power of 2
+    constexpr size_t MAX_RING_NUM = 64;
+    constexpr int64_t NANO_SEC_PER_SEC = 1000000000;
+    constexpr int64_t NANO_SEC_PER_MICRO_SEC = 1000;
+    constexpr size_t EXPORT_FLUSH_SIZE = 64 * 1024;
+    constexpr size_t EVENT_BUFFER_SIZE = 128;
+    constexpr uint32_t CONTROL_CHAR_MAX = 0x20;
+    const char *PHASES[] = { "B", "E", "b", "e", "C" };
+
+    int64_t GetCurrentNs()
+    {
+        struct timespec now {};
+        if (clock_gettime(CLOCK_MONOTONIC, &now) != 0) {
+            return 0;
+        }
+        return static_cast<int64_t>(now.tv_sec) * NANO_SEC_PER_SEC + now.tv_nsec;
+    }
+
+    void AppendJsonString(std::string &out, const char *str)
+    {
+        out += '"';
+        for (const char *ch = str; *ch != '\0'; ch++) {
+            if (*ch == '"' || *ch == '\\') {
+                out += '\\';
+                out += *ch;
+            } else if (static_cast<uint8_t>(*ch) < CONTROL_CHAR_MAX) {
+                out += ' ';
+            } else {
+                out += *ch;
+            }
+        }
+        out += '"';
+    }
+}
+
+namespace OHOS {
+namespace Media {
+// the slots are written by the owner thread only, the export checks the head again after reading
+// them to drop the slots overwritten meanwhile.
+struct TraceSlot {
+    std::atomic<int64_t> timeNs;
+    std::atomic<const char *> name;
+    std::atomic<int64_t> value;
+    std::atomic<uint32_t> type;
+    std::atomic<int32_t> tid;
+};
+
+struct TraceEventCopy {
+    int64_t timeNs;
+    const char *name;
+    int64_t value;
+    uint32_t type;
+    int32_t tid;
+};
+
+struct MediaTraceRecorder::ThreadRing {
+    std::atomic<uint64_t> head = 0;
+    std::atomic<uint64_t> start = 0; // the events before it are cleared
+    std::atomic<bool> inUse = false;
+    int32_t tid = 0;
+    std::unique_ptr<TraceSlot[]> slots;
+};
+
+MediaTraceRecorder::MediaTraceRecorder() = default;
+
+MediaTraceRecorder::~MediaTraceRecorder() = default;
+
+void MediaTraceRecorder::SetEnabled(bool enabled)
+{
+    MEDIA_LOGI("trace recorder %{public}s", enabled ? "enabled" : "disabled");
+    enabled_.store(enabled);
+}
+
+const char *MediaTraceRecorder::InternName(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(nameMutex_);
+    auto ret = names_.insert(name);
+    return ret.first->c_str();
+}
+
+MediaTraceRecorder::ThreadRing *MediaTraceRecorder::GetThreadRing()
+{
+    struct RingHolder {
+        ~RingHolder()
+        {
+            if (ring != nullptr) {
+                ring->inUse.store(false);
+            }
+        }
+        ThreadRing *ring = nullptr;
+    };
+    thread_local RingHolder holder;
+    if (holder.ring != nullptr) {
+        return holder.ring;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &ring : rings_) {
+        if (!ring->inUse.load()) {
+            holder.ring = ring.get();
+            break;
+        }
+    }
+    if (holder.ring == nullptr) {
+        CHECK_AND_RETURN_RET_LOG(rings_.size() < MAX_RING_NUM, nullptr, "too many trace threads");
+        auto ring = std::make_unique<ThreadRing>();
+        ring->slots = std::make_unique<TraceSlot[]>(RING_CAPACITY);
+        holder.ring = ring.get();
+        rings_.push_back(std::move(ring));
+    }
+    holder.ring->tid = static_cast<int32_t>(syscall(SYS_gettid));
+    holder.ring->inUse.store(true);
+    return holder.ring;
+}
+
+void MediaTraceRecorder::Record(TraceEventType type, const char *name, int64_t value)
+{
+    if (!IsEnabled() || name == nullptr) {
+        return;
+    }
+
+    ThreadRing *ring = GetThreadRing();
+    if (ring == nullptr) {
+        return;
+    }
+
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    TraceSlot &slot = ring->slots[head & (RING_CAPACITY - 1)];
+    // keep the slot stores after the last head store, pairs with the fence at the export.
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timeNs.store(GetCurrentNs(), std::memory_order_relaxed);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.type.store(type, std::memory_order_relaxed);
+    slot.tid.store(ring->tid, std::memory_order_relaxed);
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+void MediaTraceRecorder::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &ring : rings_) {
+        ring->start.store(ring->head.load());
+    }
+}
+
+void MediaTraceRecorder::ExportChromeTrace(int32_t fd)
+{
+    std::vector<TraceEventCopy> events;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &ring : rings_) {
+            uint64_t head = ring->head.load(std::memory_order_acquire);
+            uint64_t begin = std::max(ring->start.load(), head > RING_CAPACITY ? head - RING_CAPACITY : 0);
+            size_t base = events.size();
+            for (uint64_t index = begin; index < head; index++) {
+                TraceSlot &slot = ring->slots[index & (RING_CAPACITY - 1)];
+                events.push_back({ slot.timeNs.load(std::memory_order_relaxed),
+                    slot.name.load(std::memory_order_relaxed), slot.value.load(std::memory_order_relaxed),
+                    slot.type.load(std::memory_order_relaxed), slot.tid.load(std::memory_order_relaxed) });
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint64_t newHead = ring->head.load(std::memory_order_relaxed);
+            // the slot of the index newHead - RING_CAPACITY may be overwritten by the event in writing.
+            if (newHead + 1 > begin + RING_CAPACITY) {
+                uint64_t dropped = std::min<uint64_t>(newHead + 1 - RING_CAPACITY - begin, head - begin);
+                events.erase(events.begin() + base, events.begin() + base + dropped);
+            }
+        }
+    }
+
+    std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    int32_t pid = getpid();
+    char buffer[EVENT_BUFFER_SIZE];
+    bool first = true;
+    for (auto &event : events) {
+        if (event.name == nullptr || event.type > TRACE_EVENT_COUNTER) {
+            continue;
+        }
+        out += first ? "\n{\"name\":" : ",\n{\"name\":";
+        first = false;
+        AppendJsonString(out, event.name);
+        int ret = snprintf_s(buffer, sizeof(buffer), sizeof(buffer) - 1,
+            ",\"cat\":\"media\",\"ph\":\"%s\",\"ts\":%" PRId64 ".%03" PRId64 ",\"pid\":%d,\"tid\":%d",
+            PHASES[event.type], event.timeNs / NANO_SEC_PER_MICRO_SEC, event.timeNs % NANO_SEC_PER_MICRO_SEC,
+            pid, event.tid);
+        if (ret > 0) {
+            out += buffer;
+        }
+        if (event.type == TRACE_EVENT_ASYNC_BEGIN || event.type == TRACE_EVENT_ASYNC_END) {
+            out += ",\"id\":" + std::to_string(event.value);
+        } else if (event.type == TRACE_EVENT_COUNTER) {
+            out += ",\"args\":{\"value\":" + std::to_string(event.value) + "}";
+        }
+        out += "}";
+        if (out.size() >= EXPORT_FLUSH_SIZE) {
+            (void)write(fd, out.c_str(), out.size());
+            out.clear();
+        }
+    }
+    out += "\n]}\n";
+    (void)write(fd, out.c_str(), out.size());
+    MEDIA_LOGI("export %{public}zu trace events", events.size());
+}
+} // namespace Media
+} // namespace OHOS
@@ -14,6 +14,7 @@
  */
 
 #include "task_queue.h"
+#include <algorithm>
 #include "media_log.h"
 #include "media_errors.h"
 
@@ -31,12 +32,14 @@ TaskQueue::~TaskQueue()
 int32_t TaskQueue::Start()
 {
     std::unique_lock<std::mutex> lock(mutex_);
-    if (thread_ != nullptr) {
+    if (!threads_.empty()) {
         MEDIA_LOGW("Started already, ignore ! [%{public}s]", name_.c_str());
         return MSERR_OK;
     }
     isExit_ = false;
-    thread_ = std::make_unique<std::thread>(&TaskQueue::TaskProcessor, this);
+    for (uint32_t i = 0; i < workerNum_; ++i) {
+        threads_.push_back(std::make_unique<std::thread>(&TaskQueue::TaskProcessor, this));
+    }
 
     return MSERR_OK;
 }
@@ -49,19 +52,21 @@ int32_t TaskQueue::Stop() noexcept
         return MSERR_OK;
     }
 
-    if (std::this_thread::get_id() == thread_->get_id()) {
+    if (IsTaskThread()) {
         MEDIA_LOGI("Stop at the task thread, reject");
         return MSERR_INVALID_OPERATION;
     }
 
-    std::unique_ptr<std::thread> t;
+    std::vector<std::unique_ptr<std::thread>> threads;
     isExit_ = true;
     cond_.notify_all();
-    std::swap(thread_, t);
+    std::swap(threads_, threads);
     lock.unlock();
 
-    if (t != nullptr && t->joinable()) {
-        t->join();
+    for (auto &t : threads) {
+        if (t != nullptr && t->joinable()) {
+            t->join();
+        }
     }
 
     lock.lock();
@@ -99,11 +104,12 @@ int32_t TaskQueue::EnqueueTask(const std::shared_ptr<ITaskHandler> &task, bool c
         "Enqueue task but timestamp is overflow, why? [%{public}s]", name_.c_str());
 
     uint64_t executeTimeNs = delayUs * US_TO_NS + curTimeNs;
-    auto iter = std::find_if(taskList_.begin(), taskList_.end(), [executeTimeNs](const TaskHandlerItem &item) {
-        return (item.executeTimeNs_ > executeTimeNs);
-    });
-    (void)taskList_.insert(iter, {task, executeTimeNs});
-    cond_.notify_all();
+    taskHeap_.push_back({task, executeTimeNs, taskSeq_++});
+    std::push_heap(taskHeap_.begin(), taskHeap_.end(), TaskHandlerItemCmp());
+    // only wake up a worker if the new task is the earliest one
+    if (taskHeap_.front().task_ == task) {
+        cond_.notify_one();
+    }
 
     return 0;
 }
@@ -111,13 +117,23 @@ int32_t TaskQueue::EnqueueTask(const std::shared_ptr<ITaskHandler> &task, bool c
 void TaskQueue::CancelNotExecutedTaskLocked()
 {
     MEDIA_LOGI("All task not executed are being cancelled..........[%{public}s]", name_.c_str());
-    while (!taskList_.empty()) {
-        std::shared_ptr<ITaskHandler> task = taskList_.front().task_;
-        taskList_.pop_front();
-        if (task != nullptr) {
-            task->Cancel();
+    std::vector<TaskHandlerItem> taskHeap;
+    std::swap(taskHeap, taskHeap_);
+    for (auto &item : taskHeap) {
+        if (item.task_ != nullptr) {
+            item.task_->Cancel();
+        }
+    }
+}
+
+bool TaskQueue::IsTaskThread() const
+{
+    for (auto &t : threads_) {
+        if (t != nullptr && std::this_thread::get_id() == t->get_id()) {
+            return true;
         }
     }
+    return false;
 }
 
 void TaskQueue::TaskProcessor()
@@ -125,20 +141,24 @@ void TaskQueue::TaskProcessor()
     MEDIA_LOGI("Enter TaskProcessor [%{public}s]", name_.c_str());
     while (true) {
         std::unique_lock<std::mutex> lock(mutex_);
-        cond_.wait(lock, [this] { return isExit_ || !taskList_.empty(); });
+        cond_.wait(lock, [this] { return isExit_ || !taskHeap_.empty(); });
         if (isExit_) {
             MEDIA_LOGI("Exit TaskProcessor [%{public}s]", name_.c_str());
             return;
         }
-        TaskHandlerItem item = taskList_.front();
         uint64_t curTimeNs = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
-        if (curTimeNs >= item.executeTimeNs_) {
-            taskList_.pop_front();
-        } else {
-            uint64_t diff =  item.executeTimeNs_ - curTimeNs;
+        if (curTimeNs < taskHeap_.front().executeTimeNs_) {
+            uint64_t diff =  taskHeap_.front().executeTimeNs_ - curTimeNs;
             (void)cond_.wait_for(lock, std::chrono::nanoseconds(diff));
             continue;
         }
+        std::pop_heap(taskHeap_.begin(), taskHeap_.end(), TaskHandlerItemCmp());
+        TaskHandlerItem item = std::move(taskHeap_.back());
+        taskHeap_.pop_back();
+        // let another worker take care of the next task
+        if (workerNum_ > 1 && !taskHeap_.empty()) {
+            cond_.notify_one();
+        }
         lock.unlock();
 
         if (item.task_ == nullptr || item.task_->IsCanceled()) {
@@ -13,162 +13,418 @@
  * limitations under the License.
  */
 #include "time_perf.h"
-#include <climits>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <ctime>
+#include <map>
+#include "securec.h"
 #include "media_log.h"
 
 namespace {
     constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN, "MediaTimePerf"};
-    static constexpr int32_t MICRO_SEC_PER_SEC = 1000000;
-    static constexpr int64_t MAX_SEC = LLONG_MAX / MICRO_SEC_PER_SEC;
-    static constexpr int32_t INVALID_TIME = -1;
+    constexpr int64_t MICRO_SEC_PER_SEC = 1000000;
+    constexpr int64_t NANO_SEC_PER_MICRO_SEC = 1000;
+    constexpr int64_t INVALID_TIME = -1;
+    // each power of 2 is divided into 8 sub buckets, the relative error is at most 12.5%.
+    constexpr uint32_t SUB_BUCKET_BITS = 3;
+    constexpr uint32_t SUB_BUCKET_NUM = 1 << SUB_BUCKET_BITS;
+    constexpr uint32_t MAX_VALUE_BITS = 36; // about 19 hours in microseconds
+    constexpr uint32_t BUCKET_NUM = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_NUM;
+    constexpr uint32_t MSB_INDEX = 63;
+    constexpr size_t DUMP_LINE_SIZE = 256;
+    constexpr double PERCENTILES[] = { 0.5, 0.9, 0.99, 0.999 };
+    constexpr size_t PERCENTILE_NUM = sizeof(PERCENTILES) / sizeof(PERCENTILES[0]);
+
+    uint32_t GetBucketIndex(int64_t value)
+    {
+        uint64_t val = static_cast<uint64_t>(value);
+        if (val < SUB_BUCKET_NUM) {
+            return static_cast<uint32_t>(val);
+        }
+        uint32_t shift = MSB_INDEX - static_cast<uint32_t>(__builtin_clzll(val)) - SUB_BUCKET_BITS;
+        uint32_t index = (shift + 1) * SUB_BUCKET_NUM + static_cast<uint32_t>((val >> shift) & (SUB_BUCKET_NUM - 1));
+        return std::min(index, BUCKET_NUM - 1);
+    }
+
+    // the max value which falls into the bucket.
+    int64_t GetBucketValue(uint32_t index)
+    {
+        if (index < SUB_BUCKET_NUM) {
+            return static_cast<int64_t>(index);
+        }
+        uint32_t shift = index / SUB_BUCKET_NUM - 1;
+        uint64_t subBucket = SUB_BUCKET_NUM + index % SUB_BUCKET_NUM;
+        return static_cast<int64_t>(((subBucket + 1) << shift) - 1);
+    }
 }
 
 namespace OHOS {
 namespace Media {
-void TimePerf::StartPerfRecord(uintptr_t obj, std::string_view tag)
-{
-    std::lock_guard<std::mutex> lock(mutex_);
+// only written by the owner thread, the dump reads them at any time.
+struct TimePerf::PerfHistogram {
+    std::atomic<int64_t> count = 0;
+    std::atomic<int64_t> sum = 0;
+    std::atomic<int64_t> peak = 0;
+    std::atomic<int64_t> first = INVALID_TIME;
+    std::atomic<int64_t> firstAt = INVALID_TIME;
+    std::array<std::atomic<uint64_t>, BUCKET_NUM> buckets {};
+    std::atomic<bool> cleaned = false;
 
-    auto objIter = objPerfRecords_.find(obj);
-    if (objIter == objPerfRecords_.end()) {
-        auto ret = objPerfRecords_.emplace(obj, TagRecords{});
-        objIter = ret.first;
+    void Record(int64_t value)
+    {
+        value = std::max<int64_t>(value, 0);
+        auto &bucket = buckets[GetBucketIndex(value)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (first.load(std::memory_order_relaxed) == INVALID_TIME) {
+            first.store(value, std::memory_order_relaxed);
+            firstAt.store(GetCurrentUs(), std::memory_order_relaxed);
+        }
+        if (value > peak.load(std::memory_order_relaxed)) {
+            peak.store(value, std::memory_order_relaxed);
+        }
+        sum.store(sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
     }
+};
 
-    auto &tagRecords = objIter->second;
-    auto tagIter = tagRecords.find(tag);
-    if (tagIter == tagRecords.end()) {
-        auto ret = tagRecords.emplace(tag, PerfRecord {INVALID_TIME});
-        tagIter = ret.first;
-        tagIter->second.currStart = INVALID_TIME;
-        tagIter->second.currStop = INVALID_TIME;
-        tagIter->second.firstTime = INVALID_TIME;
-        tagIter->second.peakTime = INVALID_TIME;
-        tagIter->second.avgTime = INVALID_TIME;
-        tagIter->second.count = 0;
+struct TimePerf::PerfSummary {
+    int64_t count = 0;
+    int64_t sum = 0;
+    int64_t peak = 0;
+    int64_t first = INVALID_TIME;
+    int64_t firstAt = INVALID_TIME;
+    std::array<uint64_t, BUCKET_NUM> buckets {};
+
+    void MergeFirst(int64_t otherFirst, int64_t otherFirstAt)
+    {
+        if (otherFirstAt != INVALID_TIME && (firstAt == INVALID_TIME || otherFirstAt < firstAt)) {
+            firstAt = otherFirstAt;
+            first = otherFirst;
+        }
     }
 
-    auto &record = tagIter->second;
-    if (record.currStart != INVALID_TIME) {
-        MEDIA_LOGW("already start for obj: 0x%{public}06" PRIXPTR ", tag: %{public}s",
-                   FAKE_POINTER(obj), tag.data());
-        return;
+    void Merge(const PerfHistogram &histogram)
+    {
+        count += histogram.count.load(std::memory_order_relaxed);
+        sum += histogram.sum.load(std::memory_order_relaxed);
+        peak = std::max(peak, histogram.peak.load(std::memory_order_relaxed));
+        MergeFirst(histogram.first.load(std::memory_order_relaxed), histogram.firstAt.load(std::memory_order_relaxed));
+        for (uint32_t index = 0; index < BUCKET_NUM; index++) {
+            buckets[index] += histogram.buckets[index].load(std::memory_order_relaxed);
+        }
     }
 
-    struct timeval start {};
-    int32_t ret = gettimeofday(&start, nullptr);
-    if (ret != 0) {
-        MEDIA_LOGW("get time of day failed");
-        return;
+    void Merge(const PerfSummary &summary)
+    {
+        count += summary.count;
+        sum += summary.sum;
+        peak = std::max(peak, summary.peak);
+        MergeFirst(summary.first, summary.firstAt);
+        for (uint32_t index = 0; index < BUCKET_NUM; index++) {
+            buckets[index] += summary.buckets[index];
+        }
+    }
+
+    int64_t GetPercentile(double ratio) const
+    {
+        uint64_t target = static_cast<uint64_t>(std::ceil(ratio * static_cast<double>(count)));
+        uint64_t accumulated = 0;
+        for (uint32_t index = 0; index < BUCKET_NUM; index++) {
+            accumulated += buckets[index];
+            if (accumulated >= target && accumulated > 0) {
+                return std::min(GetBucketValue(index), peak);
+            }
+        }
+        return peak;
+    }
+};
+
+struct TimePerf::ThreadRecords {
+    // the owner thread only takes it to change the map, others take it to read the map.
+    std::mutex mutex;
+    Histograms histograms;
+    std::atomic<bool> hasCleaned = false;
+    PerfKey lastKey = { 0, std::string_view() };
+    PerfHistogram *lastHistogram = nullptr;
+};
+
+TimePerf::TimePerf() = default;
+
+TimePerf::~TimePerf() = default;
+
+int64_t TimePerf::GetCurrentUs()
+{
+    struct timespec now {};
+    if (clock_gettime(CLOCK_MONOTONIC, &now) != 0) {
+        return 0;
     }
-    TimeVal2USec(start, record.currStart);
+    return static_cast<int64_t>(now.tv_sec) * MICRO_SEC_PER_SEC + now.tv_nsec / NANO_SEC_PER_MICRO_SEC;
 }
 
-void TimePerf::StopPerfRecord(uintptr_t obj, std::string_view tag)
+TimePerf::ThreadRecords &TimePerf::GetThreadRecords()
+{
+    struct RecordsHolder {
+        RecordsHolder() : records(std::make_unique<ThreadRecords>())
+        {
+            TimePerf::Inst().RegisterThread(records.get());
+        }
+        ~RecordsHolder()
+        {
+            TimePerf::Inst().RetireThread(records.get());
+        }
+        std::unique_ptr<ThreadRecords> records;
+    };
+    thread_local RecordsHolder holder;
+    return *holder.records;
+}
+
+void TimePerf::RegisterThread(ThreadRecords *records)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    threadRecords_.push_back(records);
+}
+
+void TimePerf::RetireThread(ThreadRecords *records)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    threadRecords_.erase(std::remove(threadRecords_.begin(), threadRecords_.end(), records), threadRecords_.end());
+
+    std::lock_guard<std::mutex> recordsLock(records->mutex);
+    for (auto &[key, histogram] : records->histograms) {
+        if (histogram->cleaned.load()) {
+            continue;
+        }
+        auto iter = retiredRecords_.find(key);
+        if (iter == retiredRecords_.end()) {
+            (void)retiredRecords_.emplace(key, std::move(histogram));
+            continue;
+        }
+        // the retired histograms are only accessed with the mutex_ held.
+        PerfSummary merged;
+        merged.Merge(*iter->second);
+        merged.Merge(*histogram);
+        PerfHistogram &target = *iter->second;
+        target.count.store(merged.count);
+        target.sum.store(merged.sum);
+        target.peak.store(merged.peak);
+        target.first.store(merged.first);
+        target.firstAt.store(merged.firstAt);
+        for (uint32_t index = 0; index < BUCKET_NUM; index++) {
+            target.buckets[index].store(merged.buckets[index]);
+        }
+    }
+    records->histograms.clear();
+}
+
+void TimePerf::PurgeCleanedRecords(ThreadRecords &records)
 {
-    struct timeval stop {};
-    int32_t getTimeRet = gettimeofday(&stop, nullptr);
-    if (getTimeRet != 0) {
-        MEDIA_LOGW("get time of day failed");
+    std::lock_guard<std::mutex> lock(records.mutex);
+    records.hasCleaned.store(false);
+    for (auto iter = records.histograms.begin(); iter != records.histograms.end();) {
+        if (iter->second->cleaned.load()) {
+            iter = records.histograms.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    records.lastHistogram = nullptr;
+}
+
+void TimePerf::RecordPerf(uintptr_t obj, std::string_view tag, int64_t costUs)
+{
+    ThreadRecords &records = GetThreadRecords();
+    if (records.hasCleaned.load(std::memory_order_acquire)) {
+        PurgeCleanedRecords(records);
+    }
+
+    PerfKey key = { obj, tag };
+    PerfHistogram *histogram = records.lastHistogram;
+    if (histogram == nullptr || !(records.lastKey == key)) {
+        // only the owner thread changes the map, so the lookup does not need the lock.
+        auto iter = records.histograms.find(key);
+        if (iter != records.histograms.end()) {
+            histogram = iter->second.get();
+        } else {
+            auto newHistogram = std::make_unique<PerfHistogram>();
+            histogram = newHistogram.get();
+            std::lock_guard<std::mutex> lock(records.mutex);
+            (void)records.histograms.emplace(key, std::move(newHistogram));
+        }
+        records.lastKey = key;
+        records.lastHistogram = histogram;
     }
 
+    histogram->Record(costUs);
+}
+
+void TimePerf::StartPerfRecord(uintptr_t obj, std::string_view tag)
+{
+    int64_t start = GetCurrentUs();
     std::lock_guard<std::mutex> lock(mutex_);
 
-    auto objIter = objPerfRecords_.find(obj);
-    if (objIter == objPerfRecords_.end()) {
-        MEDIA_LOGW("no record exits for obj: 0x%{public}06" PRIXPTR ", tag: %{public}s",
+    auto &tagStarts = asyncStarts_[obj];
+    if (tagStarts.find(tag) != tagStarts.end()) {
+        MEDIA_LOGW("already start for obj: 0x%{public}06" PRIXPTR ", tag: %{public}s",
                    FAKE_POINTER(obj), tag.data());
         return;
     }
+    (void)tagStarts.emplace(tag, start);
+}
 
-    auto &tagRecords = objIter->second;
-    auto tagIter = tagRecords.find(tag);
-    if (tagIter == tagRecords.end()) {
-        MEDIA_LOGW("no record exits for obj: 0x%{public}06" PRIXPTR ", tag: %{public}s",
-                   FAKE_POINTER(obj), tag.data());
-        return;
+void TimePerf::StopPerfRecord(uintptr_t obj, std::string_view tag)
+{
+    int64_t stop = GetCurrentUs();
+    int64_t start = INVALID_TIME;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto objIter = asyncStarts_.find(obj);
+        if (objIter != asyncStarts_.end()) {
+            auto tagIter = objIter->second.find(tag);
+            if (tagIter != objIter->second.end()) {
+                start = tagIter->second;
+                (void)objIter->second.erase(tagIter);
+            }
+            if (objIter->second.empty()) {
+                (void)asyncStarts_.erase(objIter);
+            }
+        }
     }
 
-    auto &record = tagIter->second;
-    if (record.currStart == INVALID_TIME) {
+    if (start == INVALID_TIME) {
         MEDIA_LOGW("not start record for obj: 0x%{public}06" PRIXPTR ", tag: %{public}s",
                    FAKE_POINTER(obj), tag.data());
         return;
     }
 
-    if (getTimeRet != 0) {
-        record.currStart = INVALID_TIME;
-        return;
-    }
+    RecordPerf(obj, tag, stop - start);
+}
 
-    TimeVal2USec(stop, record.currStop);
-    int64_t currTime = record.currStop - record.currStart;
-    if (currTime > record.peakTime || record.peakTime == INVALID_TIME) {
-        record.peakTime = currTime;
-    }
-    if (record.firstTime == INVALID_TIME) {
-        record.firstTime = currTime;
-    }
+std::vector<std::pair<TimePerf::PerfKey, TimePerf::PerfSummary>> TimePerf::CollectRecords(uintptr_t obj, bool allObj)
+{
+    std::unordered_map<PerfKey, PerfSummary, PerfKeyHash> summaries;
+    auto mergeHistograms = [&summaries, obj, allObj](const Histograms &histograms) {
+        for (auto &[key, histogram] : histograms) {
+            if ((!allObj && key.obj != obj) || histogram->cleaned.load()) {
+                continue;
+            }
+            summaries[key].Merge(*histogram);
+        }
+    };
 
-    record.avgTime = (record.avgTime * record.count + currTime) / (record.count + 1);
-    record.count += 1;
-    record.currStart = INVALID_TIME;
-    record.currStop = INVALID_TIME;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        mergeHistograms(retiredRecords_);
+        for (auto records : threadRecords_) {
+            std::lock_guard<std::mutex> recordsLock(records->mutex);
+            mergeHistograms(records->histograms);
+        }
+    }
 
-    MEDIA_LOGD("obj[0x%{public}06" PRIXPTR "] tag[%{public}s] "
-               "current take time: %{public}" PRIi64 "us, first time: %{public}" PRIi64 ", "
-               "peak time: %{public}" PRIi64 ", avg time: %{public}" PRIi64 ", "
-               "count: %{public}" PRIi64 "",
-               FAKE_POINTER(obj), tag.data(), currTime, record.firstTime,
-               record.peakTime, record.avgTime, record.count);
+    std::vector<std::pair<PerfKey, PerfSummary>> result(summaries.begin(), summaries.end());
+    std::sort(result.begin(), result.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.first.obj != rhs.first.obj ? lhs.first.obj < rhs.first.obj : lhs.first.tag < rhs.first.tag;
+    });
+    return result;
 }
 
 void TimePerf::DumpObjectRecord(uintptr_t obj)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto objIter = objPerfRecords_.find(obj);
-    if (objIter == objPerfRecords_.end()) {
-        MEDIA_LOGW("no record exits for obj: 0x%{public}06" PRIXPTR, FAKE_POINTER(obj));
-        return;
+    auto records = CollectRecords(obj, false);
+    for (auto &[key, summary] : records) {
+        if (summary.count == 0) {
+            continue;
+        }
+        MEDIA_LOGD("obj[0x%{public}06" PRIXPTR "] tag[%{public}s], first time: %{public}" PRIi64 ""
+            ", peak time: %{public}" PRIi64 ", avg time: %{public}" PRIi64 ", count: %{public}" PRIi64 ""
+            ", p50: %{public}" PRIi64 ", p90: %{public}" PRIi64 ", p99: %{public}" PRIi64 ", p999: %{public}" PRIi64 "",
+            FAKE_POINTER(key.obj), key.tag.data(), summary.first, summary.peak, summary.sum / summary.count,
+            summary.count, summary.GetPercentile(PERCENTILES[0]), summary.GetPercentile(PERCENTILES[1]),
+            summary.GetPercentile(PERCENTILES[2]), summary.GetPercentile(PERCENTILES[3]));
     }
+}
 
-    for (auto &[tag, record] : objIter->second) {
-        if (record.count == 0) {
+void TimePerf::DumpAllRecord()
+{
+    auto records = CollectRecords(0, true);
+    for (auto &[key, summary] : records) {
+        if (summary.count == 0) {
             continue;
         }
-        MEDIA_LOGD("obj[0x%{public}06" PRIXPTR "] tag[%{public}s] "
-                   ", first time: %{public}" PRIi64 ", peak time: %{public}" PRIi64 ", "
-                   "avg time: %{public}" PRIi64 ", count: %{public}" PRIi64 "",
-                   FAKE_POINTER(obj), tag.data(), record.firstTime,
-                   record.peakTime, record.avgTime, record.count);
+        MEDIA_LOGD("obj[0x%{public}06" PRIXPTR "] tag[%{public}s], first time: %{public}" PRIi64 ""
+            ", peak time: %{public}" PRIi64 ", avg time: %{public}" PRIi64 ", count: %{public}" PRIi64 ""
+            ", p50: %{public}" PRIi64 ", p90: %{public}" PRIi64 ", p99: %{public}" PRIi64 ", p999: %{public}" PRIi64 "",
+            FAKE_POINTER(key.obj), key.tag.data(), summary.first, summary.peak, summary.sum / summary.count,
+            summary.count, summary.GetPercentile(PERCENTILES[0]), summary.GetPercentile(PERCENTILES[1]),
+            summary.GetPercentile(PERCENTILES[2]), summary.GetPercentile(PERCENTILES[3]));
     }
 }
 
-void TimePerf::CleanObjectRecord(uintptr_t obj)
+void TimePerf::DumpInfo(std::string &dumpString)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    auto records = CollectRecords(0, true);
+    char line[DUMP_LINE_SIZE];
+    auto appendSummary = [&dumpString, &line](const PerfSummary &summary) {
+        std::array<int64_t, PERCENTILE_NUM> values {};
+        for (size_t index = 0; index < PERCENTILE_NUM; index++) {
+            values[index] = summary.GetPercentile(PERCENTILES[index]);
+        }
+        int ret = snprintf_s(line, sizeof(line), sizeof(line) - 1, " count = %" PRIi64 ", first = %" PRIi64
+            "us, avg = %" PRIi64 "us, peak = %" PRIi64 "us, p50 = %" PRIi64 "us, p90 = %" PRIi64 "us, p99 = %"
+            PRIi64 "us, p999 = %" PRIi64 "us\n", summary.count, summary.first, summary.sum / summary.count,
+            summary.peak, values[0], values[1], values[2], values[3]); // 0 ~ 3: index of the percentiles
+        if (ret > 0) {
+            dumpString += line;
+        }
+    };
 
-    auto objIter = objPerfRecords_.find(obj);
-    if (objIter == objPerfRecords_.end()) {
-        return;
+    std::map<std::string_view, PerfSummary> tagSummaries;
+    dumpString += "Per object:\n";
+    for (auto &[key, summary] : records) {
+        if (summary.count == 0) {
+            continue;
+        }
+        int ret = snprintf_s(line, sizeof(line), sizeof(line) - 1, "obj[0x%06" PRIXPTR "] tag[%.*s]",
+            FAKE_POINTER(key.obj), static_cast<int>(key.tag.size()), key.tag.data());
+        if (ret > 0) {
+            dumpString += line;
+        }
+        appendSummary(summary);
+        tagSummaries[key.tag].Merge(summary);
+    }
+
+    dumpString += "Per tag:\n";
+    for (auto &[tag, summary] : tagSummaries) {
+        dumpString += "tag[" + std::string(tag) + "]";
+        appendSummary(summary);
     }
-    (void)objPerfRecords_.erase(objIter);
 }
 
-void TimePerf::DumpAllRecord()
+void TimePerf::CleanObjectRecord(uintptr_t obj)
 {
     std::lock_guard<std::mutex> lock(mutex_);
+    (void)asyncStarts_.erase(obj);
 
-    for (auto &[obj, tagRecords] : objPerfRecords_) {
-        for (auto &[tag, record] : tagRecords) {
-            if (record.count == 0) {
-                continue;
+    for (auto iter = retiredRecords_.begin(); iter != retiredRecords_.end();) {
+        if (iter->first.obj == obj) {
+            iter = retiredRecords_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+
+    // the histograms are released by the owner thread when it records next time.
+    for (auto records : threadRecords_) {
+        std::lock_guard<std::mutex> recordsLock(records->mutex);
+        bool found = false;
+        for (auto &[key, histogram] : records->histograms) {
+            if (key.obj == obj) {
+                histogram->cleaned.store(true);
+                found = true;
             }
-            MEDIA_LOGD("obj[0x%{public}06" PRIXPTR "] tag[%{public}s], first time: %{public}" PRIi64 ""
-                ", peak time: %{public}" PRIi64 ", avg time: %{public}" PRIi64 ", count: %{public}" PRIi64 "",
-                FAKE_POINTER(obj), tag.data(), record.firstTime,
-                record.peakTime, record.avgTime, record.count);
+        }
+        if (found) {
+            records->hasCleaned.store(true, std::memory_order_release);
         }
     }
 }
@@ -176,20 +432,17 @@ void TimePerf::DumpAllRecord()
 void TimePerf::CleanAllRecord()
 {
     std::lock_guard<std::mutex> lock(mutex_);
-    objPerfRecords_.clear();
-}
+    asyncStarts_.clear();
+    retiredRecords_.clear();
 
-void TimePerf::TimeVal2USec(const struct timeval &time, int64_t &usec)
-{
-    if ((static_cast<int64_t>(time.tv_sec) > MAX_SEC) ||
-        (static_cast<int64_t>(time.tv_sec) == MAX_SEC && time.tv_usec > 0) ||
-        (time.tv_usec > MICRO_SEC_PER_SEC)) {
-        MEDIA_LOGW("time overflow");
-        usec = 0;
-        return;
+    for (auto records : threadRecords_) {
+        std::lock_guard<std::mutex> recordsLock(records->mutex);
+        for (auto &[key, histogram] : records->histograms) {
+            (void)key;
+            histogram->cleaned.store(true);
+        }
+        records->hasCleaned.store(true, std::memory_order_release);
     }
-
-    usec = static_cast<int64_t>(time.tv_sec) * MICRO_SEC_PER_SEC + time.tv_usec;
 }
 } // namespace Media
 } // namespace OHOS
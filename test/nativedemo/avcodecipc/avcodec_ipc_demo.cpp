@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "avcodec_ipc_demo.h"
+#include <chrono>
+#include <iostream>
+#include "demo_log.h"
+#include "media_errors.h"
+
+using namespace OHOS;
+using namespace OHOS::Media;
+using namespace std;
+namespace {
+    constexpr uint32_t DEFAULT_BUFFER_COUNT = 64000;
+    constexpr uint32_t DEFAULT_BUFFER_NUM = 8;
+    constexpr int32_t DEFAULT_FRAME_SIZE = 1024;
+    constexpr int64_t FRAME_DURATION_US = 21333; // 1024 samples at 48 kHz
+    const uint32_t BATCH_NUMS[] = { 1, 4, 16, MAX_AVCODEC_BATCH_NUM };
+}
+
+int32_t AVCodecCountingService::InitParameter(AVCodecType type, bool isMimeType, const std::string &name)
+{
+    (void)type;
+    (void)isMimeType;
+    (void)name;
+    return MSERR_OK;
+}
+
+int32_t AVCodecCountingService::Configure(const Format &format)
+{
+    (void)format;
+    return MSERR_OK;
+}
+
+int32_t AVCodecCountingService::Prepare()
+{
+    return MSERR_OK;
+}
+
+int32_t AVCodecCountingService::Start()
+{
+    return MSERR_OK;
+}
+
+int32_t AVCodecCountingService::Stop()
+{
+    return MSERR_OK;
+}
+
+int32_t AVCodecCountingService::Flush()
+{
+    return MSERR_OK;
+}
+
+int32_t AVCodecCountingService::Reset()
+{
+    return MSERR_OK;
+}
+
+int32_t AVCodecCountingService::Release()
+{
+    return MSERR_OK;
+}
+
+sptr<Surface> AVCodecCountingService::CreateInputSurface()
+{
+    return nullptr;
+}
+
+int32_t AVCodecCountingService::SetOutputSurface(sptr<Surface> surface)
+{
+    (void)surface;
+    return MSERR_UNSUPPORT;
+}
+
+std::shared_ptr<AVSharedMemory> AVCodecCountingService::GetInputBuffer(uint32_t index)
+{
+    (void)index;
+    return nullptr;
+}
+
+int32_t AVCodecCountingService::QueueInputBuffer(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag)
+{
+    (void)index;
+    (void)info;
+    (void)flag;
+    queuedCount_++;
+    return MSERR_OK;
+}
+
+int32_t AVCodecCountingService::QueueInputBuffers(const std::vector<AVCodecInputRequest> &requests)
+{
+    queuedCount_ += requests.size();
+    return MSERR_OK;
+}
+
+std::shared_ptr<AVSharedMemory> AVCodecCountingService::GetOutputBuffer(uint32_t index)
+{
+    (void)index;
+    return nullptr;
+}
+
+int32_t AVCodecCountingService::GetOutputFormat(Format &format)
+{
+    (void)format;
+    return MSERR_OK;
+}
+
+std::shared_ptr<AudioCaps> AVCodecCountingService::GetAudioCaps()
+{
+    return nullptr;
+}
+
+std::shared_ptr<VideoCaps> AVCodecCountingService::GetVideoCaps()
+{
+    return nullptr;
+}
+
+int32_t AVCodecCountingService::ReleaseOutputBuffer(uint32_t index, bool render)
+{
+    (void)index;
+    (void)render;
+    releasedCount_++;
+    return MSERR_OK;
+}
+
+int32_t AVCodecCountingService::ReleaseOutputBuffers(const std::vector<uint32_t> &indexes, bool render)
+{
+    (void)render;
+    releasedCount_ += indexes.size();
+    return MSERR_OK;
+}
+
+int32_t AVCodecCountingService::SetParameter(const Format &format)
+{
+    (void)format;
+    return MSERR_OK;
+}
+
+int32_t AVCodecCountingService::SetCallback(const std::shared_ptr<AVCodecCallback> &callback)
+{
+    (void)callback;
+    return MSERR_OK;
+}
+
+void AVCodecIpcDemo::RunCase()
+{
+    cout << "queue and release " << DEFAULT_BUFFER_COUNT << " buffers through the local transport" << endl;
+    for (auto batchNum : BATCH_NUMS) {
+        RunBatch(batchNum);
+    }
+}
+
+void AVCodecIpcDemo::RunBatch(uint32_t batchNum)
+{
+    auto service = make_shared<AVCodecCountingService>();
+    DEMO_CHECK_AND_RETURN_LOG(service != nullptr, "Fatal: No memory");
+    auto transport = make_shared<AVCodecLocalTransport>(service);
+    DEMO_CHECK_AND_RETURN_LOG(transport != nullptr, "Fatal: No memory");
+
+    vector<AVCodecInputRequest> requests;
+    vector<uint32_t> indexes;
+    auto startTime = chrono::steady_clock::now();
+    for (uint32_t i = 0; i < DEFAULT_BUFFER_COUNT; i++) {
+        AVCodecInputRequest request;
+        request.index = i % DEFAULT_BUFFER_NUM;
+        request.info.presentationTimeUs = static_cast<int64_t>(i) * FRAME_DURATION_US;
+        request.info.size = DEFAULT_FRAME_SIZE;
+        if (batchNum == 1) {
+            DEMO_CHECK_AND_RETURN_LOG(transport->QueueInputBuffer(request.index, request.info, request.flag) ==
+                MSERR_OK, "Fatal: QueueInputBuffer fail");
+            DEMO_CHECK_AND_RETURN_LOG(transport->ReleaseOutputBuffer(request.index, false) == MSERR_OK,
+                "Fatal: ReleaseOutputBuffer fail");
+            continue;
+        }
+        requests.push_back(request);
+        indexes.push_back(request.index);
+        if (requests.size() == batchNum || i + 1 == DEFAULT_BUFFER_COUNT) {
+            DEMO_CHECK_AND_RETURN_LOG(transport->QueueInputBuffers(requests) == MSERR_OK,
+                "Fatal: QueueInputBuffers fail");
+            DEMO_CHECK_AND_RETURN_LOG(transport->ReleaseOutputBuffers(indexes, false) == MSERR_OK,
+                "Fatal: ReleaseOutputBuffers fail");
+            requests.clear();
+            indexes.clear();
+        }
+    }
+    auto costUs = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime).count();
+
+    cout << "batch " << batchNum << ": " << transport->GetTransactionCount() << " transactions, " <<
+        service->GetQueuedCount() << " queued, " << service->GetReleasedCount() << " released, " <<
+        costUs << " us, " << static_cast<double>(costUs) / DEFAULT_BUFFER_COUNT << " us per buffer" << endl;
+}
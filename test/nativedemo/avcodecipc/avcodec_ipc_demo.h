@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AVCODEC_IPC_DEMO_H
+#define AVCODEC_IPC_DEMO_H
+
+#include "avcodec_local_transport.h"
+
+namespace OHOS {
+namespace Media {
+// the service end of the demo, which only counts the buffers so the transactions dominate the cost
+class AVCodecCountingService : public IAVCodecService, public NoCopyable {
+public:
+    AVCodecCountingService() = default;
+    ~AVCodecCountingService() = default;
+
+    int32_t InitParameter(AVCodecType type, bool isMimeType, const std::string &name) override;
+    int32_t Configure(const Format &format) override;
+    int32_t Prepare() override;
+    int32_t Start() override;
+    int32_t Stop() override;
+    int32_t Flush() override;
+    int32_t Reset() override;
+    int32_t Release() override;
+    sptr<Surface> CreateInputSurface() override;
+    int32_t SetOutputSurface(sptr<Surface> surface) override;
+    std::shared_ptr<AVSharedMemory> GetInputBuffer(uint32_t index) override;
+    int32_t QueueInputBuffer(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag) override;
+    int32_t QueueInputBuffers(const std::vector<AVCodecInputRequest> &requests) override;
+    std::shared_ptr<AVSharedMemory> GetOutputBuffer(uint32_t index) override;
+    int32_t GetOutputFormat(Format &format) override;
+    std::shared_ptr<AudioCaps> GetAudioCaps() override;
+    std::shared_ptr<VideoCaps> GetVideoCaps() override;
+    int32_t ReleaseOutputBuffer(uint32_t index, bool render) override;
+    int32_t ReleaseOutputBuffers(const std::vector<uint32_t> &indexes, bool render) override;
+    int32_t SetParameter(const Format &format) override;
+    int32_t SetCallback(const std::shared_ptr<AVCodecCallback> &callback) override;
+
+    uint64_t GetQueuedCount() const
+    {
+        return queuedCount_;
+    }
+    uint64_t GetReleasedCount() const
+    {
+        return releasedCount_;
+    }
+
+private:
+    uint64_t queuedCount_ = 0;
+    uint64_t releasedCount_ = 0;
+};
+
+class AVCodecIpcDemo : public NoCopyable {
+public:
+    AVCodecIpcDemo() = default;
+    ~AVCodecIpcDemo() = default;
+    void RunCase();
+
+private:
+    void RunBatch(uint32_t batchNum);
+};
+} // namespace Media
+} // namespace OHOS
+#endif // AVCODEC_IPC_DEMO_H
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "avcodec_local_transport.h"
+#include "demo_log.h"
+#include "media_errors.h"
+
+namespace OHOS {
+namespace Media {
+AVCodecLocalTransport::AVCodecLocalTransport(const std::shared_ptr<IAVCodecService> &service)
+    : service_(service), thread_(&AVCodecLocalTransport::ServiceLoop, this)
+{
+}
+
+AVCodecLocalTransport::~AVCodecLocalTransport()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    requestCond_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void AVCodecLocalTransport::Transact(const std::function<void()> &func)
+{
+    // one transaction at a time, the caller blocks until the service thread replies
+    std::unique_lock<std::mutex> transactLock(transactMutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    request_ = func;
+    replied_ = false;
+    requestCond_.notify_one();
+    replyCond_.wait(lock, [this] { return replied_; });
+    transactionCount_++;
+}
+
+void AVCodecLocalTransport::ServiceLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        requestCond_.wait(lock, [this] { return stop_ || request_ != nullptr; });
+        if (stop_) {
+            return;
+        }
+        auto request = std::move(request_);
+        request_ = nullptr;
+        lock.unlock();
+        request();
+        lock.lock();
+        replied_ = true;
+        replyCond_.notify_one();
+    }
+}
+
+uint64_t AVCodecLocalTransport::GetTransactionCount() const
+{
+    return transactionCount_.load();
+}
+
+int32_t AVCodecLocalTransport::InitParameter(AVCodecType type, bool isMimeType, const std::string &name)
+{
+    int32_t ret = MSERR_OK;
+    Transact([&, type, isMimeType, name] { ret = service_->InitParameter(type, isMimeType, name); });
+    return ret;
+}
+
+int32_t AVCodecLocalTransport::Configure(const Format &format)
+{
+    int32_t ret = MSERR_OK;
+    Transact([&, format] { ret = service_->Configure(format); });
+    return ret;
+}
+
+int32_t AVCodecLocalTransport::Prepare()
+{
+    int32_t ret = MSERR_OK;
+    Transact([&] { ret = service_->Prepare(); });
+    return ret;
+}
+
+int32_t AVCodecLocalTransport::Start()
+{
+    int32_t ret = MSERR_OK;
+    Transact([&] { ret = service_->Start(); });
+    return ret;
+}
+
+int32_t AVCodecLocalTransport::Stop()
+{
+    int32_t ret = MSERR_OK;
+    Transact([&] { ret = service_->Stop(); });
+    return ret;
+}
+
+int32_t AVCodecLocalTransport::Flush()
+{
+    int32_t ret = MSERR_OK;
+    Transact([&] { ret = service_->Flush(); });
+    return ret;
+}
+
+int32_t AVCodecLocalTransport::Reset()
+{
+    int32_t ret = MSERR_OK;
+    Transact([&] { ret = service_->Reset(); });
+    return ret;
+}
+
+int32_t AVCodecLocalTransport::Release()
+{
+    int32_t ret = MSERR_OK;
+    Transact([&] { ret = service_->Release(); });
+    return ret;
+}
+
+sptr<Surface> AVCodecLocalTransport::CreateInputSurface()
+{
+    sptr<Surface> surface = nullptr;
+    Transact([&] { surface = service_->CreateInputSurface(); });
+    return surface;
+}
+
+int32_t AVCodecLocalTransport::SetOutputSurface(sptr<Surface> surface)
+{
+    int32_t ret = MSERR_OK;
+    Transact([&, surface] { ret = service_->SetOutputSurface(surface); });
+    return ret;
+}
+
+std::shared_ptr<AVSharedMemory> AVCodecLocalTransport::GetInputBuffer(uint32_t index)
+{
+    std::shared_ptr<AVSharedMemory> memory = nullptr;
+    Transact([&, index] { memory = service_->GetInputBuffer(index); });
+    return memory;
+}
+
+int32_t AVCodecLocalTransport::QueueInputBuffer(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag)
+{
+    int32_t ret = MSERR_OK;
+    Transact([&, index, info, flag] { ret = service_->QueueInputBuffer(index, info, flag); });
+    return ret;
+}
+
+int32_t AVCodecLocalTransport::QueueInputBuffers(const std::vector<AVCodecInputRequest> &requests)
+{
+    DEMO_CHECK_AND_RETURN_RET_LOG(requests.size() <= MAX_AVCODEC_BATCH_NUM, MSERR_INVALID_VAL, "too many buffers");
+    int32_t ret = MSERR_OK;
+    Transact([&, requests] { ret = service_->QueueInputBuffers(requests); });
+    return ret;
+}
+
+std::shared_ptr<AVSharedMemory> AVCodecLocalTransport::GetOutputBuffer(uint32_t index)
+{
+    std::shared_ptr<AVSharedMemory> memory = nullptr;
+    Transact([&, index] { memory = service_->GetOutputBuffer(index); });
+    return memory;
+}
+
+int32_t AVCodecLocalTransport::GetOutputFormat(Format &format)
+{
+    int32_t ret = MSERR_OK;
+    Transact([&] { ret = service_->GetOutputFormat(format); });
+    return ret;
+}
+
+std::shared_ptr<AudioCaps> AVCodecLocalTransport::GetAudioCaps()
+{
+    std::shared_ptr<AudioCaps> caps = nullptr;
+    Transact([&] { caps = service_->GetAudioCaps(); });
+    return caps;
+}
+
+std::shared_ptr<VideoCaps> AVCodecLocalTransport::GetVideoCaps()
+{
+    std::shared_ptr<VideoCaps> caps = nullptr;
+    Transact([&] { caps = service_->GetVideoCaps(); });
+    return caps;
+}
+
+int32_t AVCodecLocalTransport::ReleaseOutputBuffer(uint32_t index, bool render)
+{
+    int32_t ret = MSERR_OK;
+    Transact([&, index, render] { ret = service_->ReleaseOutputBuffer(index, render); });
+    return ret;
+}
+
+int32_t AVCodecLocalTransport::ReleaseOutputBuffers(const std::vector<uint32_t> &indexes, bool render)
+{
+    DEMO_CHECK_AND_RETURN_RET_LOG(indexes.size() <= MAX_AVCODEC_BATCH_NUM, MSERR_INVALID_VAL, "too many buffers");
+    int32_t ret = MSERR_OK;
+    Transact([&, indexes, render] { ret = service_->ReleaseOutputBuffers(indexes, render); });
+    return ret;
+}
+
+int32_t AVCodecLocalTransport::SetParameter(const Format &format)
+{
+    int32_t ret = MSERR_OK;
+    Transact([&, format] { ret = service_->SetParameter(format); });
+    return ret;
+}
+
+int32_t AVCodecLocalTransport::SetCallback(const std::shared_ptr<AVCodecCallback> &callback)
+{
+    int32_t ret = MSERR_OK;
+    Transact([&, callback] { ret = service_->SetCallback(callback); });
+    return ret;
+}
+} // namespace Media
+} // namespace OHOS
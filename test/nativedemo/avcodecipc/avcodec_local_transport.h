@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AVCODEC_LOCAL_TRANSPORT_H
+#define AVCODEC_LOCAL_TRANSPORT_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "i_avcodec_service.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * An in-process stand-in for the binder between the codec client and the codec service, so the cost of
+ * the synchronous transactions can be measured on a plain host. Each call is one transaction: the
+ * arguments are copied, the call runs on the service thread, and the caller waits for the reply.
+ */
+class AVCodecLocalTransport : public IAVCodecService, public NoCopyable {
+public:
+    explicit AVCodecLocalTransport(const std::shared_ptr<IAVCodecService> &service);
+    ~AVCodecLocalTransport();
+
+    int32_t InitParameter(AVCodecType type, bool isMimeType, const std::string &name) override;
+    int32_t Configure(const Format &format) override;
+    int32_t Prepare() override;
+    int32_t Start() override;
+    int32_t Stop() override;
+    int32_t Flush() override;
+    int32_t Reset() override;
+    int32_t Release() override;
+    sptr<Surface> CreateInputSurface() override;
+    int32_t SetOutputSurface(sptr<Surface> surface) override;
+    std::shared_ptr<AVSharedMemory> GetInputBuffer(uint32_t index) override;
+    int32_t QueueInputBuffer(uint32_t index, AVCodecBufferInfo info, AVCodecBufferFlag flag) override;
+    int32_t QueueInputBuffers(const std::vector<AVCodecInputRequest> &requests) override;
+    std::shared_ptr<AVSharedMemory> GetOutputBuffer(uint32_t index) override;
+    int32_t GetOutputFormat(Format &format) override;
+    std::shared_ptr<AudioCaps> GetAudioCaps() override;
+    std::shared_ptr<VideoCaps> GetVideoCaps() override;
+    int32_t ReleaseOutputBuffer(uint32_t index, bool render) override;
+    int32_t ReleaseOutputBuffers(const std::vector<uint32_t> &indexes, bool render) override;
+    int32_t SetParameter(const Format &format) override;
+    int32_t SetCallback(const std::shared_ptr<AVCodecCallback> &callback) override;
+
+    uint64_t GetTransactionCount() const;
+
+private:
+    void Transact(const std::function<void()> &func);
+    void ServiceLoop();
+
+    std::shared_ptr<IAVCodecService> service_;
+    std::mutex transactMutex_;
+    std::mutex mutex_;
+    std::condition_variable requestCond_;
+    std::condition_variable replyCond_;
+    std::function<void()> request_;
+    bool replied_ = false;
+    bool stop_ = false;
+    std::atomic<uint64_t> transactionCount_ = 0;
+    std::thread thread_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // AVCODEC_LOCAL_TRANSPORT_H
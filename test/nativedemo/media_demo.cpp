@@ -22,6 +22,7 @@
 #include "avcodec_venc_demo.h"
 #include "avcodec_vdec_demo.h"
 #include "avmuxer_demo.h"
+#include "avcodec_ipc_demo.h"
 
 using namespace OHOS;
 using namespace OHOS::Media;
@@ -100,6 +101,18 @@ static int RunAVMuxer()
     return 0;
 }
 
+static int RunAVCodecIpc()
+{
+    auto avcodecIpc = std::make_unique<AVCodecIpcDemo>();
+    if (avcodecIpc == nullptr) {
+        cout << "avcodecIpc is null" << endl;
+        return 0;
+    }
+    avcodecIpc->RunCase();
+    cout << "demo avcodecIpc end" << endl;
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
     constexpr int minRequiredArgCount = 2;
@@ -114,6 +127,7 @@ int main(int argc, char *argv[])
     cout << "3:codeclist" << endl;
     cout << "4:video-encoder" << endl;
     cout << "5:avmuxer" << endl;
+    cout << "6:avcodec-ipc" << endl;
     string mode;
     (void)getline(cin, mode);
     if (mode == "" || mode == "0") {
@@ -128,6 +142,8 @@ int main(int argc, char *argv[])
         (void)RunVideoEncoder(false);
     } else if (mode == "5") {
         (void)RunAVMuxer();
+    } else if (mode == "6") {
+        (void)RunAVCodecIpc();
     } else {
         cout << "no that selection" << endl;
     }